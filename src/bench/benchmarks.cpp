@@ -0,0 +1,475 @@
+#include "benchmarks.h"
+
+namespace s21 {
+
+/**
+ * Writes a random symmetric graph with weights from 1 to 100 in the adjacency
+ * matrix format once per (vertices, density) pair and returns its file name.
+ *
+ * @param vertices the number of vertices
+ * @param density the percentage of present edges
+ *
+ * @return the name of the generated file
+ */
+std::string GraphFile(int vertices, int density) {
+  static std::map<std::pair<int, int>, std::string> files;
+  auto found = files.find({vertices, density});
+  if (found != files.end()) return found->second;
+
+  std::string filename =
+      (std::filesystem::temp_directory_path() /
+       ("s21_bench_" + std::to_string(vertices) + "_" +
+        std::to_string(density) + ".txt"))
+          .string();
+  std::mt19937 generator(vertices * 1000 + density);
+  std::uniform_int_distribution<int> weight(1, 100);
+  std::uniform_int_distribution<int> percent(1, 100);
+  matrix weights(vertices, vector<int>(vertices, 0));
+  for (int i = 0; i < vertices; ++i) {
+    for (int j = i + 1; j < vertices; ++j) {
+      // Ребро к следующей вершине держит граф связным при любой плотности.
+      if (j == i + 1 || percent(generator) <= density) {
+        weights[i][j] = weights[j][i] = weight(generator);
+      }
+    }
+  }
+
+  std::ofstream file(filename);
+  file << vertices << "\n";
+  for (const auto &row : weights) {
+    for (int cell : row) file << cell << " ";
+    file << "\n";
+  }
+  files[{vertices, density}] = filename;
+  return filename;
+}
+
+Graph &LoadedGraph(int vertices, int density) {
+  static std::map<std::pair<int, int>, Graph> graphs;
+  auto found = graphs.find({vertices, density});
+  if (found != graphs.end()) return found->second;
+  Graph &graph = graphs[{vertices, density}];
+  graph.loadGraphFromFile(GraphFile(vertices, density));
+  return graph;
+}
+
+template <typename Weight>
+void SetGraphCounters(benchmark::State &state,
+                      const BasicGraph<Weight> &graph) {
+  state.counters["V"] = graph.size();
+  state.counters["E"] = static_cast<double>(graph.size()) * graph.size() *
+                        state.range(1) / 100;
+}
+
+void BM_LoadGraphFromFile(benchmark::State &state) {
+  std::string filename = GraphFile(state.range(0), state.range(1));
+  Graph graph;
+  for (auto _ : state) {
+    graph.loadGraphFromFile(filename);
+    benchmark::ClobberMemory();
+  }
+  SetGraphCounters(state, graph);
+}
+
+void BM_DepthFirstSearch(benchmark::State &state) {
+  Graph &graph = LoadedGraph(state.range(0), state.range(1));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(GraphAlgorithms::DepthFirstSearch(graph, 0));
+  }
+  SetGraphCounters(state, graph);
+}
+
+void BM_BreadthFirstSearch(benchmark::State &state) {
+  Graph &graph = LoadedGraph(state.range(0), state.range(1));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(GraphAlgorithms::BreadthFirstSearch(graph, 0));
+  }
+  SetGraphCounters(state, graph);
+}
+
+void BM_GetShortestPathBetweenVertices(benchmark::State &state) {
+  Graph &graph = LoadedGraph(state.range(0), state.range(1));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(GraphAlgorithms::GetShortestPathBetweenVertices(
+        graph, 1, graph.size()));
+  }
+  SetGraphCounters(state, graph);
+}
+
+void BM_BidirectionalShortestPath(benchmark::State &state) {
+  Graph &graph = LoadedGraph(state.range(0), state.range(1));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        PointToPoint::Bidirectional(graph, 1, graph.size()));
+  }
+  SetGraphCounters(state, graph);
+}
+
+// Ориентиры строятся один раз, измеряется только сам запрос.
+void BM_AltShortestPath(benchmark::State &state) {
+  Graph &graph = LoadedGraph(state.range(0), state.range(1));
+  Landmarks landmarks(graph);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        PointToPoint::Alt(graph, landmarks, 1, graph.size()));
+  }
+  SetGraphCounters(state, graph);
+}
+
+void BM_ContractionHierarchyShortestPath(benchmark::State &state) {
+  Graph &graph = LoadedGraph(state.range(0), state.range(1));
+  ContractionHierarchy hierarchy(graph);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(hierarchy.Distance(1, graph.size()));
+  }
+  SetGraphCounters(state, graph);
+  state.counters["shortcuts"] = hierarchy.ShortcutCount();
+}
+
+void BM_BuildContractionHierarchy(benchmark::State &state) {
+  Graph &graph = LoadedGraph(state.range(0), state.range(1));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(ContractionHierarchy(graph));
+  }
+  SetGraphCounters(state, graph);
+}
+
+void BM_DistanceOracleEstimate(benchmark::State &state) {
+  Graph &graph = LoadedGraph(state.range(0), state.range(1));
+  DistanceOracle oracle(graph, DistanceOracle::kDefaultLevels, 1);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(oracle.Distance(1, graph.size()));
+  }
+  SetGraphCounters(state, graph);
+  state.counters["entries"] = oracle.BunchEntries();
+}
+
+void BM_BuildDistanceOracle(benchmark::State &state) {
+  Graph &graph = LoadedGraph(state.range(0), state.range(1));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        DistanceOracle(graph, DistanceOracle::kDefaultLevels, 1));
+  }
+  SetGraphCounters(state, graph);
+}
+
+void BM_GetShortestPathsBetweenAllVertices(benchmark::State &state) {
+  Graph &graph = LoadedGraph(state.range(0), state.range(1));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        GraphAlgorithms::GetShortestPathsBetweenAllVertices(graph));
+  }
+  SetGraphCounters(state, graph);
+}
+
+// Тот же граф с весами другого типа; int измеряет
+// BM_GetShortestPathsBetweenAllVertices.
+template <typename Weight>
+void BM_ShortestPathsByWeight(benchmark::State &state) {
+  BasicGraph<Weight> graph;
+  graph.loadGraphFromFile(GraphFile(state.range(0), state.range(1)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        BasicGraphAlgorithms<Weight>::GetShortestPathsBetweenAllVertices(
+            graph));
+  }
+  SetGraphCounters(state, graph);
+  state.counters["graph_bytes"] =
+      static_cast<double>(sizeof(Weight)) * graph.size() * graph.size();
+}
+
+// Бюджет памяти - четверть матрицы, так что плитки читаются с диска.
+void BM_ExternalShortestPaths(benchmark::State &state) {
+  Graph &graph = LoadedGraph(state.range(0), state.range(1));
+  const std::string output =
+      (std::filesystem::temp_directory_path() / "s21_bench.apsp").string();
+  ExternalPathsOptions options;
+  options.memory_budget = sizeof(int) * graph.size() * graph.size() / 4;
+  for (auto _ : state) {
+    ExternalShortestPaths::FromGraph(graph, output, options);
+  }
+  state.counters["tile"] = DistanceFile(output).Tile();
+  std::filesystem::remove(output);
+  SetGraphCounters(state, graph);
+}
+
+void BM_GetLeastSpanningTree(benchmark::State &state) {
+  Graph &graph = LoadedGraph(state.range(0), state.range(1));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(GraphAlgorithms::GetLeastSpanningTree(graph));
+  }
+  SetGraphCounters(state, graph);
+}
+
+// Алгоритмы ViewAlgorithms на матрице смежности и на сжатых строках.
+template <typename Storage>
+void BM_BreadthFirstSearchByStorage(benchmark::State &state) {
+  Graph &graph = LoadedGraph(state.range(0), state.range(1));
+  const Storage storage(graph);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(ViewAlgorithms::BreadthFirstSearch(storage, 0));
+  }
+  SetGraphCounters(state, graph);
+}
+
+template <typename Storage>
+void BM_ShortestPathByStorage(benchmark::State &state) {
+  Graph &graph = LoadedGraph(state.range(0), state.range(1));
+  const Storage storage(graph);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(ViewAlgorithms::GetShortestPathBetweenVertices(
+        storage, 1, graph.size()));
+  }
+  SetGraphCounters(state, graph);
+}
+
+template <typename Storage>
+void BM_ShortestPathsByStorage(benchmark::State &state) {
+  Graph &graph = LoadedGraph(state.range(0), state.range(1));
+  const Storage storage(graph);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        ViewAlgorithms::GetShortestPathsBetweenAllVertices(storage));
+  }
+  SetGraphCounters(state, graph);
+}
+
+template <typename Storage>
+void BM_SpanningTreeByStorage(benchmark::State &state) {
+  Graph &graph = LoadedGraph(state.range(0), state.range(1));
+  const Storage storage(graph);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(ViewAlgorithms::GetLeastSpanningTree(storage));
+  }
+  SetGraphCounters(state, graph);
+}
+
+/**
+ * A square grid of the given side with randomly shuffled vertex numbers, as
+ * a graph view: the neighbours of a vertex lie far apart in memory, like in a
+ * graph loaded from a file of an arbitrary numbering.
+ */
+class ShuffledGrid {
+ public:
+  using WeightType = int;
+
+  explicit ShuffledGrid(int side)
+      : side_(side), to_cell_(side * side), to_vertex_(side * side) {
+    std::iota(to_cell_.begin(), to_cell_.end(), 0);
+    std::shuffle(to_cell_.begin(), to_cell_.end(), std::mt19937(side));
+    for (int vertex = 0; vertex < size(); ++vertex) {
+      to_vertex_[to_cell_[vertex]] = vertex;
+    }
+  }
+
+  int size() const { return side_ * side_; }
+
+  template <typename Visit>
+  void ForEachNeighbour(int vertex, Visit visit) const {
+    const int kCell = to_cell_[vertex];
+    const int kRow = kCell / side_;
+    const int kCol = kCell % side_;
+    vector<int> neighbours;
+    if (kRow > 0) neighbours.push_back(to_vertex_[kCell - side_]);
+    if (kRow + 1 < side_) neighbours.push_back(to_vertex_[kCell + side_]);
+    if (kCol > 0) neighbours.push_back(to_vertex_[kCell - 1]);
+    if (kCol + 1 < side_) neighbours.push_back(to_vertex_[kCell + 1]);
+    std::sort(neighbours.begin(), neighbours.end());
+    for (int to : neighbours) visit(to, 1 + (vertex + to) % 9);
+  }
+
+ private:
+  int side_;
+  vector<int> to_cell_;
+  vector<int> to_vertex_;
+};
+
+/**
+ * Returns the shuffled grid in compressed rows renumbered in the given
+ * order, built once per (side, order) pair.
+ */
+const CompressedGraph<int> &ReorderedGrid(int side, int order) {
+  static std::map<std::pair<int, int>, CompressedGraph<int>> graphs;
+  auto found = graphs.find({side, order});
+  if (found != graphs.end()) return found->second;
+  CompressedGraph<int> graph{ShuffledGrid(side)};
+  graph.Reorder(static_cast<VertexOrder>(order));
+  return graphs.emplace(std::make_pair(side, order), std::move(graph))
+      .first->second;
+}
+
+// Обходы по сетке в исходной перемешанной нумерации и после перенумерации:
+// 0 - исходная, 1 - обратный Катхилл-Макки, 2 - обход в ширину, 3 - степени.
+// Остов не сравнивается: его матрица V x V для такой сетки не помещается в
+// память.
+void BM_BreadthFirstSearchByOrder(benchmark::State &state) {
+  const CompressedGraph<int> &graph =
+      ReorderedGrid(state.range(0), state.range(1));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(ViewAlgorithms::BreadthFirstSearch(graph, 0));
+  }
+}
+
+void BM_ShortestPathByOrder(benchmark::State &state) {
+  const CompressedGraph<int> &graph =
+      ReorderedGrid(state.range(0), state.range(1));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(ViewAlgorithms::GetShortestPathBetweenVertices(
+        graph, 1, graph.size()));
+  }
+}
+
+void BM_ExportGraphToDot(benchmark::State &state) {
+  Graph &graph = LoadedGraph(state.range(0), state.range(1));
+  std::string filename =
+      (std::filesystem::temp_directory_path() / "s21_bench_export.dot")
+          .string();
+  // exportGraphToDot сообщает об успехе в std::cout, заглушаем вывод.
+  std::ostringstream sink;
+  std::streambuf *stdout_buffer = std::cout.rdbuf(sink.rdbuf());
+  for (auto _ : state) {
+    graph.exportGraphToDot(filename);
+    sink.str("");
+  }
+  std::cout.rdbuf(stdout_buffer);
+  std::remove(filename.c_str());
+  SetGraphCounters(state, graph);
+}
+
+/**
+ * Fixed-length ant colony run: a constant seed and iteration count make the
+ * amount of work comparable between versions.
+ */
+void BM_SolveTravelingSalesmanProblem(benchmark::State &state) {
+  Graph &graph = LoadedGraph(state.range(0), 100);
+  TsmOptions options;
+  options.max_iterations = 10;
+  options.colony.seed = 1;
+  if (graph.size() > HeldKarp::kAutoMaxVertices) {
+    options.solver = TsmSolver::kAntColony;
+  }
+  double distance = 0;
+  for (auto _ : state) {
+    distance = GraphAlgorithms::SolveTravelingSalesmanProblem(graph, options)
+                   .distance;
+  }
+  state.counters["V"] = graph.size();
+  state.counters["distance"] = distance;
+}
+
+/**
+ * Time until the ant colony first reaches the optimal tour found by the
+ * Held-Karp solver, for every local search mode.
+ */
+void BM_TsmTimeToTarget(benchmark::State &state) {
+  Graph &graph = LoadedGraph(18, 100);
+  const double kTarget = HeldKarp(graph).Solve().distance;
+  const auto kMode = static_cast<LocalSearchMode>(state.range(0));
+  int reached = 0;
+  int runs = 0;
+  for (auto _ : state) {
+    TsmOptions options;
+    options.solver = TsmSolver::kAntColony;
+    options.local_search = kMode;
+    options.stall_limit = 0;
+    options.time_budget = std::chrono::seconds(5);
+    options.colony.seed = 1 + runs++;
+    CancellationToken token = options.cancellation;
+    options.on_progress = [&reached, token, kTarget](const TsmProgress &p) {
+      if (p.best.distance <= kTarget) {
+        ++reached;
+        token.Cancel();
+      }
+    };
+    GraphAlgorithms::SolveTravelingSalesmanProblem(graph, options);
+  }
+  state.counters["reached"] = static_cast<double>(reached) / runs;
+}
+
+const std::vector<int64_t> kSizes = {32, 128, 512};
+const std::vector<int64_t> kDensities = {10, 50, 100};
+
+BENCHMARK(BM_LoadGraphFromFile)->ArgsProduct({kSizes, kDensities});
+BENCHMARK(BM_DepthFirstSearch)->ArgsProduct({kSizes, kDensities});
+BENCHMARK(BM_BreadthFirstSearch)->ArgsProduct({kSizes, kDensities});
+BENCHMARK(BM_GetShortestPathBetweenVertices)
+    ->ArgsProduct({kSizes, kDensities});
+BENCHMARK(BM_BidirectionalShortestPath)->ArgsProduct({kSizes, kDensities});
+BENCHMARK(BM_AltShortestPath)->ArgsProduct({kSizes, kDensities});
+// Иерархии сжатия рассчитаны на разреженные графы: на плотных почти каждое
+// сжатие добавляет дуги и построение растёт как V^3.
+const std::vector<int64_t> kSparseDensities = {10};
+
+BENCHMARK(BM_ContractionHierarchyShortestPath)
+    ->ArgsProduct({kSizes, kSparseDensities});
+BENCHMARK(BM_BuildContractionHierarchy)
+    ->ArgsProduct({kSizes, kSparseDensities})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_DistanceOracleEstimate)->ArgsProduct({kSizes, kDensities});
+BENCHMARK(BM_BuildDistanceOracle)
+    ->ArgsProduct({kSizes, kDensities})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_GetShortestPathsBetweenAllVertices)
+    ->ArgsProduct({kSizes, kDensities})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ShortestPathsByWeight, std::uint8_t)
+    ->ArgsProduct({kSizes, {100}})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ShortestPathsByWeight, std::uint16_t)
+    ->ArgsProduct({kSizes, {100}})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ShortestPathsByWeight, std::int64_t)
+    ->ArgsProduct({kSizes, {100}})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ShortestPathsByWeight, float)
+    ->ArgsProduct({kSizes, {100}})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ExternalShortestPaths)
+    ->ArgsProduct({kSizes, kDensities})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_GetLeastSpanningTree)->ArgsProduct({kSizes, kDensities});
+// Сжатые строки выигрывают на редких графах, поэтому плотности малы.
+const std::vector<int64_t> kStorageDensities = {1, 10};
+
+BENCHMARK_TEMPLATE(BM_BreadthFirstSearchByStorage, Graph)
+    ->ArgsProduct({kSizes, kStorageDensities});
+BENCHMARK_TEMPLATE(BM_BreadthFirstSearchByStorage, CompressedGraph<int>)
+    ->ArgsProduct({kSizes, kStorageDensities});
+BENCHMARK_TEMPLATE(BM_ShortestPathByStorage, Graph)
+    ->ArgsProduct({kSizes, kStorageDensities});
+BENCHMARK_TEMPLATE(BM_ShortestPathByStorage, CompressedGraph<int>)
+    ->ArgsProduct({kSizes, kStorageDensities});
+BENCHMARK_TEMPLATE(BM_SpanningTreeByStorage, Graph)
+    ->ArgsProduct({kSizes, kStorageDensities});
+BENCHMARK_TEMPLATE(BM_SpanningTreeByStorage, CompressedGraph<int>)
+    ->ArgsProduct({kSizes, kStorageDensities});
+// Упакованный треугольник неориентированного графа против полной матрицы.
+BENCHMARK_TEMPLATE(BM_SpanningTreeByStorage, SymmetricGraph<int>)
+    ->ArgsProduct({kSizes, kDensities});
+BENCHMARK_TEMPLATE(BM_ShortestPathsByStorage, Graph)
+    ->ArgsProduct({kSizes, kDensities})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ShortestPathsByStorage, SymmetricGraph<int>)
+    ->ArgsProduct({kSizes, kDensities})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_BreadthFirstSearchByOrder)
+    ->ArgsProduct({{512}, {0, 1, 2, 3}})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ShortestPathByOrder)
+    ->ArgsProduct({{512}, {0, 1, 2, 3}})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ExportGraphToDot)->ArgsProduct({kSizes, kDensities});
+BENCHMARK(BM_SolveTravelingSalesmanProblem)
+    ->Arg(12)
+    ->Arg(18)
+    ->Arg(48)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_TsmTimeToTarget)
+    ->DenseRange(static_cast<int>(LocalSearchMode::kNone),
+                 static_cast<int>(LocalSearchMode::kEveryAnt))
+    ->Iterations(3)
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace s21
+
+BENCHMARK_MAIN();
@@ -0,0 +1,24 @@
+#ifndef BENCHMARKS_H
+#define BENCHMARKS_H
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <map>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../model/s21_graph.h"
+#include "../model/s21_compressed_graph.h"
+#include "../model/s21_contraction_hierarchy.h"
+#include "../model/s21_distance_oracle.h"
+#include "../model/s21_external_shortest_paths.h"
+#include "../model/s21_graph_algorithms.h"
+#include "../model/s21_path_search.h"
+#include "../model/s21_symmetric_graph.h"
+#include "../model/s21_vertex_order.h"
+
+#endif // BENCHMARKS_H
@@ -1,87 +1,363 @@
 #ifndef S21_CONTROLLER_H_
 #define S21_CONTROLLER_H_
 
+#include <future>
+#include <memory>
+#include <mutex>
+
 #include "../model/s21_graph.h"
+#include "../model/s21_contraction_hierarchy.h"
+#include "../model/s21_distance_oracle.h"
 #include "../model/s21_graph_algorithms.h"
+#include "../model/s21_path_search.h"
+#include "result_cache.h"
+#include "thread_pool.h"
 
 namespace s21 {
 
+/**
+ * Runs the algorithms on the graph. Queries work on an immutable snapshot of
+ * the graph: loading a graph or changing an edge publishes a new snapshot, and
+ * queries that are already running keep the old one. The ...Async methods run
+ * the queries on a thread pool and may be called from any thread.
+ */
 class Controller {
 public:
+    using Snapshot = std::shared_ptr<const Graph>;
+
     Controller() = delete;
-    explicit Controller(Graph *graph) : graph_(graph) {}
+    /**
+     * @param graph the graph shared with the view, kept in sync with the
+     * snapshots
+     * @param cache_budget the memory budget of the result cache in bytes
+     * @param threads the number of workers for asynchronous queries, zero
+     * means all cores
+     */
+    explicit Controller(Graph *graph,
+                        std::size_t cache_budget = ResultCache::kDefaultBudget,
+                        unsigned threads = 0)
+        : graph_(graph), snapshot_(std::make_shared<const Graph>(*graph)),
+          cache_(cache_budget), pool_(threads) {}
     Controller(const Controller &other) = delete;
     Controller &operator=(const Controller &other) = delete;
     ~Controller() = default;
 
     void LoadGraphFromFile(const std::string &filename) {
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        auto loaded = std::make_shared<Graph>();
         try {
-            graph_->loadGraphFromFile(filename);
+            loaded->loadGraphFromFile(filename);
         } catch (...) {
             throw std::runtime_error("Can't load graph from file");
         }
+        *graph_ = *loaded;
+        Publish(std::move(loaded));
+        cache_.Clear();
+    }
+
+    /**
+     * Changes an edge of the graph, see Graph::SetEdge. Vertices are counted
+     * from 1. Running queries are not affected.
+     */
+    void SetEdge(std::size_t from, std::size_t to, int weight) {
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        auto changed = std::make_shared<Graph>(*GetSnapshot());
+        changed->SetEdge(static_cast<int>(from) - 1, static_cast<int>(to) - 1,
+                         weight);
+        graph_->SetEdge(static_cast<int>(from) - 1, static_cast<int>(to) - 1,
+                        weight);
+        Publish(std::move(changed));
     }
 
+    void RemoveEdge(std::size_t from, std::size_t to) { SetEdge(from, to, 0); }
+
+    /**
+     * Renumbers the vertices of the graph, see Graph::Reorder. The queries
+     * keep taking and returning the original numbers.
+     */
+    void ReorderGraph(VertexOrder order) {
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        auto reordered = std::make_shared<Graph>(*GetSnapshot());
+        reordered->Reorder(order);
+        *graph_ = *reordered;
+        Publish(std::move(reordered));
+    }
+
+    /**
+     * @return the graph that new queries work on
+     */
+    Snapshot GetSnapshot() const { return std::atomic_load(&snapshot_); }
+
     void exportGraphToDot(const std::string &filename) {
         try {
-            graph_->exportGraphToDot(filename);
+            GetSnapshot()->exportGraphToDot(filename);
         } catch (...) {
             throw std::runtime_error("Can't export graph to .dot file");
         }
     }
 
     auto DepthFirstSearch(std::size_t n) {
+        return DepthFirstSearch(*GetSnapshot(), n);
+    }
+
+    auto BreadthFirstSearch(std::size_t n) {
+        return BreadthFirstSearch(*GetSnapshot(), n);
+    }
+
+    /**
+     * The landmarks of kAlt and the hierarchy of kContractionHierarchy are
+     * built by the first such query and kept until the graph changes.
+     */
+    auto GetShortestPathBetweenVertices(
+        std::size_t a, std::size_t b,
+        PathSearch search = PathSearch::kBidirectional) {
+        return GetShortestPathBetweenVertices(*GetSnapshot(), a, b, search);
+    }
+
+    /**
+     * Estimates the distance between two vertices of an undirected graph by a
+     * DistanceOracle: the estimate is at most DistanceOracle::Stretch() times
+     * longer than the shortest path. The oracle is built by the first
+     * estimate and kept until the graph changes.
+     */
+    auto EstimateDistance(std::size_t a, std::size_t b) {
+        return EstimateDistance(*GetSnapshot(), a, b);
+    }
+
+    auto GetShortestPathsBetweenAllVertices() {
+        return GetShortestPathsBetweenAllVertices(*GetSnapshot());
+    }
+
+    auto GetLeastSpanningTree() {
+        return GetLeastSpanningTree(*GetSnapshot());
+    }
+
+    auto SolveTravelingSalesmanProblem(const TsmOptions &options = TsmOptions()) {
+        return SolveTravelingSalesmanProblem(*GetSnapshot(), options);
+    }
+
+    std::future<std::vector<int>> DepthFirstSearchAsync(std::size_t n) {
+        return pool_.Submit([this, graph = GetSnapshot(), n] {
+            return DepthFirstSearch(*graph, n);
+        });
+    }
+
+    std::future<std::vector<int>> BreadthFirstSearchAsync(std::size_t n) {
+        return pool_.Submit([this, graph = GetSnapshot(), n] {
+            return BreadthFirstSearch(*graph, n);
+        });
+    }
+
+    std::future<int> GetShortestPathBetweenVerticesAsync(
+        std::size_t a, std::size_t b,
+        PathSearch search = PathSearch::kBidirectional) {
+        return pool_.Submit([this, graph = GetSnapshot(), a, b, search] {
+            return GetShortestPathBetweenVertices(*graph, a, b, search);
+        });
+    }
+
+    std::future<int> EstimateDistanceAsync(std::size_t a, std::size_t b) {
+        return pool_.Submit([this, graph = GetSnapshot(), a, b] {
+            return EstimateDistance(*graph, a, b);
+        });
+    }
+
+    std::future<matrix> GetShortestPathsBetweenAllVerticesAsync() {
+        return pool_.Submit([this, graph = GetSnapshot()] {
+            return GetShortestPathsBetweenAllVertices(*graph);
+        });
+    }
+
+    std::future<matrix> GetLeastSpanningTreeAsync() {
+        return pool_.Submit([this, graph = GetSnapshot()] {
+            return GetLeastSpanningTree(*graph);
+        });
+    }
+
+    /**
+     * The options are copied, so the run can be stopped through
+     * options.cancellation of the caller.
+     */
+    std::future<TsmResult> SolveTravelingSalesmanProblemAsync(
+        const TsmOptions &options = TsmOptions()) {
+        return pool_.Submit([this, graph = GetSnapshot(), options] {
+            return SolveTravelingSalesmanProblem(*graph, options);
+        });
+    }
+
+    const ResultCache &Cache() const { return cache_; }
+
+    /**
+     * @return the pool that runs the asynchronous queries
+     */
+    ThreadPool &Pool() { return pool_; }
+
+    // Запросы к заданному снимку, например полученному через GetSnapshot();
+    // используют тот же кэш, что и остальные методы.
+
+    std::vector<int> DepthFirstSearch(const Graph &graph, std::size_t n) {
         try {
-            return GraphAlgorithms::DepthFirstSearch(*graph_, n);
+            return Cached<std::vector<int>>(graph, "dfs", {static_cast<int>(n)}, [&] {
+                return GraphAlgorithms::DepthFirstSearch(graph, n);
+            });
         } catch (...) {
             throw std::runtime_error("Can't find path");
         }
     }
 
-    auto BreadthFirstSearch(std::size_t n) {
+    std::vector<int> BreadthFirstSearch(const Graph &graph, std::size_t n) {
         try {
-            return GraphAlgorithms::BreadthFirstSearch(*graph_, n);
+            return Cached<std::vector<int>>(graph, "bfs", {static_cast<int>(n)}, [&] {
+                return GraphAlgorithms::BreadthFirstSearch(graph, n);
+            });
         } catch (...) {
             throw std::runtime_error("Can't find path");
         }
     }
 
-    auto GetShortestPathBetweenVertices(std::size_t a, std::size_t b) {
+    int GetShortestPathBetweenVertices(
+        const Graph &graph, std::size_t a, std::size_t b,
+        PathSearch search = PathSearch::kBidirectional) {
         try {
-            return GraphAlgorithms::GetShortestPathBetweenVertices(*graph_, a, b);
+            // Ответ берётся из закэшированной матрицы всех путей, если она есть;
+            // матрица не копируется, читается одна её ячейка.
+            if (a >= 1 && b >= 1 && a <= static_cast<std::size_t>(graph.size()) &&
+                b <= static_cast<std::size_t>(graph.size())) {
+                if (auto all = cache_.Find(graph.Version(), "apsp", {}))
+                    return std::get<matrix>(*all)[a - 1][b - 1];
+            }
+            // Алгоритм входит в ключ: ответ другого алгоритма тот же, но
+            // время в пакетном режиме и на сервере должно быть его собственным.
+            const std::vector<int> kParams = {static_cast<int>(a), static_cast<int>(b),
+                                              static_cast<int>(search)};
+            return Cached<int>(graph, "sp", kParams, [&] {
+                const std::size_t kFrom = ToInternal(graph, a);
+                const std::size_t kTo = ToInternal(graph, b);
+                switch (search) {
+                case PathSearch::kBidirectional:
+                    return PointToPoint::Bidirectional(graph, kFrom, kTo);
+                case PathSearch::kAlt:
+                    return PointToPoint::Alt(graph, *landmarks_.Get(graph), kFrom, kTo);
+                case PathSearch::kContractionHierarchy:
+                    return hierarchy_.Get(graph)->Distance(kFrom, kTo);
+                default:
+                    return GraphAlgorithms::GetShortestPathBetweenVertices(graph, a, b);
+                }
+            });
         } catch (...) {
             throw std::runtime_error("Can't find path");
         }
     }
 
-    auto GetShortestPathsBetweenAllVertices() {
+    int EstimateDistance(const Graph &graph, std::size_t a, std::size_t b) {
         try {
-            return GraphAlgorithms::GetShortestPathsBetweenAllVertices(*graph_);
+            return oracle_.Get(graph)->Distance(ToInternal(graph, a),
+                                                ToInternal(graph, b));
+        } catch (...) {
+            throw std::runtime_error("Can't estimate distance");
+        }
+    }
+
+    matrix GetShortestPathsBetweenAllVertices(const Graph &graph) {
+        try {
+            return Cached<matrix>(graph, "apsp", {}, [&] {
+                return GraphAlgorithms::GetShortestPathsBetweenAllVertices(graph);
+            });
         } catch (...) {
             throw std::runtime_error("Can't find path");
         }
     }
 
-    auto GetLeastSpanningTree() { 
+    matrix GetLeastSpanningTree(const Graph &graph) {
         try {
-            return GraphAlgorithms::GetLeastSpanningTree(*graph_);
+            return Cached<matrix>(graph, "mst", {}, [&] {
+                return GraphAlgorithms::GetLeastSpanningTree(graph);
+            });
         } catch (...) {
             throw std::runtime_error("Can't find path");
         }
     }
 
-    auto SolveTravelingSalesmanProblem() { 
+    TsmResult SolveTravelingSalesmanProblem(const Graph &graph,
+                                            const TsmOptions &options) {
         try {
-            return GraphAlgorithms::SolveTravelingSalesmanProblem(*graph_);
+            return GraphAlgorithms::SolveTravelingSalesmanProblem(graph, options);
         } catch (...) {
             throw std::runtime_error("Can't find path");
         }
     }
 
 private:
+    /**
+     * Preprocessing of the graph shared by the queries of one version, such
+     * as landmarks. It is built on first use and replaced when a query comes
+     * for another version.
+     */
+    template <typename Index>
+    class PerVersion {
+    public:
+        std::shared_ptr<const Index> Get(const Graph &graph) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (index_ && version_ == graph.Version()) return index_;
+            }
+            auto index = std::make_shared<const Index>(graph);
+            std::lock_guard<std::mutex> lock(mutex_);
+            index_ = index;
+            version_ = graph.Version();
+            return index;
+        }
+
+    private:
+        std::mutex mutex_;
+        std::shared_ptr<const Index> index_;
+        std::uint64_t version_ = 0;
+    };
+
+    /**
+     * Returns the cached result of the algorithm for the version of the graph,
+     * or computes and caches it. The salesman problem is not cached: its
+     * result depends on the random seed and the time budget.
+     */
+    template <typename Result, typename Compute>
+    Result Cached(const Graph &graph, const char *algorithm,
+                  const std::vector<int> &params, Compute compute) {
+        const std::uint64_t kVersion = graph.Version();
+        if (auto cached = cache_.Find(kVersion, algorithm, params))
+            return std::get<Result>(*cached);
+        Result result = compute();
+        cache_.Insert(kVersion, algorithm, params, result);
+        return result;
+    }
+
+    /**
+     * Translates a vertex counted from 1 into the internal numbering of a
+     * reordered graph for the indexes that work on the matrix directly.
+     * Vertices out of range are passed as they are for the indexes to reject.
+     */
+    static std::size_t ToInternal(const Graph &graph, std::size_t vertex) {
+        if (vertex < 1 || vertex > static_cast<std::size_t>(graph.size()))
+            return vertex;
+        return graph.Permutation().ToInternal(static_cast<int>(vertex) - 1) + 1;
+    }
+
+    void Publish(std::shared_ptr<Graph> graph) {
+        std::atomic_store(&snapshot_, Snapshot(std::move(graph)));
+    }
+
     Graph *graph_;
+    Snapshot snapshot_;
+    // Загрузки и изменения рёбер выполняются по одной.
+    std::mutex write_mutex_;
+    ResultCache cache_;
+    PerVersion<Landmarks> landmarks_;
+    PerVersion<ContractionHierarchy> hierarchy_;
+    PerVersion<DistanceOracle> oracle_;
+    // Объявлен последним: задачи пула используют кэш и должны завершиться
+    // раньше, чем он будет разрушен.
+    ThreadPool pool_;
 };
 
 } // namespace s21
 
-#endif // S21_CONTROLLER_H_
\ No newline at end of file
+#endif // S21_CONTROLLER_H_
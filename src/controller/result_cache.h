@@ -0,0 +1,138 @@
+#ifndef S21_RESULT_CACHE_H_
+#define S21_RESULT_CACHE_H_
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+#include "../model/s21_graph.h"
+
+namespace s21 {
+
+/**
+ * LRU cache of algorithm results keyed by the graph version, the name of the
+ * algorithm and its integer parameters. The total size of the stored results
+ * is bounded by a memory budget; the least recently used results are evicted
+ * first. All methods are thread-safe.
+ */
+class ResultCache {
+public:
+    using Value = std::variant<int, std::vector<int>, matrix>;
+
+    static constexpr std::size_t kDefaultBudget = std::size_t{64} << 20;
+
+    explicit ResultCache(std::size_t budget = kDefaultBudget) : budget_(budget) {}
+
+    /**
+     * Looks a result up and marks it as recently used. The result is shared,
+     * not copied, so that a large one such as the matrix of all shortest paths
+     * costs O(1) under the lock and stays valid after it is evicted.
+     *
+     * @return the result, or nullptr if it is not cached
+     */
+    std::shared_ptr<const Value> Find(std::uint64_t version,
+                                      const std::string &algorithm,
+                                      const std::vector<int> &params) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto found = index_.find(Key(version, algorithm, params));
+        if (found == index_.end()) {
+            ++misses_;
+            return nullptr;
+        }
+        ++hits_;
+        entries_.splice(entries_.begin(), entries_, found->second);
+        return found->second->value;
+    }
+
+    /**
+     * Stores a result, evicting the least recently used ones to stay within
+     * the budget. Results larger than the whole budget are not stored.
+     */
+    void Insert(std::uint64_t version, const std::string &algorithm,
+                const std::vector<int> &params, Value value) {
+        const std::size_t kSize = Footprint(value);
+        if (kSize > budget_) return;
+        auto shared = std::make_shared<const Value>(std::move(value));
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::string key = Key(version, algorithm, params);
+        auto found = index_.find(key);
+        if (found != index_.end()) {
+            size_ -= found->second->size;
+            entries_.erase(found->second);
+            index_.erase(found);
+        }
+        while (size_ + kSize > budget_) {
+            size_ -= entries_.back().size;
+            index_.erase(entries_.back().key);
+            entries_.pop_back();
+        }
+        entries_.push_front({key, std::move(shared), kSize});
+        index_.emplace(std::move(key), entries_.begin());
+        size_ += kSize;
+    }
+
+    void Clear() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        entries_.clear();
+        index_.clear();
+        size_ = 0;
+    }
+
+    std::size_t Size() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return size_;
+    }
+
+    std::size_t Hits() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return hits_;
+    }
+
+    std::size_t Misses() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return misses_;
+    }
+
+private:
+    struct Entry {
+        std::string key;
+        std::shared_ptr<const Value> value;
+        std::size_t size;
+    };
+
+    static std::string Key(std::uint64_t version, const std::string &algorithm,
+                           const std::vector<int> &params) {
+        std::string key = std::to_string(version) + ':' + algorithm;
+        for (int param : params) key += ':' + std::to_string(param);
+        return key;
+    }
+
+    // Приблизительный объём памяти результата вместе с накладными расходами.
+    static std::size_t Footprint(const Value &value) {
+        std::size_t size = sizeof(Entry) + 64;
+        if (const auto *path = std::get_if<std::vector<int>>(&value)) {
+            size += path->size() * sizeof(int);
+        } else if (const auto *table = std::get_if<matrix>(&value)) {
+            for (const auto &row : *table)
+                size += sizeof(row) + row.size() * sizeof(int);
+        }
+        return size;
+    }
+
+    const std::size_t budget_;
+    mutable std::mutex mutex_;
+    std::list<Entry> entries_;
+    std::unordered_map<std::string, std::list<Entry>::iterator> index_;
+    std::size_t size_ = 0;
+    std::size_t hits_ = 0;
+    std::size_t misses_ = 0;
+};
+
+} // namespace s21
+
+#endif // S21_RESULT_CACHE_H_
@@ -0,0 +1,178 @@
+#ifndef S21_THREAD_POOL_H_
+#define S21_THREAD_POOL_H_
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace s21 {
+
+/**
+ * Work-stealing thread pool. Every worker has its own queue: tasks submitted
+ * by a worker go to its own queue and are taken from the back, other tasks are
+ * spread over the queues round-robin. An idle worker steals from the front of
+ * the other queues. The destructor finishes all submitted tasks.
+ */
+class ThreadPool {
+public:
+    /**
+     * @param threads the number of workers, zero means all cores
+     */
+    explicit ThreadPool(unsigned threads = 0) {
+        const unsigned kThreads =
+            threads ? threads : std::max(1u, std::thread::hardware_concurrency());
+        for (unsigned i = 0; i != kThreads; ++i)
+            queues_.push_back(std::make_unique<Queue>());
+        for (unsigned i = 0; i != kThreads; ++i)
+            workers_.emplace_back([this, i] { Work(i); });
+    }
+
+    ThreadPool(const ThreadPool &other) = delete;
+    ThreadPool &operator=(const ThreadPool &other) = delete;
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(wake_mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (auto &worker : workers_) worker.join();
+    }
+
+    /**
+     * Schedules a task.
+     *
+     * @param task a callable without arguments
+     *
+     * @return the future result of the task, exceptions are rethrown by get()
+     */
+    template <typename Task>
+    std::future<std::invoke_result_t<Task>> Submit(Task task) {
+        using Result = std::invoke_result_t<Task>;
+        auto packaged =
+            std::make_shared<std::packaged_task<Result()>>(std::move(task));
+        std::future<Result> result = packaged->get_future();
+        Push([packaged] { (*packaged)(); });
+        return result;
+    }
+
+    /**
+     * Waits for a future. Called from a worker, it runs queued tasks while
+     * waiting, so a task may wait for the tasks it has submitted without
+     * blocking the pool.
+     *
+     * @return the result of the future
+     */
+    template <typename Result>
+    Result Wait(std::future<Result> &result) {
+        const int kWorker = WorkerIndex();
+        while (kWorker >= 0 && result.wait_for(std::chrono::seconds(0)) !=
+                                   std::future_status::ready) {
+            std::function<void()> task;
+            if (Pop(static_cast<std::size_t>(kWorker), task)) {
+                {
+                    std::lock_guard<std::mutex> lock(wake_mutex_);
+                    --pending_;
+                }
+                task();
+            } else {
+                result.wait_for(std::chrono::milliseconds(1));
+            }
+        }
+        return result.get();
+    }
+
+    unsigned Size() const { return static_cast<unsigned>(workers_.size()); }
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    // Номер рабочего потока этого пула, -1 для остальных потоков.
+    int WorkerIndex() const {
+        return current_pool_ == this ? current_index_ : -1;
+    }
+
+    void Push(std::function<void()> task) {
+        const int kWorker = WorkerIndex();
+        const std::size_t kQueue =
+            kWorker >= 0 ? static_cast<std::size_t>(kWorker)
+                         : next_queue_++ % queues_.size();
+        {
+            std::lock_guard<std::mutex> lock(queues_[kQueue]->mutex);
+            queues_[kQueue]->tasks.push_back(std::move(task));
+        }
+        {
+            std::lock_guard<std::mutex> lock(wake_mutex_);
+            ++pending_;
+        }
+        wake_.notify_one();
+    }
+
+    bool Pop(std::size_t index, std::function<void()> &task) {
+        {
+            Queue &own = *queues_[index];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (!own.tasks.empty()) {
+                task = std::move(own.tasks.back());
+                own.tasks.pop_back();
+                return true;
+            }
+        }
+        for (std::size_t i = 1; i != queues_.size(); ++i) {
+            Queue &other = *queues_[(index + i) % queues_.size()];
+            std::lock_guard<std::mutex> lock(other.mutex);
+            if (!other.tasks.empty()) {
+                task = std::move(other.tasks.front());
+                other.tasks.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void Work(std::size_t index) {
+        current_pool_ = this;
+        current_index_ = static_cast<int>(index);
+        while (true) {
+            std::function<void()> task;
+            if (Pop(index, task)) {
+                {
+                    std::lock_guard<std::mutex> lock(wake_mutex_);
+                    --pending_;
+                }
+                task();
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(wake_mutex_);
+            wake_.wait(lock, [this] { return stop_ || pending_ > 0; });
+            if (stop_ && pending_ == 0) return;
+        }
+    }
+
+    static inline thread_local const ThreadPool *current_pool_ = nullptr;
+    static inline thread_local int current_index_ = -1;
+
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::vector<std::thread> workers_;
+    std::atomic<std::size_t> next_queue_{0};
+    std::mutex wake_mutex_;
+    std::condition_variable wake_;
+    std::size_t pending_ = 0;
+    bool stop_ = false;
+};
+
+} // namespace s21
+
+#endif // S21_THREAD_POOL_H_
@@ -1,9 +1,60 @@
+#include <csignal>
+#include <cstring>
+
+#include "view/batch_view.h"
 #include "view/console_view.h"
+#include "view/server_view.h"
+
+namespace {
+
+s21::ServerView *serving = nullptr;
+
+void StopServer(int) {
+    if (serving) serving->Stop();
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    // Navigator --serve /tmp/navigator.sock
+    if (argc > 1 && std::strcmp(argv[1], "--serve") == 0) {
+        if (argc != 3) {
+            std::cerr << "Usage: " << argv[0] << " --serve <socket>" << std::endl;
+            return 2;
+        }
+        try {
+            s21::ServerView server;
+            serving = &server;
+            std::signal(SIGINT, StopServer);
+            std::signal(SIGTERM, StopServer);
+            server.Run(argv[2]);
+            serving = nullptr;
+            return 0;
+        } catch (const std::exception &error) {
+            serving = nullptr;
+            std::cerr << error.what() << std::endl;
+            return 2;
+        }
+    }
 
-int main() {
     s21::Graph graph;
     s21::Controller controller(&graph);
+    // Navigator --batch queries.txt results.csv|results.json
+    if (argc > 1 && std::strcmp(argv[1], "--batch") == 0) {
+        if (argc != 4) {
+            std::cerr << "Usage: " << argv[0]
+                      << " --batch <queries> <results.csv|results.json>" << std::endl;
+            return 2;
+        }
+        try {
+            s21::BatchView batch(&controller);
+            return batch.Run(argv[2], argv[3]) == 0 ? 0 : 1;
+        } catch (const std::exception &error) {
+            std::cerr << error.what() << std::endl;
+            return 2;
+        }
+    }
     s21::ConsoleView view(&controller);
     view.show();
     return 0;
-}
\ No newline at end of file
+}
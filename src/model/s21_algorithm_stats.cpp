@@ -0,0 +1,113 @@
+#include "s21_algorithm_stats.h"
+
+#include <algorithm>
+#include <mutex>
+
+namespace s21 {
+
+namespace {
+std::mutex sink_mutex;
+Statistics::Sink sink;
+
+thread_local AlgorithmStats running;
+thread_local AlgorithmStats *current = nullptr;
+thread_local AlgorithmStats last;
+
+double Milliseconds(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+}  // namespace
+
+std::ostream &operator<<(std::ostream &stream, const AlgorithmStats &stats) {
+  stream << "Statistics of " << stats.algorithm << ": " << stats.total_ms
+         << " ms\n";
+  const std::pair<const char *, std::uint64_t> kCounters[] = {
+      {"vertices popped", stats.vertices_popped},
+      {"edges scanned", stats.edges_scanned},
+      {"edges relaxed", stats.edges_relaxed},
+      {"heap operations", stats.heap_operations},
+      {"cells updated", stats.cells_updated},
+      {"ant steps", stats.ant_steps},
+      {"pheromone updates", stats.pheromone_updates},
+      {"iterations", stats.iterations},
+      {"converged at iteration", stats.convergence_iteration},
+      {"peak scratch bytes", stats.peak_scratch_bytes}};
+  for (const auto &counter : kCounters)
+    if (counter.second != 0)
+      stream << "  " << counter.first << ": " << counter.second << '\n';
+  for (const auto &phase : stats.phases)
+    stream << "  phase " << phase.first << ": " << phase.second << " ms\n";
+  return stream;
+}
+
+void Statistics::SetSink(Sink new_sink) {
+  std::lock_guard<std::mutex> lock(sink_mutex);
+  sink = std::move(new_sink);
+}
+
+AlgorithmStats Statistics::Last() { return last; }
+
+AlgorithmStats *Statistics::Current() { return current; }
+
+void Statistics::RecordMemory(std::size_t bytes) {
+  if (current)
+    current->peak_scratch_bytes = std::max(current->peak_scratch_bytes, bytes);
+}
+
+Statistics::Scope::Scope(const char *algorithm)
+    : owner_(current == nullptr), start_(std::chrono::steady_clock::now()) {
+  if (!owner_) return;
+  running = AlgorithmStats();
+  running.algorithm = algorithm;
+  current = &running;
+}
+
+Statistics::Scope::~Scope() {
+  if (!owner_) return;
+  current->total_ms = Milliseconds(start_);
+  last = std::move(running);
+  current = nullptr;
+
+  std::lock_guard<std::mutex> lock(sink_mutex);
+  if (sink) sink(last);
+}
+
+void Statistics::Merge(const AlgorithmStats &stats) {
+  if (!current) return;
+  current->vertices_popped += stats.vertices_popped;
+  current->edges_scanned += stats.edges_scanned;
+  current->edges_relaxed += stats.edges_relaxed;
+  current->heap_operations += stats.heap_operations;
+  current->cells_updated += stats.cells_updated;
+  current->ant_steps += stats.ant_steps;
+  current->pheromone_updates += stats.pheromone_updates;
+  current->peak_scratch_bytes =
+      std::max(current->peak_scratch_bytes, stats.peak_scratch_bytes);
+}
+
+Statistics::Collect::Collect(AlgorithmStats *stats) : previous_(current) {
+  current = stats;
+}
+
+Statistics::Collect::~Collect() { current = previous_; }
+
+Statistics::Phase::Phase(const char *name)
+    : name_(name), start_(std::chrono::steady_clock::now()) {}
+
+Statistics::Phase::~Phase() {
+  if (!current) return;
+  const double kElapsed = Milliseconds(start_);
+  auto &phases = current->phases;
+  auto found = std::find_if(phases.begin(), phases.end(),
+                            [this](const auto &phase) {
+                              return phase.first == name_;
+                            });
+  if (found == phases.end())
+    phases.emplace_back(name_, kElapsed);
+  else
+    found->second += kElapsed;
+}
+
+}  // namespace s21
@@ -0,0 +1,185 @@
+#ifndef SRC_MODEL_S21_ALGORITHM_STATS_H_
+#define SRC_MODEL_S21_ALGORITHM_STATS_H_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace s21 {
+
+/**
+ * Counters and timings of one call of a graph algorithm.
+ *
+ * @field algorithm the name of the algorithm
+ * @field vertices_popped vertices taken from a stack, queue or scan
+ * @field edges_scanned edges looked at while expanding a vertex
+ * @field edges_relaxed edges that improved a tentative distance
+ * @field heap_operations pushes and pops of the stack or queue
+ * @field cells_updated improved cells of the Floyd-Warshall matrix or filled
+ * cells of the Held-Karp table
+ * @field ant_steps moves of all ants
+ * @field pheromone_updates written cells of the pheromone matrix
+ * @field iterations finished iterations (ant colony) or layers (Held-Karp)
+ * @field convergence_iteration the iteration of the last improvement
+ * @field peak_scratch_bytes the largest reported size of working memory
+ * @field phases milliseconds spent in named phases, in order of appearance
+ * @field total_ms milliseconds spent in the whole call
+ */
+struct AlgorithmStats {
+  std::string algorithm;
+  std::uint64_t vertices_popped = 0;
+  std::uint64_t edges_scanned = 0;
+  std::uint64_t edges_relaxed = 0;
+  std::uint64_t heap_operations = 0;
+  std::uint64_t cells_updated = 0;
+  std::uint64_t ant_steps = 0;
+  std::uint64_t pheromone_updates = 0;
+  std::uint64_t iterations = 0;
+  std::uint64_t convergence_iteration = 0;
+  std::size_t peak_scratch_bytes = 0;
+  std::vector<std::pair<std::string, double>> phases;
+  double total_ms = 0;
+};
+
+/**
+ * Prints the non-zero counters and the phases of the stats, one per line.
+ */
+std::ostream &operator<<(std::ostream &stream, const AlgorithmStats &stats);
+
+/**
+ * Opt-in instrumentation of the algorithms. It is compiled in only when
+ * S21_GRAPH_STATS is defined; otherwise the S21_STATS_* macros expand to
+ * nothing and Last() always returns empty stats.
+ *
+ * A public algorithm opens a Scope; counters are added to the scope of the
+ * calling thread, nested scopes are merged into the outer one. Work done by
+ * worker threads is reported by the calling thread in aggregate (Held-Karp
+ * layers) or collected per task with Collect and merged after the join
+ * (island colonies).
+ */
+class Statistics {
+ public:
+  using Sink = std::function<void(const AlgorithmStats &)>;
+
+#ifdef S21_GRAPH_STATS
+  static constexpr bool kEnabled = true;
+#else
+  static constexpr bool kEnabled = false;
+#endif
+
+  /**
+   * Registers a function called with the stats of every finished call. The
+   * sink may be called from any thread that runs an algorithm.
+   *
+   * @param sink the function, an empty one removes the sink
+   */
+  static void SetSink(Sink sink);
+
+  /**
+   * @return the stats of the last call finished on this thread
+   */
+  static AlgorithmStats Last();
+
+  /**
+   * @return the stats of the running call of this thread, nullptr outside of
+   * a call
+   */
+  static AlgorithmStats *Current();
+
+  /**
+   * Raises the peak working memory of the running call.
+   *
+   * @param bytes the current size of the working memory
+   */
+  static void RecordMemory(std::size_t bytes);
+
+  class Scope {
+   public:
+    explicit Scope(const char *algorithm);
+    ~Scope();
+    Scope(const Scope &) = delete;
+    Scope &operator=(const Scope &) = delete;
+
+   private:
+    bool owner_ = false;
+    std::chrono::steady_clock::time_point start_;
+  };
+
+  /**
+   * Adds the counters of a task collected by Collect to the running call of
+   * this thread. The peak memory is the largest of the two; iterations and
+   * phases are left to the calling algorithm.
+   *
+   * @param stats the counters of the task
+   */
+  static void Merge(const AlgorithmStats &stats);
+
+  /**
+   * Sends the counters of this thread to the given stats while the object
+   * lives, also on the thread of a running call, so that every task of a
+   * parallel algorithm is counted alike.
+   */
+  class Collect {
+   public:
+    explicit Collect(AlgorithmStats *stats);
+    ~Collect();
+    Collect(const Collect &) = delete;
+    Collect &operator=(const Collect &) = delete;
+
+   private:
+    AlgorithmStats *previous_;
+  };
+
+  class Phase {
+   public:
+    explicit Phase(const char *name);
+    ~Phase();
+    Phase(const Phase &) = delete;
+    Phase &operator=(const Phase &) = delete;
+
+   private:
+    const char *name_;
+    std::chrono::steady_clock::time_point start_;
+  };
+};
+
+}  // namespace s21
+
+#ifdef S21_GRAPH_STATS
+#define S21_STATS_CONCAT_(a, b) a##b
+#define S21_STATS_CONCAT(a, b) S21_STATS_CONCAT_(a, b)
+#define S21_STATS_SCOPE(algorithm) \
+  ::s21::Statistics::Scope s21_stats_scope_(algorithm)
+#define S21_STATS_PHASE(name)                                           \
+  ::s21::Statistics::Phase S21_STATS_CONCAT(s21_stats_phase_, __LINE__)( \
+      name)
+#define S21_STATS_ADD(counter, value)                                 \
+  do {                                                                \
+    if (auto *s21_stats_ = ::s21::Statistics::Current())              \
+      s21_stats_->counter += (value);                                 \
+  } while (0)
+#define S21_STATS_SET(counter, value)                                 \
+  do {                                                                \
+    if (auto *s21_stats_ = ::s21::Statistics::Current())              \
+      s21_stats_->counter = (value);                                  \
+  } while (0)
+#define S21_STATS_MEMORY(bytes) ::s21::Statistics::RecordMemory(bytes)
+#define S21_STATS_COLLECT(stats) \
+  ::s21::Statistics::Collect s21_stats_collect_(stats)
+#define S21_STATS_MERGE(stats) ::s21::Statistics::Merge(stats)
+#else
+#define S21_STATS_SCOPE(algorithm) ((void)0)
+#define S21_STATS_PHASE(name) ((void)0)
+#define S21_STATS_ADD(counter, value) ((void)0)
+#define S21_STATS_SET(counter, value) ((void)0)
+#define S21_STATS_MEMORY(bytes) ((void)0)
+#define S21_STATS_COLLECT(stats) ((void)0)
+#define S21_STATS_MERGE(stats) ((void)0)
+#endif
+
+#endif  // SRC_MODEL_S21_ALGORITHM_STATS_H_
@@ -1,16 +1,78 @@
 #include "s21_ant_algorithm.h"
 
+#include "s21_algorithm_stats.h"
+#include "s21_trace.h"
+
 namespace s21 {
 
-AntColony::AntColony(const Graph &graph)
-    : graph_(graph), kQ_(0.015 * graph.getGraphWeight()) {
-  const int kVertexesCount = graph_.size();
-  matrixAntd matrix(kVertexesCount, std::vector<double>(kVertexesCount));
-  for (int row = 0; row != kVertexesCount; ++row)
-    for (int col = 0; col != kVertexesCount; ++col)
-      if (row != col) matrix[row][col] = kPheromone0_;
+namespace {
+const char kCheckpointMagic[8] = {'S', '2', '1', 'A', 'C', 'O', 'C', 'K'};
+// Версия 2 хранит схему феромона: упакованную для неориентированного графа,
+// версия 3 ещё и порядок вершин, в котором записаны феромон и тур.
+const std::uint32_t kCheckpointVersion = 3;
+// Текстовое состояние std::mt19937 занимает около 7 КиБ.
+const std::uint32_t kMaxGeneratorState = 1 << 16;
+
+template <typename T>
+void WriteValue(std::ostream &stream, const T &value) {
+  stream.write(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+template <typename T>
+T ReadValue(std::istream &stream) {
+  T value{};
+  stream.read(reinterpret_cast<char *>(&value), sizeof(value));
+  if (!stream) {
+    throw std::runtime_error("[ [File error] ] :: Damaged checkpoint\n");
+  }
+  return value;
+}
+
+std::chrono::milliseconds Elapsed(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - start);
+}
+}  // namespace
+
+PheromoneMatrix::PheromoneMatrix(int size, bool symmetric, double level)
+    : size_(size),
+      symmetric_(symmetric),
+      cells_(symmetric ? PackedSymmetricMatrix<double>::Cells(size)
+                       : static_cast<std::size_t>(size) * size,
+             level) {}
 
-  pheromone_ = std::move(matrix);
+PheromoneMatrix PheromoneMatrix::Reshaped(bool symmetric) const {
+  PheromoneMatrix result(size_, symmetric, 0);
+  for (int from = 0; from != size_; ++from) {
+    for (int to = symmetric ? from : 0; to != size_; ++to) {
+      result(from, to) = symmetric && !symmetric_
+                             ? ((*this)(from, to) + (*this)(to, from)) / 2
+                             : (*this)(from, to);
+    }
+  }
+  return result;
+}
+
+PheromoneMatrix PheromoneMatrix::Renumbered(
+    const std::vector<int> &numbers) const {
+  PheromoneMatrix result(size_, symmetric_, 0);
+  for (int from = 0; from != size_; ++from) {
+    for (int to = symmetric_ ? from : 0; to != size_; ++to) {
+      result(numbers[from], numbers[to]) = (*this)(from, to);
+    }
+  }
+  return result;
+}
+
+AntColony::AntColony(const Graph &graph, const AntColonyParams &params)
+    : kQ_(0.015 * graph.Properties().total_weight),
+      graph_(graph),
+      params_(params),
+      generator_(params.seed ? params.seed : std::random_device()()) {
+  best_.distance = std::numeric_limits<double>::max();
+  // Уровень на диагонали не читается: муравей не ходит по петлям.
+  pheromone_ = PheromoneMatrix(graph_.size(), !graph_.IsDirected(),
+                               kPheromone0_);
 }
 
 /**
@@ -33,25 +95,56 @@ void AntColony::CreateAnts() {
  *
  * @throws None
  */
-void AntColony::UpdateGlobalPheromone(const matrixAntd &lpu) {
-  for (std::size_t i = 0, size = lpu.size(); i != size; ++i) {
-    for (std::size_t j = 0; j != size; ++j) {
-      pheromone_[i][j] = (1 - kInitialPheromone) * pheromone_[i][j] + lpu[i][j];
-      if (pheromone_[i][j] < 0.01 and i != j) pheromone_[i][j] = 0.01;
-    }
+void AntColony::UpdateGlobalPheromone(const PheromoneMatrix &lpu) {
+  std::vector<double> &cells = pheromone_.Cells();
+  const std::vector<double> &update = lpu.Cells();
+  for (std::size_t i = 0, size = cells.size(); i != size; ++i) {
+    cells[i] = (1 - params_.evaporation) * cells[i] + update[i];
+    if (cells[i] < 0.01) cells[i] = 0.01;
   }
+  S21_STATS_ADD(pheromone_updates, cells.size());
+}
+
+/**
+ * Deposits pheromone on the edges of a constructed tour as if every ant of an
+ * iteration had walked it, so the first iterations follow the tour instead of
+ * a uniform random walk.
+ *
+ * @param tour the initial tour
+ *
+ * @throws None
+ */
+void AntColony::SeedPheromone(const TsmResult &tour) {
+  const double kDeposit = graph_.size() * kQ_ / tour.distance;
+  // У неориентированного графа обратная дуга делит уровень с прямой.
+  for (std::size_t v = 0; v + 1 < tour.path.size(); ++v)
+    pheromone_(tour.path[v], tour.path[v + 1]) += kDeposit;
+}
+
+/**
+ * Mixes another pheromone matrix of the same size into the own one.
+ *
+ * @param other the pheromone matrix of another colony
+ * @param share the weight of the other matrix, from 0 to 1
+ *
+ * @throws None
+ */
+void AntColony::BlendPheromone(const PheromoneMatrix &other, double share) {
+  std::vector<double> &cells = pheromone_.Cells();
+  for (std::size_t i = 0, size = cells.size(); i != size; ++i)
+    cells[i] = (1 - share) * cells[i] + share * other.Cells()[i];
 }
 
 /**
  * Generates a random number between 0.0 and 1.0 using a uniform distribution.
  *
+ * @param generator the random generator of the colony
+ *
  * @return The generated random number.
  */
-double Ant::getRandomChoice() {
-  std::random_device rd;
-  std::mt19937 gen(rd());
+double Ant::getRandomChoice(std::mt19937 &generator) {
   std::uniform_real_distribution<> dis(0.0, 1.0);
-  return dis(gen);
+  return dis(generator);
 }
 
 /**
@@ -79,9 +172,12 @@ std::vector<int> Ant::getNeighborVertexes(const Graph &graph) {
  *
  * @param graph The graph representing the environment.
  * @param phero_lvl The pheromone level matrix.
+ * @param params The alpha and beta weights of the colony.
+ * @param generator The random generator of the colony.
  *
  */
-void Ant::MakeChoice(const Graph &graph, const matrixAntd &phero_lvl) {
+void Ant::MakeChoice(const Graph &graph, const PheromoneMatrix &phero_lvl,
+                     const AntColonyParams &params, std::mt19937 &generator) {
   if (ant_result.path.empty()) {
     ant_result.path.push_back(current_location);
     visited.push_back(current_location);
@@ -104,10 +200,11 @@ void Ant::MakeChoice(const Graph &graph, const matrixAntd &phero_lvl) {
   std::vector<double> probability;
   double sum = 0.0f;
   for (auto const &it : neighbor_vertexes) {
-    double pheromone_level = phero_lvl[current_location][it];
+    double pheromone_level = phero_lvl(current_location, it);
     double heuristic = graph[current_location][it];
     double eta = 1.0 / heuristic;
-    wish.push_back(std::pow(pheromone_level, kAlpha_) * std::pow(eta, kBeta_));
+    wish.push_back(std::pow(pheromone_level, params.alpha) *
+                   std::pow(eta, params.beta));
     sum += wish.back();
   }
 
@@ -122,7 +219,7 @@ void Ant::MakeChoice(const Graph &graph, const matrixAntd &phero_lvl) {
   }
 
   std::size_t next_vertex = 0;
-  double choose = getRandomChoice();
+  double choose = getRandomChoice(generator);
 
   // Можно сделать бинарный поиск
 
@@ -134,43 +231,344 @@ void Ant::MakeChoice(const Graph &graph, const matrixAntd &phero_lvl) {
   }
 
   ant_result.path.push_back(next_vertex);
+  S21_STATS_ADD(ant_steps, 1);
   ant_result.distance += graph[current_location][next_vertex];
   visited.push_back(next_vertex);
   current_location = next_vertex;
 }
 
-TsmResult AntColony::SolveSalesmansProblem() {
+/**
+ * Checks whether the run was cancelled or ran out of its time budget.
+ *
+ * @param options the limits of the run
+ * @param elapsed the time passed since the start of the run
+ *
+ * @return true if the run must be interrupted immediately
+ */
+bool AntColony::IsInterrupted(const TsmOptions &options,
+                              std::chrono::milliseconds elapsed) {
+  if (options.cancellation.IsCancelled()) return true;
+  return options.time_budget.count() > 0 && elapsed >= options.time_budget;
+}
+
+/**
+ * Checks whether the run must stop before starting the next iteration.
+ *
+ * @param options the limits of the run
+ * @param iteration the number of finished iterations
+ * @param stall the number of finished iterations without improvement
+ * @param elapsed the time passed since the start of the run
+ *
+ * @return true if any of the limits is reached
+ */
+bool AntColony::ShouldStop(const TsmOptions &options, std::size_t iteration,
+                           std::size_t stall,
+                           std::chrono::milliseconds elapsed) {
+  if (IsInterrupted(options, elapsed)) return true;
+  if (options.max_iterations != 0 && iteration >= options.max_iterations)
+    return true;
+  return options.stall_limit != 0 && stall >= options.stall_limit;
+}
+
+TsmResult AntColony::SolveSalesmansProblem(const TsmOptions &options) {
   if (graph_.size() == 0) return {};
+  S21_STATS_SCOPE("AntColony");
 
-  const std::size_t kVertexesCount = graph_.size();
-  std::size_t counter = 0;
+  const auto kStart = std::chrono::steady_clock::now();
+  {
+    S21_STATS_PHASE("preparation");
+    Prepare(options);
+  }
+  if (!best_.path.empty() && options.on_progress)
+    options.on_progress({iteration_, Elapsed(kStart), best_});
 
-  TsmResult path;
-  path.distance = std::numeric_limits<double>::max();
+  while (!ShouldStop(options, iteration_, stall_, Elapsed(kStart))) {
+    if (!RunIteration(options, kStart)) break;
+    if (stall_ == 0 && options.on_progress)
+      options.on_progress({iteration_, Elapsed(kStart), best_});
+    if (!options.checkpoint_path.empty() && options.checkpoint_interval != 0 &&
+        iteration_ % options.checkpoint_interval == 0)
+      SaveCheckpoint(options.checkpoint_path);
+  }
+  if (!options.checkpoint_path.empty()) SaveCheckpoint(options.checkpoint_path);
+  return best_;
+}
 
-  while (counter++ != kNumIterations) {
-    matrixAntd local_pheromone_update(kVertexesCount,
-                                      std::vector<double>(kVertexesCount, 0.0));
-    CreateAnts();
+void AntColony::Prepare(const TsmOptions &options) {
+  iteration_ = 0;
+  stall_ = 0;
+  best_ = TsmResult();
+  best_.distance = std::numeric_limits<double>::max();
 
-    for (auto &ant : ants_) {
-      while (ant.can_continue) ant.MakeChoice(graph_, pheromone_);
+  local_search_.reset();
+  if (options.local_search != LocalSearchMode::kNone)
+    local_search_ = std::make_unique<LocalSearch>(graph_);
 
-      auto ant_path = ant.ant_result;
-      if (ant_path.path.size() == kVertexesCount + 1) {
-        if (path.distance > ant.ant_result.distance) {
-          path = std::move(ant.ant_result);
-          counter = 0;
-        }
+  if (!options.resume_from.empty()) {
+    LoadCheckpoint(options.resume_from);
+  } else if (options.initial_tour != InitialTour::kNone) {
+    TsmResult initial = TourConstruction::Build(graph_, options.initial_tour);
+    if (!initial.path.empty()) {
+      if (local_search_) local_search_->Improve(initial);
+      SeedPheromone(initial);
+      best_ = std::move(initial);
+    }
+  }
+}
 
-        for (std::size_t v = 0; v != ant_path.path.size() - 1; ++v)
-          local_pheromone_update[ant_path.path[v]][ant_path.path[v + 1]] +=
-              kQ_ / ant_path.distance;
+bool AntColony::RunIteration(const TsmOptions &options,
+                             std::chrono::steady_clock::time_point start) {
+  Trace::Scope trace("AntColony::RunIteration", "iteration",
+                     static_cast<std::int64_t>(iteration_));
+  const std::size_t kVertexesCount = graph_.size();
+  PheromoneMatrix local_pheromone_update(kVertexesCount,
+                                        pheromone_.Symmetric(), 0.0);
+  CreateAnts();
+  S21_STATS_MEMORY(2 * sizeof(double) * pheromone_.Cells().size() +
+                   2 * sizeof(int) * kVertexesCount * (kVertexesCount + 1));
+
+  for (auto &ant : ants_) {
+    // Прерывание между муравьями, чтобы не ждать конца итерации.
+    if (IsInterrupted(options, Elapsed(start))) return false;
+    {
+      S21_STATS_PHASE("construction");
+      while (ant.can_continue)
+        ant.MakeChoice(graph_, pheromone_, params_, generator_);
+    }
+    if (local_search_ && options.local_search == LocalSearchMode::kEveryAnt &&
+        ant.ant_result.path.size() == kVertexesCount + 1) {
+      S21_STATS_PHASE("local search");
+      local_search_->Improve(ant.ant_result);
+    }
+  }
+
+  if (local_search_ &&
+      options.local_search == LocalSearchMode::kIterationBest) {
+    Ant *iteration_best = nullptr;
+    for (auto &ant : ants_)
+      if (ant.ant_result.path.size() == kVertexesCount + 1 &&
+          (!iteration_best ||
+           ant.ant_result.distance < iteration_best->ant_result.distance))
+        iteration_best = &ant;
+    if (iteration_best) {
+      S21_STATS_PHASE("local search");
+      local_search_->Improve(iteration_best->ant_result);
+    }
+  }
+
+  S21_STATS_PHASE("pheromone update");
+  bool improved = false;
+  for (auto &ant : ants_) {
+    auto ant_path = ant.ant_result;
+    if (ant_path.path.size() == kVertexesCount + 1) {
+      if (best_.distance > ant.ant_result.distance) {
+        best_ = std::move(ant.ant_result);
+        improved = true;
       }
+
+      for (std::size_t v = 0; v != ant_path.path.size() - 1; ++v)
+        local_pheromone_update(ant_path.path[v], ant_path.path[v + 1]) +=
+            kQ_ / ant_path.distance;
+      S21_STATS_ADD(pheromone_updates, ant_path.path.size() - 1);
+    }
+  }
+
+  UpdateGlobalPheromone(local_pheromone_update);
+  ++iteration_;
+  stall_ = improved ? 0 : stall_ + 1;
+  S21_STATS_SET(iterations, iteration_);
+  if (improved) S21_STATS_SET(convergence_iteration, iteration_);
+  return true;
+}
+
+void AntColony::SaveCheckpoint(const std::string &filename) const {
+  std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+  if (!file.is_open()) {
+    throw std::runtime_error(
+        "[ [Wrong argument] ] :: Checkpoint was not created\n");
+  }
+  const std::uint32_t kSize = graph_.size();
+  file.write(kCheckpointMagic, sizeof(kCheckpointMagic));
+  WriteValue(file, kCheckpointVersion);
+  WriteValue(file, kSize);
+  WriteValue(file, static_cast<std::uint8_t>(pheromone_.Symmetric()));
+  const VertexPermutation &kOrder = graph_.Permutation();
+  WriteValue(file, static_cast<std::uint32_t>(kOrder.size()));
+  for (int vertex = 0; vertex < kOrder.size(); ++vertex)
+    WriteValue(file, static_cast<std::int32_t>(kOrder.ToOriginal(vertex)));
+  WriteValue(file, GraphFingerprint());
+  WriteValue(file, params_.alpha);
+  WriteValue(file, params_.beta);
+  WriteValue(file, params_.evaporation);
+  WriteValue(file, static_cast<std::uint64_t>(iteration_));
+  WriteValue(file, static_cast<std::uint64_t>(stall_));
+
+  WriteValue(file, best_.distance);
+  WriteValue(file, static_cast<std::uint32_t>(best_.path.size()));
+  for (int vertex : best_.path)
+    WriteValue(file, static_cast<std::int32_t>(vertex));
+
+  file.write(reinterpret_cast<const char *>(pheromone_.Cells().data()),
+             pheromone_.Cells().size() * sizeof(double));
+
+  std::ostringstream generator_state;
+  generator_state << generator_;
+  const std::string kState = generator_state.str();
+  WriteValue(file, static_cast<std::uint32_t>(kState.size()));
+  file.write(kState.data(), kState.size());
+
+  if (!file) {
+    throw std::runtime_error(
+        "[ [File error] ] :: Checkpoint was not written\n");
+  }
+}
+
+bool AntColony::LoadCheckpoint(const std::string &filename) {
+  std::ifstream file(filename, std::ios::binary);
+  if (!file.is_open()) {
+    throw std::runtime_error("[ [Wrong argument] ] :: File not found\n");
+  }
+  char magic[sizeof(kCheckpointMagic)] = {};
+  file.read(magic, sizeof(magic));
+  if (!file || !std::equal(magic, magic + sizeof(magic), kCheckpointMagic)) {
+    throw std::runtime_error("[ [File error] ] :: Not a colony checkpoint\n");
+  }
+  // Версия 1 хранила полную матрицу феромона, версии 1 и 2 - только
+  // исходный порядок вершин.
+  const auto kVersion = ReadValue<std::uint32_t>(file);
+  if (kVersion < 1 || kVersion > kCheckpointVersion) {
+    throw std::runtime_error("[ [File error] ] :: Not a colony checkpoint\n");
+  }
+  const auto kSize = ReadValue<std::uint32_t>(file);
+  if (kSize != static_cast<std::uint32_t>(graph_.size())) {
+    throw std::out_of_range(
+        "[ [File error] ] :: Checkpoint has another number of vertices\n");
+  }
+  const bool kPacked = kVersion != 1 && ReadValue<std::uint8_t>(file) != 0;
+  VertexPermutation order;
+  if (kVersion >= 3) {
+    const auto kOrderSize = ReadValue<std::uint32_t>(file);
+    if (kOrderSize != 0 && kOrderSize != kSize) {
+      throw std::runtime_error("[ [File error] ] :: Damaged checkpoint\n");
     }
-    UpdateGlobalPheromone(local_pheromone_update);
+    std::vector<int> to_original(kOrderSize);
+    for (int &vertex : to_original) vertex = ReadValue<std::int32_t>(file);
+    try {
+      order = VertexPermutation(std::move(to_original));
+    } catch (const std::invalid_argument &) {
+      throw std::runtime_error("[ [File error] ] :: Damaged checkpoint\n");
+    }
+  }
+  const bool kSameGraph = ReadValue<std::uint64_t>(file) == GraphFingerprint();
+  AntColonyParams params = params_;
+  params.alpha = ReadValue<double>(file);
+  params.beta = ReadValue<double>(file);
+  params.evaporation = ReadValue<double>(file);
+  const auto kIteration = ReadValue<std::uint64_t>(file);
+  const auto kStall = ReadValue<std::uint64_t>(file);
+
+  TsmResult best;
+  best.distance = ReadValue<double>(file);
+  const auto kPathSize = ReadValue<std::uint32_t>(file);
+  if (kPathSize > kSize + 1) {
+    throw std::runtime_error("[ [File error] ] :: Damaged checkpoint\n");
+  }
+  for (std::uint32_t i = 0; i != kPathSize; ++i) {
+    const auto kVertex = ReadValue<std::int32_t>(file);
+    if (kVertex < 0 || kVertex >= static_cast<std::int32_t>(kSize)) {
+      throw std::runtime_error("[ [File error] ] :: Damaged checkpoint\n");
+    }
+    best.path.push_back(kVertex);
+  }
+
+  PheromoneMatrix pheromone(kSize, kPacked, 0);
+  file.read(reinterpret_cast<char *>(pheromone.Cells().data()),
+            pheromone.Cells().size() * sizeof(double));
+  const auto kStateSize = ReadValue<std::uint32_t>(file);
+  if (kStateSize > kMaxGeneratorState) {
+    throw std::runtime_error("[ [File error] ] :: Damaged checkpoint\n");
+  }
+  std::string state(kStateSize, '\0');
+  file.read(&state[0], state.size());
+  if (!file) {
+    throw std::runtime_error("[ [File error] ] :: Damaged checkpoint\n");
+  }
+
+  // Номера вершин точки переводятся в порядок текущего графа.
+  if (!(order == graph_.Permutation())) {
+    const VertexPermutation &kCurrent = graph_.Permutation();
+    std::vector<int> numbers(kSize);
+    for (std::uint32_t vertex = 0; vertex != kSize; ++vertex) {
+      numbers[vertex] = kCurrent.ToInternal(order.ToOriginal(vertex));
+    }
+    pheromone = pheromone.Renumbered(numbers);
+    for (int &vertex : best.path) vertex = numbers[vertex];
+  }
+
+  // Феромон накоплен с параметрами точки, и продолжение идёт с ними же.
+  params_.alpha = params.alpha;
+  params_.beta = params.beta;
+  params_.evaporation = params.evaporation;
+  // Схема феромона следует за графом, а не за контрольной точкой.
+  pheromone_ = pheromone.Symmetric() == pheromone_.Symmetric()
+                   ? std::move(pheromone)
+                   : pheromone.Reshaped(pheromone_.Symmetric());
+  if (kSameGraph) {
+    std::istringstream generator_state(state);
+    generator_state >> generator_;
+    best_ = std::move(best);
+    iteration_ = kIteration;
+    stall_ = kStall;
+    return true;
   }
-  return path;
+
+  // Веса рёбер изменились: пересчитываем длину старого лучшего тура.
+  best_ = TsmResult();
+  best_.distance = std::numeric_limits<double>::max();
+  iteration_ = 0;
+  stall_ = 0;
+  if (!best.path.empty()) {
+    TsmResult tour;
+    tour.path = std::move(best.path);
+    bool valid = true;
+    for (std::size_t v = 0; valid && v + 1 < tour.path.size(); ++v) {
+      const int kEdge = graph_[tour.path[v]][tour.path[v + 1]];
+      valid = kEdge != 0;
+      tour.distance += kEdge;
+    }
+    if (valid) {
+      if (local_search_) local_search_->Improve(tour);
+      best_ = std::move(tour);
+    }
+  }
+  return false;
+}
+
+/**
+ * Calculates the FNV-1a hash of the adjacency matrix in the original vertex
+ * numbering, used to tell whether a checkpoint was made for the same graph
+ * whatever order its vertices are stored in.
+ *
+ * @return the hash of the graph
+ */
+std::uint64_t AntColony::GraphFingerprint() const {
+  const VertexPermutation &kOrder = graph_.Permutation();
+  std::uint64_t hash = 14695981039346656037ull;
+  for (int row = 0; row != graph_.size(); ++row) {
+    const std::vector<int> &kRow = graph_[kOrder.ToInternal(row)];
+    for (int col = 0; col != graph_.size(); ++col) {
+      hash ^= static_cast<std::uint32_t>(kRow[kOrder.ToInternal(col)]);
+      hash *= 1099511628211ull;
+    }
+  }
+  return hash;
+}
+
+bool AntColony::AcceptTour(const TsmResult &tour) {
+  if (tour.path.empty() || tour.distance >= best_.distance) return false;
+  SeedPheromone(tour);
+  best_ = tour;
+  return true;
 }
 
 }  // namespace s21
\ No newline at end of file
@@ -1,10 +1,20 @@
 #ifndef SRC_MODEL_S21_ANT_ALGORITHM_H_
 #define SRC_MODEL_S21_ANT_ALGORITHM_H_
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
 #include <limits>
+#include <memory>
+#include <random>
+#include <string>
 #include <vector>
 
 #include "s21_graph.h"
+#include "s21_local_search.h"
+#include "s21_packed_matrix.h"
+#include "s21_tour_construction.h"
 
 namespace s21 {
 
@@ -15,14 +25,181 @@ const int kInf = std::numeric_limits<int>::max();
 
 struct TsmResult {
   std::vector<int> path;
-  double distance;
+  double distance = 0;
+};
+
+/**
+ * Cooperative cancellation flag shared between a running solver and the code
+ * that wants to stop it. Copies of the token refer to the same flag.
+ */
+class CancellationToken {
+ public:
+  CancellationToken() : cancelled_(std::make_shared<std::atomic<bool>>()) {}
+
+  void Cancel() const { cancelled_->store(true); }
+  bool IsCancelled() const { return cancelled_->load(); }
+
+ private:
+  std::shared_ptr<std::atomic<bool>> cancelled_;
+};
+
+struct TsmProgress {
+  std::size_t iteration = 0;
+  std::chrono::milliseconds elapsed{0};
+  TsmResult best;
+};
+
+/**
+ * Which Traveling Salesman solver to use. kAuto picks the exact Held-Karp
+ * solver for small graphs and the ant colony otherwise.
+ */
+enum class TsmSolver { kAuto, kAntColony, kHeldKarp, kIslands };
+
+/**
+ * Parameters of one ant colony.
+ *
+ * @field alpha weight of the pheromone level in the choice of the next vertex
+ * @field beta weight of the inverse edge length in the choice of the next
+ * vertex
+ * @field evaporation share of the pheromone evaporating every iteration
+ * @field seed seed of the random generator, zero means a random seed
+ */
+struct AntColonyParams {
+  double alpha = kAlpha_;
+  double beta = kBeta_;
+  double evaporation = 0.1;
+  unsigned seed = 0;
+};
+
+/**
+ * Settings of the island model: independent colonies running on separate
+ * threads and exchanging their best tours every migration_interval
+ * iterations.
+ *
+ * @field count number of islands, zero means one island per core
+ * @field migration_interval iterations between two migrations
+ * @field share_pheromone also mix the pheromone matrix of the neighbour island
+ * @field pheromone_share share of the neighbour pheromone in the mix
+ * @field params per-island colony parameters; when empty the islands get
+ * different alpha, beta and evaporation around the defaults
+ */
+struct IslandOptions {
+  std::size_t count = 0;
+  std::size_t migration_interval = 50;
+  bool share_pheromone = false;
+  double pheromone_share = 0.1;
+  std::vector<AntColonyParams> params;
+};
+
+/**
+ * Limits of an anytime Traveling Salesman run. The solver stops at whichever
+ * limit is reached first and returns the best tour found so far.
+ *
+ * @field time_budget wall-clock budget, zero means unlimited
+ * @field max_iterations iteration cap, zero means unlimited
+ * @field stall_limit number of consecutive iterations without improvement
+ * @field cancellation token checked between ants
+ * @field on_progress called every time the best tour improves
+ * @field local_search which tours are improved by 2-opt and Or-opt before the
+ * pheromone deposit
+ * @field initial_tour construction heuristic whose tour seeds the pheromone
+ * matrix and the best-so-far tour of the ant colony
+ * @field solver explicit choice of the solver instead of the automatic one
+ * @field colony parameters of the single ant colony
+ * @field islands settings of the island model solver
+ * @field checkpoint_path file the ant colony state is saved to at the end of
+ * the run and every checkpoint_interval iterations, empty means no saving;
+ * the island model saves its best island, the Held-Karp solver takes no
+ * checkpoints
+ * @field checkpoint_interval iterations between checkpoints, zero means only
+ * at the end of the run
+ * @field resume_from checkpoint to continue from instead of building the
+ * initial tour; a checkpoint of a slightly changed graph of the same size
+ * warm-starts the run. The first island of the island model continues the
+ * checkpoint, the others start from its pheromone and best tour with their
+ * own random generators
+ */
+struct TsmOptions {
+  static constexpr std::size_t kDefaultStallLimit = 2000;
+
+  std::chrono::milliseconds time_budget{0};
+  std::size_t max_iterations = 0;
+  std::size_t stall_limit = kDefaultStallLimit;
+  CancellationToken cancellation;
+  std::function<void(const TsmProgress &)> on_progress;
+  LocalSearchMode local_search = LocalSearchMode::kIterationBest;
+  InitialTour initial_tour = InitialTour::kBest;
+  TsmSolver solver = TsmSolver::kAuto;
+  AntColonyParams colony;
+  IslandOptions islands;
+  std::string checkpoint_path;
+  std::size_t checkpoint_interval = 0;
+  std::string resume_from;
+};
+
+/**
+ * The pheromone levels of the arcs. On an undirected graph an edge and its
+ * reverse share one level, kept once in a packed upper triangle, so the
+ * colony reads and updates half as many cells; on a directed graph every arc
+ * has its own level in a full row-major array.
+ */
+class PheromoneMatrix {
+ public:
+  PheromoneMatrix() = default;
+  PheromoneMatrix(int size, bool symmetric, double level);
+
+  int size() const { return size_; }
+  bool Symmetric() const { return symmetric_; }
+
+  double &operator()(int from, int to) { return cells_[Index(from, to)]; }
+  const double &operator()(int from, int to) const {
+    return cells_[Index(from, to)];
+  }
+
+  std::vector<double> &Cells() { return cells_; }
+  const std::vector<double> &Cells() const { return cells_; }
+
+  /**
+   * Copies the levels into the other layout. A full matrix is packed with the
+   * mean level of the two directions of every edge.
+   *
+   * @param symmetric the layout of the copy
+   *
+   * @return the copy
+   */
+  PheromoneMatrix Reshaped(bool symmetric) const;
+
+  /**
+   * Moves the level of every arc to other vertex numbers.
+   *
+   * @param numbers the new number of every vertex
+   *
+   * @return the renumbered copy
+   */
+  PheromoneMatrix Renumbered(const std::vector<int> &numbers) const;
+
+  bool operator==(const PheromoneMatrix &other) const {
+    return size_ == other.size_ && symmetric_ == other.symmetric_ &&
+           cells_ == other.cells_;
+  }
+
+ private:
+  std::size_t Index(int from, int to) const {
+    if (symmetric_) return PackedSymmetricMatrix<double>::Index(size_, from, to);
+    return static_cast<std::size_t>(from) * size_ + to;
+  }
+
+  int size_ = 0;
+  bool symmetric_ = false;
+  std::vector<double> cells_;
 };
 
 struct Ant {
   explicit Ant(int start_vertex = 0)
       : start_location(start_vertex), current_location(start_vertex){};
-  void MakeChoice(const Graph &graph, const matrixAntd &phero_lvl);
-  double getRandomChoice();
+  void MakeChoice(const Graph &graph, const PheromoneMatrix &phero_lvl,
+                  const AntColonyParams &params, std::mt19937 &generator);
+  double getRandomChoice(std::mt19937 &generator);
   std::vector<int> getNeighborVertexes(const Graph &graph);
 
   bool can_continue = true;
@@ -34,23 +211,116 @@ struct Ant {
 
 class AntColony {
  public:
-  explicit AntColony(const Graph &graph);
+  explicit AntColony(const Graph &graph,
+                     const AntColonyParams &params = AntColonyParams());
+
+  /**
+   * Runs the colony until one of the limits from options is reached.
+   *
+   * @param options time budget, iteration and stall limits, cancellation
+   * token and progress callback
+   *
+   * @return the best tour found, or an empty path with the maximal distance
+   * if no ant completed a tour
+   */
+  TsmResult SolveSalesmansProblem(const TsmOptions &options = TsmOptions());
+
+  /**
+   * Resets the run state and builds the initial tour for a step-by-step run.
+   *
+   * @param options local search and initial tour settings of the run
+   */
+  void Prepare(const TsmOptions &options);
+
+  /**
+   * Runs one iteration: all ants build their tours, the local search is
+   * applied and the pheromone is updated.
+   *
+   * @param options local search setting, cancellation token and time budget
+   * @param start the moment the run started, for the time budget
+   *
+   * @return false if the iteration was interrupted and discarded
+   */
+  bool RunIteration(const TsmOptions &options,
+                    std::chrono::steady_clock::time_point start);
+
+  /**
+   * Takes a tour found by another colony. A tour shorter than the own best
+   * one becomes the best tour and its edges get pheromone.
+   *
+   * @param tour the tour to take
+   *
+   * @return true if the tour was shorter than the own best one
+   */
+  bool AcceptTour(const TsmResult &tour);
+
+  /**
+   * Mixes another pheromone matrix of the same size into the own one.
+   *
+   * @param other the pheromone matrix of another colony of the same graph
+   * @param share the weight of the other matrix, from 0 to 1
+   */
+  void BlendPheromone(const PheromoneMatrix &other, double share);
+
+  /**
+   * Saves the pheromone matrix, the best tour, the iteration and stall
+   * counters and the random generator state to a binary checkpoint, together
+   * with the vertex order of the graph they are numbered in.
+   *
+   * @param filename the name of the checkpoint file
+   *
+   * @throws std::runtime_error if the file cannot be written
+   */
+  void SaveCheckpoint(const std::string &filename) const;
+
+  /**
+   * Restores the colony from a checkpoint. The colony takes alpha, beta and
+   * evaporation of the checkpoint, the pheromone was deposited with them. If
+   * the checkpoint was made for the same graph, the run continues exactly
+   * where it stopped. If only the edge weights differ, the pheromone matrix
+   * is reused as a warm start, the best tour is re-evaluated on the current
+   * weights and the counters start from zero. A checkpoint saved under
+   * another vertex order of the graph is renumbered into the current one.
+   *
+   * @param filename the name of the checkpoint file
+   *
+   * @return true if the run was resumed exactly, false for a warm start
+   *
+   * @throws std::runtime_error if the file cannot be opened or is damaged
+   * @throws std::out_of_range if the checkpoint has another number of vertices
+   */
+  bool LoadCheckpoint(const std::string &filename);
+
+  const TsmResult &Best() const { return best_; }
+  const AntColonyParams &Params() const { return params_; }
+  const PheromoneMatrix &Pheromone() const { return pheromone_; }
+  std::size_t Iteration() const { return iteration_; }
+  std::size_t Stall() const { return stall_; }
 
-  TsmResult SolveSalesmansProblem();
+  static bool IsInterrupted(const TsmOptions &options,
+                            std::chrono::milliseconds elapsed);
+  static bool ShouldStop(const TsmOptions &options, std::size_t iteration,
+                         std::size_t stall, std::chrono::milliseconds elapsed);
 
  private:
   const int kNumAnts = 100;
-  const int kNumIterations = 2000;
   const double kPheromone0_ = 1;
   const double kQ_ = 100.0;
-  const double kInitialPheromone = 0.1;
 
   void CreateAnts();
-  void UpdateGlobalPheromone(const matrixAntd &local_pheromone_update);
+  void UpdateGlobalPheromone(const PheromoneMatrix &local_pheromone_update);
+  void SeedPheromone(const TsmResult &tour);
+  std::uint64_t GraphFingerprint() const;
 
   Graph graph_;
+  AntColonyParams params_;
+  std::mt19937 generator_;
   std::vector<Ant> ants_;
-  matrixAntd pheromone_;
+  PheromoneMatrix pheromone_;
+  std::unique_ptr<LocalSearch> local_search_;
+  TsmResult best_;
+  std::size_t iteration_ = 0;
+  std::size_t stall_ = 0;
 };
 
 }  // namespace s21
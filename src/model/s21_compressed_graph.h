@@ -0,0 +1,107 @@
+#ifndef SRC_MODEL_S21_COMPRESSED_GRAPH_H_
+#define SRC_MODEL_S21_COMPRESSED_GRAPH_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "s21_graph_view.h"
+#include "s21_vertex_order.h"
+
+namespace s21 {
+
+/**
+ * A graph stored as compressed sparse rows: the edges of every vertex lie
+ * together in one array, so the algorithms touch only existing edges. It
+ * takes O(V + E) memory and is a sparse graph view: there is no access to an
+ * arbitrary pair of vertices, and ViewAlgorithms use heaps instead of the
+ * O(V^2) scans of the adjacency matrix. Reorder renumbers the vertices so
+ * that the rows of neighbouring vertices lie close; the algorithms keep
+ * speaking the original numbers through Permutation().
+ */
+template <typename Weight>
+class CompressedGraph {
+ public:
+  using WeightType = Weight;
+
+  CompressedGraph() = default;
+
+  /**
+   * Copies the edges and the numbering of another graph view.
+   */
+  template <typename View>
+  explicit CompressedGraph(const View &view) : offsets_(view.size() + 1, 0) {
+    for (int from = 0; from < view.size(); ++from) {
+      view.ForEachNeighbour(from, [this](int to, Weight weight) {
+        targets_.push_back(to);
+        weights_.push_back(weight);
+      });
+      offsets_[from + 1] = targets_.size();
+    }
+    if constexpr (GraphViewTraits<View>::kRenumbered) {
+      permutation_ = view.Permutation();
+    }
+  }
+
+  /**
+   * Renumbers the vertices in the given order, on top of the previous
+   * renumbering, see BasicGraph::Reorder.
+   */
+  void Reorder(VertexOrder order) {
+    const VertexPermutation kStep = ComputeVertexOrder(*this, order);
+    if (kStep.IsIdentity()) return;
+    vector<std::size_t> offsets(offsets_.size(), 0);
+    vector<int> targets;
+    vector<Weight> weights;
+    targets.reserve(targets_.size());
+    weights.reserve(weights_.size());
+    vector<std::pair<int, Weight>> row;
+    for (int vertex = 0; vertex < size(); ++vertex) {
+      row.clear();
+      ForEachNeighbour(kStep.ToOriginal(vertex), [&](int to, Weight weight) {
+        row.emplace_back(kStep.ToInternal(to), weight);
+      });
+      // Соседи остаются упорядоченными по новым номерам.
+      std::sort(row.begin(), row.end());
+      for (const auto &[to, weight] : row) {
+        targets.push_back(to);
+        weights.push_back(weight);
+      }
+      offsets[vertex + 1] = targets.size();
+    }
+    offsets_ = std::move(offsets);
+    targets_ = std::move(targets);
+    weights_ = std::move(weights);
+    permutation_ = permutation_.Then(kStep);
+  }
+
+  const VertexPermutation &Permutation() const { return permutation_; }
+
+  int size() const {
+    return offsets_.empty() ? 0 : static_cast<int>(offsets_.size()) - 1;
+  }
+
+  /**
+   * @return the number of arcs, an undirected edge counts twice
+   */
+  std::size_t ArcCount() const { return targets_.size(); }
+
+  template <typename Visit>
+  void ForEachNeighbour(int vertex, Visit visit) const {
+    for (std::size_t arc = offsets_[vertex]; arc != offsets_[vertex + 1];
+         ++arc) {
+      visit(targets_[arc], weights_[arc]);
+    }
+  }
+
+ private:
+  vector<std::size_t> offsets_;
+  vector<int> targets_;
+  vector<Weight> weights_;
+  VertexPermutation permutation_;
+};
+
+}  // namespace s21
+
+#endif  // SRC_MODEL_S21_COMPRESSED_GRAPH_H_
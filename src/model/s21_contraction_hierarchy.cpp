@@ -0,0 +1,546 @@
+#include "s21_contraction_hierarchy.h"
+
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+
+#include "s21_algorithm_stats.h"
+#include "s21_trace.h"
+
+namespace s21 {
+
+namespace {
+const char kIndexMagic[8] = {'S', '2', '1', 'C', 'H', 'I', 'D', 'X'};
+const std::uint32_t kIndexVersion = 1;
+const long long kInfinity = std::numeric_limits<long long>::max();
+const int kUnreachable = std::numeric_limits<int>::max();
+// Граница поиска свидетелей при оценке приоритета вершины.
+const int kPrioritySettleLimit = 16;
+// Меньше этого числа вершин в раунде потоки не запускаются.
+const std::size_t kParallelThreshold = 64;
+
+using Entry = std::pair<long long, int>;
+using MinHeap = std::priority_queue<Entry, vector<Entry>, std::greater<>>;
+
+template <typename T>
+void WriteValue(std::ostream &stream, const T &value) {
+  stream.write(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+template <typename T>
+T ReadValue(std::istream &stream) {
+  T value{};
+  stream.read(reinterpret_cast<char *>(&value), sizeof(value));
+  if (!stream) {
+    throw std::runtime_error("[ [File error] ] :: Damaged hierarchy index\n");
+  }
+  return value;
+}
+
+std::uint64_t Fingerprint(const Graph &graph) {
+  std::uint64_t hash = 14695981039346656037ull;
+  for (int row = 0; row != graph.size(); ++row) {
+    for (int weight : graph[row]) {
+      hash ^= static_cast<std::uint32_t>(weight);
+      hash *= 1099511628211ull;
+    }
+  }
+  return hash;
+}
+
+/**
+ * Runs work(i) for i from 0 to count, split into blocks between threads.
+ */
+template <typename Work>
+void ParallelFor(std::size_t count, unsigned threads, Work work) {
+  if (threads <= 1 || count < kParallelThreshold) {
+    for (std::size_t i = 0; i != count; ++i) work(i);
+    return;
+  }
+  std::vector<std::thread> workers;
+  const std::size_t kChunk = (count + threads - 1) / threads;
+  for (std::size_t first = 0; first < count; first += kChunk) {
+    const std::size_t kLast = std::min(count, first + kChunk);
+    workers.emplace_back([&work, first, kLast] {
+      for (std::size_t i = first; i != kLast; ++i) work(i);
+    });
+  }
+  for (auto &worker : workers) worker.join();
+}
+
+/**
+ * The graph during contraction: only the arcs between vertices that are not
+ * contracted yet.
+ */
+class Contraction {
+ public:
+  struct Edge {
+    long long weight;
+    int middle;
+  };
+  // Откуда, куда, вес и обходимая вершина.
+  using Shortcut = std::tuple<int, int, long long, int>;
+
+  explicit Contraction(const Graph &graph)
+      : out_(graph.size()),
+        in_(graph.size()),
+        excluded_(graph.size(), false),
+        contracted_neighbours_(graph.size(), 0) {
+    for (int from = 0; from < graph.size(); ++from) {
+      for (int to = 0; to < graph.size(); ++to) {
+        if (from != to && graph[from][to] != 0) {
+          out_[from][to] = {graph[from][to], -1};
+          in_[to][from] = {graph[from][to], -1};
+        }
+      }
+    }
+  }
+
+  /**
+   * Finds the shortcuts that replace the vertex. The vertices marked as
+   * excluded are treated as already contracted.
+   *
+   * @param settle_limit the settle limit of the witness searches; a smaller
+   * one is enough to estimate the priority
+   */
+  vector<Shortcut> Shortcuts(int vertex, int settle_limit) const {
+    thread_local vector<long long> witness;
+    if (witness.size() < out_.size()) witness.resize(out_.size(), kInfinity);
+    vector<Shortcut> shortcuts;
+    for (const auto &[from, in_edge] : in_[vertex]) {
+      long long limit = 0;
+      bool direct = true;
+      for (const auto &[to, out_edge] : out_[vertex]) {
+        if (to == from) continue;
+        const long long kLength = in_edge.weight + out_edge.weight;
+        limit = std::max(limit, kLength);
+        auto existing = out_[from].find(to);
+        if (existing == out_[from].end() || existing->second.weight > kLength)
+          direct = false;
+      }
+      // Прямые дуги не длиннее пути через вершину - поиск не нужен.
+      if (direct) continue;
+      vector<int> touched = WitnessSearch(from, vertex, limit, settle_limit,
+                                          witness);
+      for (const auto &[to, out_edge] : out_[vertex]) {
+        if (to == from) continue;
+        const long long kLength = in_edge.weight + out_edge.weight;
+        if (witness[to] > kLength)
+          shortcuts.emplace_back(from, to, kLength, vertex);
+      }
+      for (int touched_vertex : touched) witness[touched_vertex] = kInfinity;
+    }
+    return shortcuts;
+  }
+
+  /**
+   * The priority of a vertex: the number of shortcuts minus the number of
+   * arcs removed with it, plus the number of contracted neighbours, which
+   * spreads the contraction evenly over the graph.
+   */
+  long long Priority(int vertex) const {
+    return static_cast<long long>(
+               Shortcuts(vertex, kPrioritySettleLimit).size()) -
+           static_cast<long long>(in_[vertex].size() + out_[vertex].size()) +
+           contracted_neighbours_[vertex];
+  }
+
+  vector<int> Neighbours(int vertex) const {
+    vector<int> neighbours;
+    for (const auto &arc : out_[vertex]) neighbours.push_back(arc.first);
+    for (const auto &arc : in_[vertex]) {
+      if (!out_[vertex].count(arc.first)) neighbours.push_back(arc.first);
+    }
+    return neighbours;
+  }
+
+  void Exclude(int vertex, bool excluded) { excluded_[vertex] = excluded; }
+
+  const std::unordered_map<int, Edge> &Out(int vertex) const {
+    return out_[vertex];
+  }
+  const std::unordered_map<int, Edge> &In(int vertex) const {
+    return in_[vertex];
+  }
+
+  void Remove(int vertex) {
+    for (const auto &arc : out_[vertex]) in_[arc.first].erase(vertex);
+    for (const auto &arc : in_[vertex]) out_[arc.first].erase(vertex);
+    for (int neighbour : Neighbours(vertex)) ++contracted_neighbours_[neighbour];
+    out_[vertex].clear();
+    in_[vertex].clear();
+  }
+
+  void Add(const Shortcut &shortcut) {
+    const auto &[from, to, weight, middle] = shortcut;
+    auto existing = out_[from].find(to);
+    if (existing != out_[from].end() && existing->second.weight <= weight)
+      return;
+    out_[from][to] = {weight, middle};
+    in_[to][from] = {weight, middle};
+  }
+
+ private:
+  /**
+   * Dijkstra's algorithm from the vertex that avoids the contracted one and
+   * stops at the length limit or after settle_limit vertices.
+   *
+   * @param distance receives the distances, the maximal value for vertices
+   * not reached
+   *
+   * @return the vertices whose distance was set
+   */
+  vector<int> WitnessSearch(int source, int avoided, long long limit,
+                            int settle_limit,
+                            vector<long long> &distance) const {
+    vector<int> touched = {source};
+    distance[source] = 0;
+    MinHeap heap;
+    heap.emplace(0, source);
+    for (int settled = 0; !heap.empty() && settled < settle_limit;) {
+      auto [length, vertex] = heap.top();
+      heap.pop();
+      if (length > distance[vertex]) continue;
+      if (length > limit) break;
+      ++settled;
+      for (const auto &[next, edge] : out_[vertex]) {
+        if (next == avoided || excluded_[next]) continue;
+        if (length + edge.weight < distance[next]) {
+          if (distance[next] == kInfinity) touched.push_back(next);
+          distance[next] = length + edge.weight;
+          heap.emplace(length + edge.weight, next);
+        }
+      }
+    }
+    return touched;
+  }
+
+  vector<std::unordered_map<int, Edge>> out_;
+  vector<std::unordered_map<int, Edge>> in_;
+  vector<bool> excluded_;
+  vector<int> contracted_neighbours_;
+};
+
+/**
+ * Per-thread state of the queries. The arrays keep the maximal distance
+ * between queries, only the touched entries are reset.
+ */
+struct QueryScratch {
+  vector<long long> distance[2];
+  vector<int> parent[2];
+  vector<int> touched;
+
+  void Prepare(int size) {
+    for (int side = 0; side < 2; ++side) {
+      if (static_cast<int>(distance[side].size()) < size) {
+        distance[side].resize(size, kInfinity);
+        parent[side].resize(size, -1);
+      }
+    }
+  }
+
+  void Reset() {
+    for (int vertex : touched) {
+      for (int side = 0; side < 2; ++side) {
+        distance[side][vertex] = kInfinity;
+        parent[side][vertex] = -1;
+      }
+    }
+    touched.clear();
+  }
+};
+}  // namespace
+
+ContractionHierarchy::ContractionHierarchy(const Graph &graph,
+                                           unsigned threads)
+    : rank_(graph.size(), -1),
+      upward_(graph.size()),
+      downward_(graph.size()),
+      fingerprint_(Fingerprint(graph)) {
+  S21_STATS_SCOPE("ContractionHierarchy");
+  Trace::Scope trace("ContractionHierarchy::ContractionHierarchy", "V",
+                     graph.size(), "E", graph.Properties().edge_count);
+  if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+
+  Contraction contraction(graph);
+  vector<long long> priority(graph.size(), 0);
+  vector<int> remaining(graph.size());
+  for (int vertex = 0; vertex < graph.size(); ++vertex) remaining[vertex] = vertex;
+  vector<int> dirty = remaining;
+  vector<bool> is_dirty(graph.size(), false);
+  int next_rank = 0;
+
+  while (!remaining.empty()) {
+    S21_STATS_ADD(iterations, 1);
+    {
+      S21_STATS_PHASE("ordering");
+      ParallelFor(dirty.size(), threads, [&](std::size_t i) {
+        priority[dirty[i]] = contraction.Priority(dirty[i]);
+      });
+    }
+
+    // Вершины, которые важнее всех соседей, не соседствуют друг с другом и
+    // сжимаются одновременно.
+    vector<int> batch;
+    vector<int> rest;
+    for (int vertex : remaining) {
+      bool smallest = true;
+      for (int neighbour : contraction.Neighbours(vertex)) {
+        if (std::tie(priority[neighbour], neighbour) <
+            std::tie(priority[vertex], vertex)) {
+          smallest = false;
+          break;
+        }
+      }
+      (smallest ? batch : rest).push_back(vertex);
+    }
+
+    vector<vector<Contraction::Shortcut>> shortcuts(batch.size());
+    {
+      S21_STATS_PHASE("contraction");
+      for (int vertex : batch) contraction.Exclude(vertex, true);
+      ParallelFor(batch.size(), threads, [&](std::size_t i) {
+        shortcuts[i] = contraction.Shortcuts(
+            batch[i], ContractionHierarchy::kWitnessSettleLimit);
+      });
+    }
+
+    dirty.clear();
+    for (int vertex : batch) {
+      rank_[vertex] = next_rank++;
+      for (const auto &[to, edge] : contraction.Out(vertex))
+        upward_[vertex].push_back({to, edge.weight, edge.middle});
+      for (const auto &[from, edge] : contraction.In(vertex))
+        downward_[vertex].push_back({from, edge.weight, edge.middle});
+      for (int neighbour : contraction.Neighbours(vertex)) {
+        if (!is_dirty[neighbour]) {
+          is_dirty[neighbour] = true;
+          dirty.push_back(neighbour);
+        }
+      }
+      contraction.Remove(vertex);
+      S21_STATS_ADD(vertices_popped, 1);
+    }
+    for (const auto &vertex_shortcuts : shortcuts) {
+      for (const auto &shortcut : vertex_shortcuts) contraction.Add(shortcut);
+      S21_STATS_ADD(edges_relaxed, vertex_shortcuts.size());
+    }
+    for (int vertex : dirty) is_dirty[vertex] = false;
+    remaining = std::move(rest);
+  }
+
+  for (int vertex = 0; vertex < graph.size(); ++vertex) {
+    for (const Arc &arc : upward_[vertex]) shortcuts_ += arc.middle >= 0;
+    for (const Arc &arc : downward_[vertex]) shortcuts_ += arc.middle >= 0;
+  }
+}
+
+ContractionHierarchy ContractionHierarchy::Load(const string &filename,
+                                                const Graph &graph) {
+  std::ifstream file(filename, std::ios::binary);
+  if (!file.is_open()) {
+    throw std::runtime_error("[ [Wrong argument] ] :: File not found\n");
+  }
+  char magic[sizeof(kIndexMagic)] = {};
+  file.read(magic, sizeof(magic));
+  if (!file || !std::equal(magic, magic + sizeof(magic), kIndexMagic) ||
+      ReadValue<std::uint32_t>(file) != kIndexVersion) {
+    throw std::runtime_error("[ [File error] ] :: Not a hierarchy index\n");
+  }
+  const auto kSize = ReadValue<std::uint32_t>(file);
+  if (kSize != static_cast<std::uint32_t>(graph.size()) ||
+      ReadValue<std::uint64_t>(file) != Fingerprint(graph)) {
+    throw std::out_of_range(
+        "[ [File error] ] :: Hierarchy index was built for another graph\n");
+  }
+
+  ContractionHierarchy hierarchy;
+  hierarchy.fingerprint_ = Fingerprint(graph);
+  hierarchy.rank_.resize(kSize);
+  hierarchy.upward_.resize(kSize);
+  hierarchy.downward_.resize(kSize);
+  for (std::uint32_t vertex = 0; vertex != kSize; ++vertex) {
+    hierarchy.rank_[vertex] = ReadValue<std::int32_t>(file);
+  }
+  for (auto *arcs : {&hierarchy.upward_, &hierarchy.downward_}) {
+    for (std::uint32_t vertex = 0; vertex != kSize; ++vertex) {
+      const auto kCount = ReadValue<std::uint32_t>(file);
+      if (kCount >= kSize) {
+        throw std::runtime_error(
+            "[ [File error] ] :: Damaged hierarchy index\n");
+      }
+      for (std::uint32_t i = 0; i != kCount; ++i) {
+        Arc arc;
+        arc.vertex = ReadValue<std::int32_t>(file);
+        arc.weight = ReadValue<std::int64_t>(file);
+        arc.middle = ReadValue<std::int32_t>(file);
+        if (arc.vertex < 0 || arc.vertex >= static_cast<int>(kSize) ||
+            arc.middle < -1 || arc.middle >= static_cast<int>(kSize) ||
+            arc.weight <= 0) {
+          throw std::runtime_error(
+              "[ [File error] ] :: Damaged hierarchy index\n");
+        }
+        hierarchy.shortcuts_ += arc.middle >= 0;
+        (*arcs)[vertex].push_back(arc);
+      }
+    }
+  }
+  return hierarchy;
+}
+
+void ContractionHierarchy::Save(const string &filename) const {
+  std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+  if (!file.is_open()) {
+    throw std::runtime_error(
+        "[ [Wrong argument] ] :: Hierarchy index was not created\n");
+  }
+  file.write(kIndexMagic, sizeof(kIndexMagic));
+  WriteValue(file, kIndexVersion);
+  WriteValue(file, static_cast<std::uint32_t>(size()));
+  WriteValue(file, fingerprint_);
+  for (int rank : rank_) WriteValue(file, static_cast<std::int32_t>(rank));
+  for (const auto *arcs : {&upward_, &downward_}) {
+    for (const auto &vertex_arcs : *arcs) {
+      WriteValue(file, static_cast<std::uint32_t>(vertex_arcs.size()));
+      for (const Arc &arc : vertex_arcs) {
+        WriteValue(file, static_cast<std::int32_t>(arc.vertex));
+        WriteValue(file, static_cast<std::int64_t>(arc.weight));
+        WriteValue(file, static_cast<std::int32_t>(arc.middle));
+      }
+    }
+  }
+  if (!file) {
+    throw std::runtime_error(
+        "[ [File error] ] :: Hierarchy index was not written\n");
+  }
+}
+
+int ContractionHierarchy::Distance(int vertex1, int vertex2) const {
+  CheckVertices(vertex1, vertex2);
+  S21_STATS_SCOPE("ContractionHierarchyQuery");
+  const long long kLength = Search(vertex1 - 1, vertex2 - 1, nullptr);
+  return kLength >= kUnreachable ? kUnreachable : static_cast<int>(kLength);
+}
+
+vector<int> ContractionHierarchy::Path(int vertex1, int vertex2) const {
+  CheckVertices(vertex1, vertex2);
+  S21_STATS_SCOPE("ContractionHierarchyQuery");
+  vector<int> packed;
+  if (Search(vertex1 - 1, vertex2 - 1, &packed) == kInfinity) return {};
+  vector<int> path = {packed.front() + 1};
+  for (std::size_t i = 0; i + 1 < packed.size(); ++i) {
+    Unpack(packed[i], packed[i + 1], path);
+  }
+  return path;
+}
+
+/**
+ * Runs the upward searches from both ends. The shortest path goes through
+ * the vertex of the highest rank on it, which both searches settle; a side
+ * stops when its smallest key is not below the best path.
+ *
+ * @param path receives the vertices of the path in the hierarchy, if set
+ */
+long long ContractionHierarchy::Search(int source, int target,
+                                       vector<int> *path) const {
+  thread_local QueryScratch scratch;
+  scratch.Prepare(size());
+  auto &distance = scratch.distance;
+  auto &parent = scratch.parent;
+
+  MinHeap heap[2];
+  distance[0][source] = 0;
+  distance[1][target] = 0;
+  scratch.touched.push_back(source);
+  scratch.touched.push_back(target);
+  heap[0].emplace(0, source);
+  heap[1].emplace(0, target);
+  long long best = source == target ? 0 : kInfinity;
+  int meeting = source == target ? source : -1;
+
+  while (!heap[0].empty() || !heap[1].empty()) {
+    for (int side = 0; side < 2; ++side) {
+      if (heap[side].empty()) continue;
+      auto [length, vertex] = heap[side].top();
+      heap[side].pop();
+      if (length >= best) {
+        // Дальше эта сторона не улучшит ответ.
+        heap[side] = MinHeap();
+        continue;
+      }
+      if (length > distance[side][vertex]) continue;
+      S21_STATS_ADD(vertices_popped, 1);
+      if (distance[1 - side][vertex] != kInfinity &&
+          length + distance[1 - side][vertex] < best) {
+        best = length + distance[1 - side][vertex];
+        meeting = vertex;
+      }
+      for (const Arc &arc : side == 0 ? upward_[vertex] : downward_[vertex]) {
+        S21_STATS_ADD(edges_scanned, 1);
+        if (length + arc.weight < distance[side][arc.vertex]) {
+          if (distance[0][arc.vertex] == kInfinity &&
+              distance[1][arc.vertex] == kInfinity) {
+            scratch.touched.push_back(arc.vertex);
+          }
+          distance[side][arc.vertex] = length + arc.weight;
+          parent[side][arc.vertex] = vertex;
+          heap[side].emplace(length + arc.weight, arc.vertex);
+          S21_STATS_ADD(edges_relaxed, 1);
+        }
+      }
+    }
+  }
+
+  if (path && meeting >= 0) {
+    for (int vertex = meeting; vertex != -1; vertex = parent[0][vertex])
+      path->push_back(vertex);
+    std::reverse(path->begin(), path->end());
+    for (int vertex = parent[1][meeting]; vertex != -1;
+         vertex = parent[1][vertex])
+      path->push_back(vertex);
+  }
+  scratch.Reset();
+  return best;
+}
+
+const ContractionHierarchy::Arc &ContractionHierarchy::FindArc(int from,
+                                                               int to) const {
+  // Дуга хранится у младшей из двух вершин.
+  if (rank_[from] < rank_[to]) {
+    for (const Arc &arc : upward_[from])
+      if (arc.vertex == to) return arc;
+  } else {
+    for (const Arc &arc : downward_[to])
+      if (arc.vertex == from) return arc;
+  }
+  throw std::logic_error("[ [Internal error] ] :: Missing hierarchy arc\n");
+}
+
+/**
+ * Appends the edges of the graph that the arc stands for, without its start.
+ */
+void ContractionHierarchy::Unpack(int from, int to, vector<int> &path) const {
+  const int kMiddle = FindArc(from, to).middle;
+  if (kMiddle < 0) {
+    path.push_back(to + 1);
+    return;
+  }
+  Unpack(from, kMiddle, path);
+  Unpack(kMiddle, to, path);
+}
+
+void ContractionHierarchy::CheckVertices(int vertex1, int vertex2) const {
+  if (vertex1 < 1 || vertex1 > size() || vertex2 < 1 || vertex2 > size()) {
+    throw std::invalid_argument(
+        "[ [Wrong argument] ] :: Graph or start/end vertex is invalid\n");
+  }
+}
+
+}  // namespace s21
@@ -0,0 +1,119 @@
+#ifndef SRC_MODEL_S21_CONTRACTION_HIERARCHY_H_
+#define SRC_MODEL_S21_CONTRACTION_HIERARCHY_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "s21_graph.h"
+
+namespace s21 {
+
+/**
+ * Contraction hierarchy of a static graph. The vertices are contracted one by
+ * one from the least important; a contracted vertex is replaced by shortcuts
+ * between its neighbours unless a witness path of the same length avoids it.
+ * Every shortest path then climbs the order and descends it again, so a query
+ * runs Dijkstra's algorithm upward from both ends and touches only a small
+ * part of the graph.
+ *
+ * The order is built in rounds: the priorities of the vertices whose
+ * neighbourhood changed are recomputed in parallel, and all vertices whose
+ * priority is smaller than that of their neighbours are contracted together.
+ */
+class ContractionHierarchy {
+ public:
+  // Граница числа вершин, извлекаемых поиском свидетеля; если свидетель не
+  // найден, добавляется лишняя, но корректная дуга.
+  static constexpr int kWitnessSettleLimit = 64;
+
+  /**
+   * Builds the hierarchy.
+   *
+   * @param graph the graph, its weights must not be negative
+   * @param threads the number of worker threads, zero means all cores
+   */
+  explicit ContractionHierarchy(const Graph &graph, unsigned threads = 0);
+
+  /**
+   * Reads a hierarchy saved by Save().
+   *
+   * @param filename the name of the index file
+   * @param graph the graph the index was built for
+   *
+   * @throws std::runtime_error if the file cannot be read or is damaged
+   * @throws std::out_of_range if the index was built for another graph
+   */
+  static ContractionHierarchy Load(const string &filename, const Graph &graph);
+
+  /**
+   * Writes the hierarchy to a binary index file.
+   *
+   * @param filename the name of the index file
+   *
+   * @throws std::runtime_error if the file cannot be written
+   */
+  void Save(const string &filename) const;
+
+  /**
+   * Finds the length of the shortest path. The query does not depend on the
+   * number of vertices of the graph and may run in several threads at once.
+   *
+   * @param vertex1 the start vertex, from 1
+   * @param vertex2 the end vertex, from 1
+   *
+   * @return the length of the path, or the maximal int if there is none
+   *
+   * @throws std::invalid_argument if a vertex does not exist
+   */
+  int Distance(int vertex1, int vertex2) const;
+
+  /**
+   * Finds the shortest path with the shortcuts unpacked into edges of the
+   * graph.
+   *
+   * @param vertex1 the start vertex, from 1
+   * @param vertex2 the end vertex, from 1
+   *
+   * @return the vertices of the path from 1, empty if there is none
+   *
+   * @throws std::invalid_argument if a vertex does not exist
+   */
+  vector<int> Path(int vertex1, int vertex2) const;
+
+  int size() const { return static_cast<int>(rank_.size()); }
+
+  /**
+   * @return the number of shortcuts kept in the hierarchy
+   */
+  std::size_t ShortcutCount() const { return shortcuts_; }
+
+ private:
+  /**
+   * An arc to a vertex of a higher rank. A shortcut remembers the contracted
+   * vertex it bypasses, an edge of the graph has middle -1.
+   */
+  struct Arc {
+    int vertex;
+    long long weight;
+    int middle;
+  };
+
+  ContractionHierarchy() = default;
+
+  long long Search(int source, int target, vector<int> *path) const;
+  const Arc &FindArc(int from, int to) const;
+  void Unpack(int from, int to, vector<int> &path) const;
+  void CheckVertices(int vertex1, int vertex2) const;
+
+  vector<int> rank_;
+  // Дуги v -> w и u -> v, где w и u старше v.
+  vector<vector<Arc>> upward_;
+  vector<vector<Arc>> downward_;
+  std::size_t shortcuts_ = 0;
+  std::uint64_t fingerprint_ = 0;
+};
+
+}  // namespace s21
+
+#endif  // SRC_MODEL_S21_CONTRACTION_HIERARCHY_H_
@@ -0,0 +1,221 @@
+#include "s21_distance_oracle.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <random>
+#include <stdexcept>
+#include <utility>
+
+#include "s21_algorithm_stats.h"
+#include "s21_trace.h"
+
+namespace s21 {
+
+namespace {
+const long long kInfinity = std::numeric_limits<long long>::max();
+const int kUnreachable = std::numeric_limits<int>::max();
+
+using Entry = std::pair<long long, int>;
+using MinHeap = std::priority_queue<Entry, vector<Entry>, std::greater<>>;
+using Adjacency = vector<vector<std::pair<int, int>>>;
+
+Adjacency Neighbours(const Graph &graph) {
+  Adjacency adjacency(graph.size());
+  for (int from = 0; from < graph.size(); ++from) {
+    const vector<int> &row = graph[from];
+    for (int to = 0; to < graph.size(); ++to) {
+      if (row[to] != 0 && to != from) adjacency[from].emplace_back(to, row[to]);
+    }
+  }
+  return adjacency;
+}
+
+vector<int> Components(const Adjacency &adjacency) {
+  vector<int> component(adjacency.size(), -1);
+  int count = 0;
+  for (std::size_t start = 0; start != adjacency.size(); ++start) {
+    if (component[start] != -1) continue;
+    vector<int> stack = {static_cast<int>(start)};
+    component[start] = count;
+    while (!stack.empty()) {
+      int vertex = stack.back();
+      stack.pop_back();
+      for (const auto &[next, weight] : adjacency[vertex]) {
+        if (component[next] == -1) {
+          component[next] = count;
+          stack.push_back(next);
+        }
+      }
+    }
+    ++count;
+  }
+  return component;
+}
+
+/**
+ * Chooses the highest level of every vertex so that the last level is not
+ * empty.
+ */
+vector<int> SampleLevels(int size, int levels, unsigned seed) {
+  std::mt19937 generator(seed ? seed : std::random_device()());
+  const double kProbability = std::pow(size, -1.0 / levels);
+  std::bernoulli_distribution promote(kProbability);
+  vector<int> level(size, 0);
+  bool last_empty = size > 0 && levels > 1;
+  while (last_empty) {
+    std::fill(level.begin(), level.end(), 0);
+    for (int vertex = 0; vertex < size; ++vertex) {
+      while (level[vertex] + 1 < levels && promote(generator)) ++level[vertex];
+    }
+    last_empty = std::find(level.begin(), level.end(), levels - 1) ==
+                 level.end();
+  }
+  return level;
+}
+}  // namespace
+
+DistanceOracle::DistanceOracle(const Graph &graph, int levels, unsigned seed) {
+  if (graph.IsDirected() || levels < 1) {
+    throw std::invalid_argument(
+        "[ [Wrong argument] ] :: Distance oracle needs an undirected graph "
+        "and at least one level\n");
+  }
+  S21_STATS_SCOPE("DistanceOracle");
+  Trace::Scope trace("DistanceOracle::DistanceOracle", "V", graph.size(), "E",
+                     graph.Properties().edge_count);
+  const int kSize = graph.size();
+  permutation_ = graph.Permutation();
+  const Adjacency kAdjacency = Neighbours(graph);
+  component_ = Components(kAdjacency);
+  const vector<int> kLevel = SampleLevels(kSize, levels, seed);
+
+  // Ближайшая вершина уровня i: Дейкстра сразу из всех вершин уровня.
+  {
+    S21_STATS_PHASE("pivots");
+    pivot_.assign(levels, vector<int>(kSize, -1));
+    pivot_distance_.assign(levels, vector<long long>(kSize, kInfinity));
+    for (int level = 0; level < levels; ++level) {
+      S21_STATS_ADD(iterations, 1);
+      vector<int> &pivot = pivot_[level];
+      vector<long long> &distance = pivot_distance_[level];
+      MinHeap heap;
+      for (int vertex = 0; vertex < kSize; ++vertex) {
+        if (kLevel[vertex] >= level) {
+          pivot[vertex] = vertex;
+          distance[vertex] = 0;
+          heap.emplace(0, vertex);
+        }
+      }
+      while (!heap.empty()) {
+        auto [length, vertex] = heap.top();
+        heap.pop();
+        if (length != distance[vertex]) continue;
+        S21_STATS_ADD(vertices_popped, 1);
+        for (const auto &[next, weight] : kAdjacency[vertex]) {
+          S21_STATS_ADD(edges_scanned, 1);
+          if (length + weight < distance[next]) {
+            distance[next] = length + weight;
+            pivot[next] = pivot[vertex];
+            heap.emplace(distance[next], next);
+            S21_STATS_ADD(edges_relaxed, 1);
+          }
+        }
+      }
+    }
+  }
+
+  // Кластер вершины w уровня i - вершины, для которых w ближе вершин уровня
+  // i + 1; он связен, поэтому Дейкстра из w не выходит за его границу.
+  S21_STATS_PHASE("bunches");
+  bunch_.assign(kSize, {});
+  vector<long long> distance(kSize, kInfinity);
+  for (int center = 0; center < kSize; ++center) {
+    const int kUpper = kLevel[center] + 1;
+    auto Limit = [&](int vertex) {
+      return kUpper < levels ? pivot_distance_[kUpper][vertex] : kInfinity;
+    };
+    vector<int> touched = {center};
+    MinHeap heap;
+    distance[center] = 0;
+    heap.emplace(0, center);
+    while (!heap.empty()) {
+      auto [length, vertex] = heap.top();
+      heap.pop();
+      if (length != distance[vertex]) continue;
+      S21_STATS_ADD(vertices_popped, 1);
+      bunch_[vertex].emplace(center, length);
+      ++bunch_entries_;
+      for (const auto &[next, weight] : kAdjacency[vertex]) {
+        S21_STATS_ADD(edges_scanned, 1);
+        const long long kLength = length + weight;
+        if (kLength < distance[next] && kLength < Limit(next)) {
+          if (distance[next] == kInfinity) touched.push_back(next);
+          distance[next] = kLength;
+          heap.emplace(kLength, next);
+          S21_STATS_ADD(edges_relaxed, 1);
+        }
+      }
+    }
+    for (int vertex : touched) distance[vertex] = kInfinity;
+  }
+  S21_STATS_MEMORY(bunch_entries_ * (sizeof(int) + sizeof(long long)) +
+                   levels * kSize * (sizeof(int) + sizeof(long long)));
+}
+
+int DistanceOracle::Distance(int vertex1, int vertex2) const {
+  if (vertex1 < 1 || vertex1 > size() || vertex2 < 1 || vertex2 > size()) {
+    throw std::invalid_argument(
+        "[ [Wrong argument] ] :: Graph or start/end vertex is invalid\n");
+  }
+  const long long kEstimate = Estimate(vertex1 - 1, vertex2 - 1);
+  return kEstimate >= kUnreachable ? kUnreachable
+                                   : static_cast<int>(kEstimate);
+}
+
+OracleAccuracy DistanceOracle::Compare(const matrix &exact) const {
+  if (static_cast<int>(exact.size()) != size()) {
+    throw std::invalid_argument(
+        "[ [Wrong argument] ] :: Matrix does not match the oracle\n");
+  }
+  OracleAccuracy accuracy;
+  long long exact_pairs = 0;
+  double stretch_sum = 0;
+  for (int from = 0; from < size(); ++from) {
+    for (int to = 0; to < size(); ++to) {
+      // Точная матрица в исходных номерах, оракул во внутренних.
+      const int kDistance = exact[permutation_.ToOriginal(from)]
+                                 [permutation_.ToOriginal(to)];
+      if (from == to || kDistance == kUnreachable || kDistance == 0) continue;
+      const double kStretch =
+          static_cast<double>(Estimate(from, to)) / kDistance;
+      ++accuracy.pairs;
+      if (kStretch == 1) ++exact_pairs;
+      stretch_sum += kStretch;
+      accuracy.max_stretch = std::max(accuracy.max_stretch, kStretch);
+    }
+  }
+  if (accuracy.pairs) {
+    accuracy.exact = static_cast<double>(exact_pairs) / accuracy.pairs;
+    accuracy.mean_stretch = stretch_sum / accuracy.pairs;
+  }
+  return accuracy;
+}
+
+long long DistanceOracle::Estimate(int from, int to) const {
+  if (component_[from] != component_[to]) return kInfinity;
+  // Опорная вершина уровня 0 - сама вершина; на последнем уровне опорная
+  // вершина входит в окружение любой вершины своей компоненты.
+  int level = 0;
+  auto found = bunch_[to].find(from);
+  while (found == bunch_[to].end()) {
+    ++level;
+    std::swap(from, to);
+    found = bunch_[to].find(pivot_[level][from]);
+  }
+  return pivot_distance_[level][from] + found->second;
+}
+
+}  // namespace s21
@@ -0,0 +1,114 @@
+#ifndef SRC_MODEL_S21_DISTANCE_ORACLE_H_
+#define SRC_MODEL_S21_DISTANCE_ORACLE_H_
+
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+#include "s21_graph.h"
+
+namespace s21 {
+
+/**
+ * Accuracy of approximate distances compared with exact ones. Pairs of equal
+ * vertices and unreachable pairs are not counted.
+ *
+ * @field pairs the number of compared pairs
+ * @field exact the share of pairs whose distance is exact
+ * @field mean_stretch the mean ratio of the estimate to the distance
+ * @field max_stretch the largest ratio of the estimate to the distance
+ */
+struct OracleAccuracy {
+  long long pairs = 0;
+  double exact = 1;
+  double mean_stretch = 1;
+  double max_stretch = 1;
+};
+
+/**
+ * Approximate distance oracle of Thorup and Zwick for undirected graphs. The
+ * vertices are sampled into nested levels A0 = V, A1, ..., A(k-1), each
+ * vertex of a level gets into the next one with probability V^(-1/k). Every
+ * vertex keeps its nearest vertex of each level and the bunch: the vertices w
+ * of level i that are closer than the nearest vertex of level i + 1, with
+ * their distances. A query climbs the levels from both ends until one pivot
+ * lies in the bunch of the other vertex.
+ *
+ * An estimate is never shorter than the distance and at most 2k - 1 times
+ * longer. The oracle keeps about k * V^(1+1/k) distances instead of the V^2
+ * of the matrix of all shortest paths, is built by Dijkstra's algorithm with
+ * the same expected cost and answers in O(k).
+ */
+class DistanceOracle {
+ public:
+  static constexpr int kDefaultLevels = 3;
+
+  /**
+   * Builds the oracle.
+   *
+   * @param graph the undirected graph, its weights must not be negative
+   * @param levels the number of levels k: more levels give a smaller oracle
+   * and a larger error bound
+   * @param seed seed of the sampling, zero means a random seed
+   *
+   * @throws std::invalid_argument if the graph is directed or levels is not
+   * positive
+   */
+  explicit DistanceOracle(const Graph &graph, int levels = kDefaultLevels,
+                          unsigned seed = 0);
+
+  /**
+   * Estimates the distance between two vertices.
+   *
+   * @param vertex1 the first vertex, from 1
+   * @param vertex2 the second vertex, from 1
+   *
+   * @return the estimate, or the maximal int if the vertices are not
+   * connected
+   *
+   * @throws std::invalid_argument if a vertex does not exist
+   */
+  int Distance(int vertex1, int vertex2) const;
+
+  /**
+   * Compares the estimates of all pairs with exact distances.
+   *
+   * @param exact the matrix of GraphAlgorithms::GetShortestPathsBetweenAllVertices
+   * for the same graph, in its original vertex numbers
+   *
+   * @throws std::invalid_argument if the matrix has another size
+   */
+  OracleAccuracy Compare(const matrix &exact) const;
+
+  int size() const { return static_cast<int>(component_.size()); }
+
+  /**
+   * @return the number of levels k
+   */
+  int Levels() const { return static_cast<int>(pivot_.size()); }
+
+  /**
+   * @return the guaranteed bound 2k - 1 of the estimate to the distance
+   */
+  int Stretch() const { return 2 * Levels() - 1; }
+
+  /**
+   * @return the number of distances kept in the bunches
+   */
+  std::size_t BunchEntries() const { return bunch_entries_; }
+
+ private:
+  long long Estimate(int from, int to) const;
+
+  // Ближайшая вершина каждого уровня и расстояние до неё, по уровням.
+  vector<vector<int>> pivot_;
+  vector<vector<long long>> pivot_distance_;
+  vector<std::unordered_map<int, long long>> bunch_;
+  vector<int> component_;
+  VertexPermutation permutation_;
+  std::size_t bunch_entries_ = 0;
+};
+
+}  // namespace s21
+
+#endif  // SRC_MODEL_S21_DISTANCE_ORACLE_H_
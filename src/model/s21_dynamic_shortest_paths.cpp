@@ -0,0 +1,161 @@
+#include "s21_dynamic_shortest_paths.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "s21_algorithm_stats.h"
+#include "s21_graph_algorithms.h"
+#include "s21_trace.h"
+
+namespace s21 {
+
+namespace {
+const int kUnreachable = std::numeric_limits<int>::max();
+
+long long Sum(int first, int second, int third) {
+  if (first == kUnreachable || third == kUnreachable) return kUnreachable;
+  return static_cast<long long>(first) + second + third;
+}
+}  // namespace
+
+DynamicShortestPaths::DynamicShortestPaths(Graph &graph) : graph_(graph) {
+  Recompute();
+}
+
+void DynamicShortestPaths::SetEdge(int from, int to, int weight) {
+  S21_STATS_SCOPE("DynamicShortestPaths");
+  const bool kCurrent = graph_.Version() == version_;
+  if (from < 0 || from >= graph_.size() || to < 0 || to >= graph_.size()) {
+    throw std::out_of_range("[ [Wrong argument] ] :: Vertex does not exist\n");
+  }
+  const int kFrom = graph_.Permutation().ToInternal(from);
+  const int kTo = graph_.Permutation().ToInternal(to);
+  const int kOld = graph_[kFrom][kTo];
+  graph_.SetEdge(from, to, weight);
+  if (!kCurrent) return;  // матрица будет пересчитана целиком в Distances()
+  version_ = graph_.Version();
+  if (kOld == weight) return;
+
+  original_.clear();
+  if (kOld == 0 || (weight != 0 && weight < kOld)) {
+    Decrease(kFrom, kTo, weight);
+  } else {
+    Increase(kFrom, kTo, kOld);
+  }
+}
+
+void DynamicShortestPaths::RemoveEdge(int from, int to) {
+  // Петель нет, но номера вершин проверяет граф.
+  if (from == to) {
+    graph_.RemoveEdge(from, to);
+  } else {
+    SetEdge(from, to, 0);
+  }
+}
+
+const matrix &DynamicShortestPaths::Distances() {
+  if (graph_.Version() != version_) Recompute();
+  if (graph_.Permutation().IsIdentity()) return distance_;
+  if (original_.empty()) {
+    original_ = graph_.Permutation().MatrixToOriginal(distance_);
+  }
+  return original_;
+}
+
+void DynamicShortestPaths::Recompute() {
+  distance_ = graph_.Permutation().MatrixToInternal(
+      GraphAlgorithms::GetShortestPathsBetweenAllVertices(graph_));
+  original_.clear();
+  version_ = graph_.Version();
+}
+
+/**
+ * A shorter edge can only shorten paths that go through it, so every pair is
+ * relaxed once with the path from -> to.
+ */
+void DynamicShortestPaths::Decrease(int from, int to, int weight) {
+  Trace::Scope trace("DynamicShortestPaths::Decrease", "V", graph_.size());
+  const int kSize = graph_.size();
+  const vector<int> &to_row = distance_[to];
+  for (int i = 0; i < kSize; ++i) {
+    const int kToFrom = distance_[i][from];
+    if (kToFrom == kUnreachable) continue;
+    vector<int> &row = distance_[i];
+    for (int j = 0; j < kSize; ++j) {
+      const long long kPath = Sum(kToFrom, weight, to_row[j]);
+      if (kPath < row[j]) {
+        row[j] = static_cast<int>(kPath);
+        S21_STATS_ADD(cells_updated, 1);
+      }
+    }
+  }
+}
+
+/**
+ * A pair (i, j) is affected if the old edge lay on one of its shortest paths.
+ * Only sources whose shortest path to the end of the edge used it can have
+ * affected pairs. For every such source the distance to an affected target is
+ * seeded with the best path that reaches it from an unaffected vertex by one
+ * edge and then improved by Dijkstra's algorithm over the affected targets.
+ */
+void DynamicShortestPaths::Increase(int from, int to, int old_weight) {
+  Trace::Scope trace("DynamicShortestPaths::Increase", "V", graph_.size());
+  const int kSize = graph_.size();
+  repaired_pairs_ = 0;
+
+  // Старые расстояния строки to нужны для всех источников.
+  const vector<int> kFromEnd = distance_[to];
+  vector<int> affected;
+  vector<long long> tentative(kSize);
+  vector<char> in_region(kSize);
+  vector<char> done(kSize);
+
+  for (int i = 0; i < kSize; ++i) {
+    vector<int> &row = distance_[i];
+    if (row[from] == kUnreachable ||
+        Sum(row[from], old_weight, 0) != row[to])
+      continue;
+
+    affected.clear();
+    for (int j = 0; j < kSize; ++j) {
+      in_region[j] = kFromEnd[j] != kUnreachable &&
+                     Sum(row[from], old_weight, kFromEnd[j]) == row[j];
+      if (in_region[j]) affected.push_back(j);
+    }
+    if (affected.empty()) continue;
+    repaired_pairs_ += affected.size();
+
+    for (int j : affected) {
+      long long best = kUnreachable;
+      for (int k = 0; k < kSize; ++k) {
+        const int kEdge = graph_[k][j];
+        if (in_region[k] || kEdge == 0 || row[k] == kUnreachable) continue;
+        best = std::min(best, static_cast<long long>(row[k]) + kEdge);
+      }
+      tentative[j] = best;
+      done[j] = 0;
+    }
+
+    for (std::size_t step = 0; step != affected.size(); ++step) {
+      int next = -1;
+      for (int j : affected)
+        if (!done[j] && (next < 0 || tentative[j] < tentative[next])) next = j;
+      done[next] = 1;
+      if (tentative[next] >= kUnreachable) break;
+      const vector<int> &edges = graph_[next];
+      for (int j : affected) {
+        if (done[j] || edges[j] == 0) continue;
+        tentative[j] = std::min(tentative[j], tentative[next] + edges[j]);
+        S21_STATS_ADD(edges_relaxed, 1);
+      }
+    }
+
+    for (int j : affected) {
+      row[j] = tentative[j] >= kUnreachable ? kUnreachable
+                                            : static_cast<int>(tentative[j]);
+      S21_STATS_ADD(cells_updated, 1);
+    }
+  }
+}
+
+}  // namespace s21
@@ -0,0 +1,89 @@
+#ifndef SRC_MODEL_S21_DYNAMIC_SHORTEST_PATHS_H_
+#define SRC_MODEL_S21_DYNAMIC_SHORTEST_PATHS_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "s21_graph.h"
+
+namespace s21 {
+
+/**
+ * Distance matrix of all pairs of vertices that is kept up to date while
+ * single edges of the graph change. Inserting an edge or decreasing its weight
+ * costs O(V^2). Deleting an edge or increasing its weight recomputes only the
+ * pairs whose shortest path used the edge: for every affected source the
+ * affected targets are seeded from the unaffected ones and finished by
+ * Dijkstra's algorithm restricted to them.
+ *
+ * Changes made to the graph bypassing this object are detected by the graph
+ * version and lead to a full Floyd-Warshall recomputation.
+ *
+ * The vertices are numbered as in Graph::SetEdge. The matrix is kept in the
+ * internal numbering of a reordered graph, where the repairs walk the rows of
+ * the graph, and renumbered once per change when Distances() is read.
+ */
+class DynamicShortestPaths {
+ public:
+  /**
+   * Computes the distance matrix of the graph.
+   *
+   * @param graph the graph, it must outlive this object
+   *
+   * @throws std::invalid_argument if the graph is empty
+   */
+  explicit DynamicShortestPaths(Graph &graph);
+
+  /**
+   * Changes the weight of the edge in the graph and repairs the distances.
+   *
+   * @param from the start vertex, from 0
+   * @param to the end vertex, from 0
+   * @param weight the new weight, 0 deletes the edge
+   *
+   * @throws std::out_of_range if a vertex does not exist
+   * @throws std::invalid_argument if the weight is negative or the edge is a
+   * loop
+   */
+  void SetEdge(int from, int to, int weight);
+
+  /**
+   * Deletes the edge from the graph and repairs the distances.
+   *
+   * @param from the start vertex, from 0
+   * @param to the end vertex, from 0
+   *
+   * @throws std::out_of_range if a vertex does not exist
+   */
+  void RemoveEdge(int from, int to);
+
+  /**
+   * Returns the distances in the format of
+   * GraphAlgorithms::GetShortestPathsBetweenAllVertices, unreachable pairs
+   * hold the maximal int.
+   *
+   * @return the distance matrix
+   */
+  const matrix &Distances();
+
+  /**
+   * @return the number of pairs recomputed by the last increase or deletion
+   */
+  std::size_t LastRepairedPairs() const { return repaired_pairs_; }
+
+ private:
+  void Recompute();
+  void Decrease(int from, int to, int weight);
+  void Increase(int from, int to, int old_weight);
+
+  Graph &graph_;
+  matrix distance_;
+  // Матрица в исходных номерах, пустая, пока её не спросили.
+  matrix original_;
+  std::uint64_t version_ = 0;
+  std::size_t repaired_pairs_ = 0;
+};
+
+}  // namespace s21
+
+#endif  // SRC_MODEL_S21_DYNAMIC_SHORTEST_PATHS_H_
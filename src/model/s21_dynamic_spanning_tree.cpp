@@ -0,0 +1,212 @@
+#include "s21_dynamic_spanning_tree.h"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+#include "s21_algorithm_stats.h"
+#include "s21_trace.h"
+
+namespace s21 {
+
+DynamicSpanningTree::DynamicSpanningTree(Graph &graph) : graph_(graph) {
+  if (graph_.size() == 0 || graph_.IsDirected()) {
+    throw std::invalid_argument(
+        "[ [Wrong argument] ] :: Graph must be undirected\n");
+  }
+  Rebuild();
+}
+
+void DynamicSpanningTree::SetEdge(int first, int second, int weight) {
+  S21_STATS_SCOPE("DynamicSpanningTree");
+  Trace::Scope trace("DynamicSpanningTree::SetEdge", "V", graph_.size());
+  if (first < 0 || first >= graph_.size() || second < 0 ||
+      second >= graph_.size()) {
+    throw std::out_of_range("[ [Wrong argument] ] :: Vertex does not exist\n");
+  }
+  const bool kCurrent = graph_.Version() == version_;
+  const int kFirst = graph_.Permutation().ToInternal(first);
+  const int kSecond = graph_.Permutation().ToInternal(second);
+  const int kOld = graph_[kFirst][kSecond];
+  graph_.SetEdge(first, second, weight);
+  graph_.SetEdge(second, first, weight);
+  if (!kCurrent) return;  // дерево будет перестроено при обращении
+  version_ = graph_.Version();
+  if (kOld == weight) return;
+
+  // Дерево и строки графа хранятся во внутренних номерах.
+  original_.clear();
+
+  if (tree_[kFirst][kSecond] != 0) {
+    if (weight != 0 && weight < kOld) {
+      weight_ += weight - kOld;
+      tree_[kFirst][kSecond] = tree_[kSecond][kFirst] = weight;
+      return;
+    }
+    RemoveTreeEdge(kFirst, kSecond);
+    Reconnect(kFirst, kSecond);
+    return;
+  }
+
+  // Ребро вне дерева: ухудшение ничего не меняет.
+  if (weight == 0 || (kOld != 0 && weight > kOld)) return;
+
+  const vector<int> kPath = TreePath(kFirst, kSecond);
+  if (kPath.empty()) {
+    AddTreeEdge(kFirst, kSecond, weight);
+    return;
+  }
+  auto path_edge = [this, &kPath](std::size_t i) {
+    return tree_[kPath[i]][kPath[i + 1]];
+  };
+  std::size_t heaviest = 0;
+  for (std::size_t i = 1; i + 1 < kPath.size(); ++i)
+    if (path_edge(i) > path_edge(heaviest)) heaviest = i;
+  if (path_edge(heaviest) > weight) {
+    RemoveTreeEdge(kPath[heaviest], kPath[heaviest + 1]);
+    AddTreeEdge(kFirst, kSecond, weight);
+  }
+}
+
+void DynamicSpanningTree::RemoveEdge(int first, int second) {
+  // Петель нет, но номера вершин проверяет граф.
+  if (first == second) {
+    graph_.RemoveEdge(first, second);
+  } else {
+    SetEdge(first, second, 0);
+  }
+}
+
+const matrix &DynamicSpanningTree::Tree() {
+  if (graph_.Version() != version_) Rebuild();
+  if (graph_.Permutation().IsIdentity()) return tree_;
+  if (original_.empty()) {
+    original_ = graph_.Permutation().MatrixToOriginal(tree_);
+  }
+  return original_;
+}
+
+long long DynamicSpanningTree::Weight() {
+  if (graph_.Version() != version_) Rebuild();
+  return weight_;
+}
+
+/**
+ * Prim's algorithm over the dense matrix, restarted in every component.
+ */
+void DynamicSpanningTree::Rebuild() {
+  const int kSize = graph_.size();
+  const int kInfinity = std::numeric_limits<int>::max();
+  tree_.assign(kSize, vector<int>(kSize, 0));
+  original_.clear();
+  adjacent_.assign(kSize, vector<int>());
+  weight_ = 0;
+
+  vector<char> visited(kSize, 0);
+  vector<int> distances(kSize, kInfinity);
+  vector<int> parents(kSize, -1);
+  for (int i = 0; i < kSize; ++i) {
+    int vertex = -1;
+    for (int j = 0; j < kSize; ++j)
+      if (!visited[j] && (vertex < 0 || distances[j] < distances[vertex]))
+        vertex = j;
+    visited[vertex] = 1;
+    if (parents[vertex] >= 0)
+      AddTreeEdge(parents[vertex], vertex, distances[vertex]);
+
+    const vector<int> &row = graph_[vertex];
+    for (int j = 0; j < kSize; ++j) {
+      if (!visited[j] && row[j] > 0 && row[j] < distances[j]) {
+        distances[j] = row[j];
+        parents[j] = vertex;
+      }
+    }
+  }
+  version_ = graph_.Version();
+}
+
+void DynamicSpanningTree::AddTreeEdge(int first, int second, int weight) {
+  tree_[first][second] = tree_[second][first] = weight;
+  adjacent_[first].push_back(second);
+  adjacent_[second].push_back(first);
+  weight_ += weight;
+}
+
+void DynamicSpanningTree::RemoveTreeEdge(int first, int second) {
+  weight_ -= tree_[first][second];
+  tree_[first][second] = tree_[second][first] = 0;
+  auto &first_list = adjacent_[first];
+  auto &second_list = adjacent_[second];
+  first_list.erase(std::find(first_list.begin(), first_list.end(), second));
+  second_list.erase(std::find(second_list.begin(), second_list.end(), first));
+}
+
+/**
+ * Returns the vertices of the tree path between two vertices, or an empty
+ * vector if they are in different components.
+ */
+vector<int> DynamicSpanningTree::TreePath(int from, int to) const {
+  vector<int> parents(graph_.size(), -1);
+  vector<int> stack = {from};
+  parents[from] = from;
+  while (!stack.empty() && parents[to] < 0) {
+    const int kVertex = stack.back();
+    stack.pop_back();
+    for (int next : adjacent_[kVertex]) {
+      if (parents[next] >= 0) continue;
+      parents[next] = kVertex;
+      stack.push_back(next);
+    }
+  }
+  if (parents[to] < 0) return {};
+  vector<int> path = {to};
+  while (path.back() != from) path.push_back(parents[path.back()]);
+  return path;
+}
+
+vector<int> DynamicSpanningTree::TreeComponent(int vertex,
+                                               vector<char> &mark) const {
+  vector<int> component = {vertex};
+  mark[vertex] = 1;
+  for (std::size_t i = 0; i != component.size(); ++i) {
+    for (int next : adjacent_[component[i]]) {
+      if (mark[next]) continue;
+      mark[next] = 1;
+      component.push_back(next);
+    }
+  }
+  return component;
+}
+
+/**
+ * Joins the two parts of the tree left after removing the edge between the
+ * given vertices with the lightest edge of the graph between them.
+ */
+void DynamicSpanningTree::Reconnect(int first, int second) {
+  vector<char> in_first(graph_.size(), 0);
+  vector<char> in_second(graph_.size(), 0);
+  vector<int> first_part = TreeComponent(first, in_first);
+  vector<int> second_part = TreeComponent(second, in_second);
+  const bool kFirstSmaller = first_part.size() <= second_part.size();
+  const vector<int> &kSmall = kFirstSmaller ? first_part : second_part;
+  const vector<char> &kOther = kFirstSmaller ? in_second : in_first;
+
+  int best_weight = 0;
+  int best_from = -1;
+  int best_to = -1;
+  for (int vertex : kSmall) {
+    const vector<int> &row = graph_[vertex];
+    for (int j = 0; j < graph_.size(); ++j) {
+      if (!kOther[j] || row[j] == 0) continue;
+      S21_STATS_ADD(edges_scanned, 1);
+      if (best_from < 0 || row[j] < best_weight) {
+        best_weight = row[j];
+        best_from = vertex;
+        best_to = j;
+      }
+    }
+  }
+  if (best_from >= 0) AddTreeEdge(best_from, best_to, best_weight);
+}
+
+}  // namespace s21
@@ -0,0 +1,92 @@
+#ifndef SRC_MODEL_S21_DYNAMIC_SPANNING_TREE_H_
+#define SRC_MODEL_S21_DYNAMIC_SPANNING_TREE_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "s21_graph.h"
+
+namespace s21 {
+
+/**
+ * Minimum spanning tree of an undirected graph that is kept up to date while
+ * single edges change. An inserted or cheaper edge replaces the heaviest edge
+ * of the tree path between its ends if it is lighter (cycle property). A
+ * deleted or heavier tree edge splits the tree, and the lightest edge between
+ * the two parts is searched from the smaller part. Disconnected graphs get a
+ * minimum spanning forest.
+ *
+ * The tree is stored in the matrix format of
+ * GraphAlgorithms::GetLeastSpanningTree, so it and its weight are available in
+ * O(1). Changes made to the graph bypassing this object are detected by the
+ * graph version and lead to a full recomputation.
+ *
+ * The vertices are numbered as in Graph::SetEdge. The tree is kept in the
+ * internal numbering of a reordered graph and renumbered once per change
+ * when Tree() is read.
+ */
+class DynamicSpanningTree {
+ public:
+  /**
+   * Builds the spanning tree of the graph by Prim's algorithm.
+   *
+   * @param graph the undirected graph, it must outlive this object
+   *
+   * @throws std::invalid_argument if the graph is empty or directed
+   */
+  explicit DynamicSpanningTree(Graph &graph);
+
+  /**
+   * Changes the weight of the undirected edge in the graph (both directions)
+   * and repairs the tree.
+   *
+   * @param first the first vertex, from 0
+   * @param second the second vertex, from 0
+   * @param weight the new weight, 0 deletes the edge
+   *
+   * @throws std::out_of_range if a vertex does not exist
+   * @throws std::invalid_argument if the weight is negative or the edge is a
+   * loop
+   */
+  void SetEdge(int first, int second, int weight);
+
+  /**
+   * Deletes the undirected edge from the graph and repairs the tree.
+   *
+   * @param first the first vertex, from 0
+   * @param second the second vertex, from 0
+   *
+   * @throws std::out_of_range if a vertex does not exist
+   */
+  void RemoveEdge(int first, int second);
+
+  /**
+   * @return the adjacency matrix of the tree
+   */
+  const matrix &Tree();
+
+  /**
+   * @return the total weight of the tree
+   */
+  long long Weight();
+
+ private:
+  void Rebuild();
+  void AddTreeEdge(int first, int second, int weight);
+  void RemoveTreeEdge(int first, int second);
+  vector<int> TreePath(int from, int to) const;
+  vector<int> TreeComponent(int vertex, vector<char> &mark) const;
+  void Reconnect(int first, int second);
+
+  Graph &graph_;
+  matrix tree_;
+  // Дерево в исходных номерах, пустое, пока его не спросили.
+  matrix original_;
+  vector<vector<int>> adjacent_;
+  long long weight_ = 0;
+  std::uint64_t version_ = 0;
+};
+
+}  // namespace s21
+
+#endif  // SRC_MODEL_S21_DYNAMIC_SPANNING_TREE_H_
@@ -0,0 +1,350 @@
+#include "s21_external_shortest_paths.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+
+#include "s21_algorithm_stats.h"
+#include "s21_trace.h"
+
+namespace s21 {
+
+namespace {
+const char kFileMagic[8] = {'S', '2', '1', 'A', 'P', 'S', 'P', 'M'};
+const std::uint32_t kFileVersion = 1;
+// Заголовок дополняется до 64 байт, чтобы плитки были выровнены.
+const std::size_t kHeaderSize = 64;
+const int kUnreachable = std::numeric_limits<int>::max();
+
+using Tile = vector<int>;
+using RowSource = std::function<const vector<int> &(int row)>;
+
+/**
+ * The matrix of distances split into square tiles in a file. Tiles at the
+ * border are padded with vertices without edges.
+ */
+class TileFile {
+ public:
+  TileFile(const string &filename, int vertices, int tile)
+      : filename_(filename),
+        tile_(tile),
+        count_((vertices + tile - 1) / tile),
+        file_(filename, std::ios::binary | std::ios::in | std::ios::out |
+                            std::ios::trunc) {
+    if (!file_) {
+      throw std::runtime_error("[ [File error] ] :: Can't write " + filename +
+                               "\n");
+    }
+    char header[kHeaderSize] = {};
+    const std::uint32_t kSizes[3] = {kFileVersion,
+                                     static_cast<std::uint32_t>(vertices),
+                                     static_cast<std::uint32_t>(tile)};
+    std::memcpy(header, kFileMagic, sizeof(kFileMagic));
+    std::memcpy(header + sizeof(kFileMagic), kSizes, sizeof(kSizes));
+    file_.write(header, kHeaderSize);
+    Check();
+  }
+
+  int Count() const { return count_; }
+  int Side() const { return tile_; }
+
+  void Read(int row, int column, Tile &tile) {
+    file_.seekg(Offset(row, column));
+    file_.read(reinterpret_cast<char *>(tile.data()), Bytes());
+    Check();
+  }
+
+  void Write(int row, int column, const Tile &tile) {
+    file_.seekp(Offset(row, column));
+    file_.write(reinterpret_cast<const char *>(tile.data()), Bytes());
+    Check();
+  }
+
+  void Flush() {
+    file_.flush();
+    Check();
+  }
+
+ private:
+  std::streamoff Offset(int row, int column) const {
+    return static_cast<std::streamoff>(kHeaderSize) +
+           (static_cast<std::streamoff>(row) * count_ + column) * Bytes();
+  }
+
+  std::streamsize Bytes() const {
+    return static_cast<std::streamsize>(tile_) * tile_ * sizeof(int);
+  }
+
+  void Check() {
+    if (!file_) {
+      throw std::runtime_error("[ [File error] ] :: Can't access " +
+                               filename_ + "\n");
+    }
+  }
+
+  string filename_;
+  int tile_;
+  int count_;
+  std::fstream file_;
+};
+
+/**
+ * Chooses the largest tile whose row of tiles and two more tiles fit the
+ * budget.
+ */
+int ChooseTile(int vertices, const ExternalPathsOptions &options) {
+  auto Bytes = [vertices](long long tile) {
+    const long long kCount = (vertices + tile - 1) / tile;
+    return static_cast<std::size_t>((kCount + 2) * tile * tile) * sizeof(int);
+  };
+  long long tile = options.tile;
+  if (tile <= 0) {
+    tile = std::max<long long>(
+        1, options.memory_budget / (sizeof(int) * vertices));
+    tile = std::min<long long>(tile, vertices);
+    while (tile > 1 && Bytes(tile) > options.memory_budget) --tile;
+  }
+  tile = std::min<long long>(tile, vertices);
+  if (Bytes(tile) > options.memory_budget) {
+    throw std::invalid_argument(
+        "[ [Wrong argument] ] :: Memory budget is too small for a row of "
+        "tiles\n");
+  }
+  return static_cast<int>(tile);
+}
+
+/**
+ * target[i][j] = min(target[i][j], left[i][m] + right[m][j]). The target may
+ * be one of the arguments: with m in the outer loop the pivot row and column
+ * do not change during their own step, as in the usual Floyd-Warshall.
+ */
+void Relax(Tile &target, const Tile &left, const Tile &right, int side) {
+  for (int middle = 0; middle < side; ++middle) {
+    const int *right_row = right.data() + middle * side;
+    for (int row = 0; row < side; ++row) {
+      const int kLeft = left[row * side + middle];
+      if (kLeft == kUnreachable) continue;
+      int *target_row = target.data() + row * side;
+      for (int column = 0; column < side; ++column) {
+        if (right_row[column] == kUnreachable) continue;
+        const long long kLength =
+            static_cast<long long>(kLeft) + right_row[column];
+        if (kLength < target_row[column]) {
+          target_row[column] = static_cast<int>(kLength);
+          S21_STATS_ADD(cells_updated, 1);
+        }
+      }
+    }
+  }
+}
+
+/**
+ * Writes the initial distances band by band: a band of rows fills the
+ * buffers of one row of tiles.
+ */
+void WriteEdges(TileFile &file, vector<Tile> &band, int vertices,
+                const RowSource &rows) {
+  S21_STATS_PHASE("initialization");
+  const int kSide = file.Side();
+  for (int band_row = 0; band_row < file.Count(); ++band_row) {
+    for (Tile &tile : band) std::fill(tile.begin(), tile.end(), kUnreachable);
+    for (int local = 0; local < kSide; ++local) {
+      const int kRow = band_row * kSide + local;
+      if (kRow >= vertices) break;
+      const vector<int> &weights = rows(kRow);
+      for (int column = 0; column < vertices; ++column) {
+        int distance = weights[column] != 0 ? weights[column] : kUnreachable;
+        if (column == kRow) distance = 0;
+        band[column / kSide][local * kSide + column % kSide] = distance;
+      }
+    }
+    for (int column = 0; column < file.Count(); ++column) {
+      file.Write(band_row, column, band[column]);
+    }
+  }
+}
+
+/**
+ * Runs the blocked algorithm. For every pivot its row of tiles is finished
+ * first; then every other row of tiles is relaxed from left to right, its
+ * pivot column tile first.
+ */
+void RunBlocked(TileFile &file, vector<Tile> &pivot) {
+  S21_STATS_PHASE("relaxation");
+  const int kSide = file.Side();
+  const int kCount = file.Count();
+  Tile column(pivot.front().size());
+  Tile work(pivot.front().size());
+  for (int step = 0; step < kCount; ++step) {
+    S21_STATS_ADD(iterations, 1);
+    Trace::Scope trace("ExternalShortestPaths::Pivot", "tile", step);
+    for (int j = 0; j < kCount; ++j) file.Read(step, j, pivot[j]);
+    Relax(pivot[step], pivot[step], pivot[step], kSide);
+    for (int j = 0; j < kCount; ++j) {
+      if (j != step) Relax(pivot[j], pivot[step], pivot[j], kSide);
+      file.Write(step, j, pivot[j]);
+    }
+    for (int i = 0; i < kCount; ++i) {
+      if (i == step) continue;
+      file.Read(i, step, column);
+      Relax(column, column, pivot[step], kSide);
+      for (int j = 0; j < kCount; ++j) {
+        if (j == step) {
+          file.Write(i, j, column);
+          continue;
+        }
+        file.Read(i, j, work);
+        Relax(work, column, pivot[j], kSide);
+        file.Write(i, j, work);
+      }
+    }
+  }
+  file.Flush();
+}
+
+void Compute(const string &output, int vertices,
+             const ExternalPathsOptions &options, const RowSource &rows) {
+  S21_STATS_SCOPE("ExternalShortestPaths");
+  const int kTile = ChooseTile(vertices, options);
+  Trace::Scope trace("ExternalShortestPaths", "V", vertices, "tile", kTile);
+  try {
+    TileFile file(output, vertices, kTile);
+    vector<Tile> pivot(file.Count(), Tile(std::size_t(kTile) * kTile));
+    S21_STATS_MEMORY((file.Count() + 2) * sizeof(int) * kTile * kTile);
+    WriteEdges(file, pivot, vertices, rows);
+    RunBlocked(file, pivot);
+  } catch (...) {
+    // Недописанный файл матрицы не оставляется.
+    std::remove(output.c_str());
+    throw;
+  }
+}
+}  // namespace
+
+void ExternalShortestPaths::FromFile(const string &graph_file,
+                                     const string &output,
+                                     const ExternalPathsOptions &options) {
+  std::ifstream file(graph_file);
+  if (!file.is_open()) {
+    throw std::runtime_error("[ [Wrong argument] ] :: File not found\n");
+  }
+  string line;
+  int vertices = 0;
+  std::getline(file, line);
+  if (sscanf(line.c_str(), "%d", &vertices) != 1 || vertices < 1) {
+    throw std::out_of_range("[ [File error] ] :: Matrix size must be > 0\n");
+  }
+
+  // Строки читаются по порядку, в памяти только текущая.
+  vector<int> weights(vertices);
+  Compute(output, vertices, options, [&](int) -> const vector<int> & {
+    if (!std::getline(file, line)) {
+      throw std::out_of_range("[ [File error] ] :: Invalid matrix size\n");
+    }
+    const char *cursor = line.c_str();
+    int count = 0;
+    for (char *end = nullptr;; cursor = end) {
+      const long kValue = std::strtol(cursor, &end, 10);
+      if (end == cursor) break;
+      if (count == vertices) {
+        throw std::out_of_range("[ [File error] ] :: Invalid matrix size\n");
+      }
+      if (kValue < 0) {
+        throw std::out_of_range("[ [File error] ] :: Negative matrix element\n");
+      }
+      weights[count++] = static_cast<int>(kValue);
+    }
+    if (count != vertices) {
+      throw std::out_of_range("[ [File error] ] :: Invalid matrix size\n");
+    }
+    return weights;
+  });
+  if (std::getline(file, line)) {
+    std::remove(output.c_str());
+    throw std::out_of_range("[ [File error] ] :: Invalid matrix size\n");
+  }
+}
+
+void ExternalShortestPaths::FromGraph(const Graph &graph, const string &output,
+                                      const ExternalPathsOptions &options) {
+  if (graph.size() == 0) {
+    throw std::invalid_argument(
+        "[ [Wrong argument] ] :: Graph or start vertex is invalid\n");
+  }
+  Compute(output, graph.size(), options,
+          [&graph](int row) -> const vector<int> & { return graph[row]; });
+}
+
+DistanceFile::DistanceFile(const string &filename) {
+  const int kDescriptor = open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+  struct stat status {};
+  if (kDescriptor < 0 || fstat(kDescriptor, &status) != 0) {
+    if (kDescriptor >= 0) close(kDescriptor);
+    throw std::runtime_error("[ [File error] ] :: Can't open " + filename +
+                             "\n");
+  }
+  length_ = static_cast<std::size_t>(status.st_size);
+  if (length_ >= kHeaderSize) {
+    data_ = mmap(nullptr, length_, PROT_READ, MAP_SHARED, kDescriptor, 0);
+    if (data_ == MAP_FAILED) data_ = nullptr;
+  }
+  close(kDescriptor);
+
+  bool valid = data_ != nullptr;
+  if (valid) {
+    const char *header = static_cast<const char *>(data_);
+    std::uint32_t sizes[3] = {};
+    std::memcpy(sizes, header + sizeof(kFileMagic), sizeof(sizes));
+    vertices_ = static_cast<int>(sizes[1]);
+    tile_ = static_cast<int>(sizes[2]);
+    valid = std::memcmp(header, kFileMagic, sizeof(kFileMagic)) == 0 &&
+            sizes[0] == kFileVersion && vertices_ > 0 && tile_ > 0 &&
+            tile_ <= vertices_;
+    if (valid) {
+      const std::size_t kCount = (vertices_ + tile_ - 1) / tile_;
+      valid = length_ == kHeaderSize + kCount * kCount * tile_ * tile_ *
+                                           sizeof(int);
+    }
+    tiles_ = reinterpret_cast<const int *>(header + kHeaderSize);
+  }
+  if (!valid) {
+    if (data_) munmap(data_, length_);
+    throw std::runtime_error("[ [File error] ] :: Damaged distance file\n");
+  }
+}
+
+DistanceFile::~DistanceFile() { munmap(data_, length_); }
+
+int DistanceFile::At(int from, int to) const {
+  if (from < 0 || from >= vertices_ || to < 0 || to >= vertices_) {
+    throw std::out_of_range("[ [Wrong argument] ] :: Vertex is invalid\n");
+  }
+  const std::size_t kCount = (vertices_ + tile_ - 1) / tile_;
+  const std::size_t kTile = (from / tile_) * kCount + to / tile_;
+  return tiles_[kTile * tile_ * tile_ + (from % tile_) * tile_ + to % tile_];
+}
+
+vector<int> DistanceFile::Row(int from) const {
+  vector<int> row(vertices_);
+  for (int to = 0; to < vertices_; ++to) row[to] = At(from, to);
+  return row;
+}
+
+matrix DistanceFile::ToMatrix() const {
+  matrix distances(vertices_);
+  for (int from = 0; from < vertices_; ++from) distances[from] = Row(from);
+  return distances;
+}
+
+}  // namespace s21
@@ -0,0 +1,109 @@
+#ifndef SRC_MODEL_S21_EXTERNAL_SHORTEST_PATHS_H_
+#define SRC_MODEL_S21_EXTERNAL_SHORTEST_PATHS_H_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "s21_graph.h"
+
+namespace s21 {
+
+/**
+ * Options of the out-of-core Floyd-Warshall algorithm.
+ *
+ * @field memory_budget the bytes of distances kept in memory: a row of tiles
+ * and two more tiles
+ * @field tile the side of a square tile, zero means the largest one that fits
+ * the budget
+ */
+struct ExternalPathsOptions {
+  std::size_t memory_budget = std::size_t(256) << 20;
+  int tile = 0;
+};
+
+/**
+ * The matrix of all shortest paths written by ExternalShortestPaths, mapped
+ * into memory read-only. The file has a 64-byte header and the tiles in
+ * row-major order, each tile is a row-major square of 32-bit distances; the
+ * maximal int means there is no path. Pages are read by the system on
+ * access, so the matrix may be larger than the memory.
+ */
+class DistanceFile {
+ public:
+  /**
+   * @param filename the file written by ExternalShortestPaths
+   *
+   * @throws std::runtime_error if the file cannot be mapped or is damaged
+   */
+  explicit DistanceFile(const string &filename);
+  DistanceFile(const DistanceFile &other) = delete;
+  DistanceFile &operator=(const DistanceFile &other) = delete;
+  ~DistanceFile();
+
+  int size() const { return vertices_; }
+  int Tile() const { return tile_; }
+
+  /**
+   * @param from the start vertex, from 0
+   * @param to the end vertex, from 0
+   *
+   * @return the length of the shortest path, or the maximal int
+   *
+   * @throws std::out_of_range if a vertex does not exist
+   */
+  int At(int from, int to) const;
+
+  /**
+   * @return the distances from the vertex, from 0
+   */
+  vector<int> Row(int from) const;
+
+  /**
+   * Copies the whole matrix into memory, for graphs that fit there.
+   */
+  matrix ToMatrix() const;
+
+ private:
+  void *data_ = nullptr;
+  std::size_t length_ = 0;
+  const int *tiles_ = nullptr;
+  int vertices_ = 0;
+  int tile_ = 0;
+};
+
+/**
+ * Blocked Floyd-Warshall algorithm that keeps the matrix in a file. For every
+ * pivot tile the pivot row of tiles is held in memory, and the other rows of
+ * tiles are read, relaxed and written back one tile at a time in file order,
+ * so memory stays within the budget and the disk is read sequentially. One
+ * pass over the file is made per row of tiles.
+ */
+class ExternalShortestPaths {
+ public:
+  /**
+   * Computes all shortest paths of a graph file in the adjacency matrix
+   * format of Graph::loadGraphFromFile without loading it: the rows are
+   * streamed into tiles.
+   *
+   * @param graph_file the file of the graph
+   * @param output the result file, see DistanceFile
+   * @param options the memory budget
+   *
+   * @throws std::runtime_error if a file cannot be read or written
+   * @throws std::out_of_range if the graph file is malformed
+   * @throws std::invalid_argument if the budget cannot hold a row of tiles
+   */
+  static void FromFile(const string &graph_file, const string &output,
+                       const ExternalPathsOptions &options = {});
+
+  /**
+   * Computes all shortest paths of a loaded graph into a file.
+   */
+  static void FromGraph(const Graph &graph, const string &output,
+                        const ExternalPathsOptions &options = {});
+};
+
+}  // namespace s21
+
+#endif  // SRC_MODEL_S21_EXTERNAL_SHORTEST_PATHS_H_
@@ -1,16 +1,66 @@
 #include "s21_graph.h"
+
+#include <atomic>
+
+#include "s21_trace.h"
+
 namespace s21 {
 
-vector<int> Graph::operator[](int index) { return adjacency_matrix_[index]; }
+namespace {
+std::atomic<std::uint64_t> next_version{1};
 
-const vector<int> Graph::operator[](int index) const {
-  return adjacency_matrix_[index];
+// Дробные веса печатаются без лишних нулей, как во входном файле.
+template <typename Weight>
+std::string Label(Weight weight) {
+  if constexpr (std::is_floating_point_v<Weight>) {
+    std::ostringstream label;
+    label << weight;
+    return label.str();
+  } else {
+    return std::to_string(weight);
+  }
 }
+}  // namespace
 
-void Graph::loadGraphFromFile(const string &filename) {
-  if (!adjacency_matrix_.empty()) {
-    adjacency_matrix_.clear();
+template <typename Weight>
+BasicGraph<Weight>::BasicGraph(BasicMatrix<Weight> adjacency,
+                               VertexPermutation permutation)
+    : permutation_(std::move(permutation)), version_(next_version++) {
+  if (adjacency.empty()) {
+    throw std::out_of_range("[ [File error] ] :: Matrix size must be > 0\n");
   }
+  for (const vector<Weight> &row : adjacency) {
+    if (row.size() != adjacency.size()) {
+      throw std::out_of_range("[ [File error] ] :: Invalid matrix size\n");
+    }
+    if (std::any_of(row.begin(), row.end(),
+                    [](Weight weight) { return weight < 0; })) {
+      throw std::out_of_range("[ [File error] ] :: Negative matrix element\n");
+    }
+  }
+  if (!permutation_.IsIdentity() &&
+      permutation_.size() != static_cast<int>(adjacency.size())) {
+    throw std::invalid_argument(
+        "[ [Wrong argument] ] :: Permutation does not fit the graph\n");
+  }
+  adjacency_matrix_ = std::move(adjacency);
+  UpdateProperties();
+}
+
+template <typename Weight>
+const vector<Weight> &BasicGraph<Weight>::operator[](int index) const {
+  return adjacency_matrix_[index];
+}
+
+template <typename Weight>
+void BasicGraph<Weight>::loadGraphFromFile(const string &filename) {
+  Trace::Scope trace("Graph::loadGraphFromFile");
+  // При ошибке загрузки граф остаётся пустым.
+  adjacency_matrix_.clear();
+  permutation_ = VertexPermutation();
+  UpdateProperties();
+  version_ = next_version++;
+  BasicMatrix<Weight> loaded;
   std::ifstream file(filename);
   if (!file.is_open()) {
     throw std::runtime_error("[ [Wrong argument] ] :: File not found\n");
@@ -23,37 +73,119 @@ void Graph::loadGraphFromFile(const string &filename) {
     throw std::out_of_range("[ [File error] ] :: Matrix size must be > 0\n");
   }
 
-  int stream_int;
+  // Веса читаются в широком типе: uint8_t читался бы как символ.
+  typename WeightTraits<Weight>::Parsed stream_int;
+  bool negative = false;
+  bool fits = true;
   while (std::getline(file, tmp_str)) {
     std::stringstream stream(tmp_str);
-    vector<int> tmp_vector;
+    vector<Weight> tmp_vector;
     while (stream >> stream_int) {
-      tmp_vector.push_back(stream_int);
+      if (stream_int < 0) {
+        negative = true;
+      } else if (!WeightTraits<Weight>::Fits(stream_int)) {
+        fits = false;
+      }
+      tmp_vector.push_back(static_cast<Weight>(stream_int));
     }
-    adjacency_matrix_.push_back(tmp_vector);
+    loaded.push_back(tmp_vector);
   }
 
-  if (adjacency_matrix_.size() != vert_count) {
+  if (loaded.size() != vert_count) {
     throw std::out_of_range("[ [File error] ] :: Invalid matrix size\n");
   }
 
   for (int i = 0; i < vert_count; ++i) {
-    if (adjacency_matrix_[i].size() != vert_count ||
-        adjacency_matrix_[i][0] < 0) {
+    if (loaded[i].size() != vert_count) {
       throw std::out_of_range("[ [File error] ] :: Invalid matrix size\n");
     }
   }
-  for (auto const &it : adjacency_matrix_) {
-    for (auto const &it2 : it) {
-      if (it2 < 0) {
-        throw std::out_of_range(
-            "[ [File error] ] :: Negative matrix element\n");
-      }
+  if (negative) {
+    throw std::out_of_range("[ [File error] ] :: Negative matrix element\n");
+  }
+  if (!fits) {
+    throw std::out_of_range(
+        "[ [File error] ] :: Matrix element does not fit the weight type\n");
+  }
+  adjacency_matrix_ = std::move(loaded);
+  UpdateProperties();
+  trace.Arg(0, "V", vert_count);
+  trace.Arg(1, "E", properties_.edge_count);
+}
+
+template <typename Weight>
+void BasicGraph<Weight>::Reorder(VertexOrder order) {
+  Trace::Scope trace("Graph::Reorder", "V", size(), "E",
+                     properties_.edge_count);
+  const VertexPermutation kStep = ComputeVertexOrder(*this, order);
+  if (kStep.IsIdentity()) return;
+  BasicMatrix<Weight> reordered(size(), vector<Weight>(size()));
+  for (int row = 0; row < size(); ++row) {
+    const vector<Weight> &source = adjacency_matrix_[kStep.ToOriginal(row)];
+    for (int col = 0; col < size(); ++col) {
+      reordered[row][col] = source[kStep.ToOriginal(col)];
     }
   }
+  adjacency_matrix_ = std::move(reordered);
+  permutation_ = permutation_.Then(kStep);
+  version_ = next_version++;
+  UpdateProperties();
+}
+
+template <typename Weight>
+void BasicGraph<Weight>::SetEdge(int from, int to, Weight weight) {
+  if (from < 0 || from >= size() || to < 0 || to >= size()) {
+    throw std::out_of_range("[ [Wrong argument] ] :: Vertex does not exist\n");
+  }
+  if (weight < 0 || from == to) {
+    throw std::invalid_argument("[ [Wrong argument] ] :: Invalid edge\n");
+  }
+  // Вес графа считается над диагональю в исходной нумерации.
+  const bool kAboveDiagonal = from < to;
+  from = permutation_.ToInternal(from);
+  to = permutation_.ToInternal(to);
+  const Weight kOld = adjacency_matrix_[from][to];
+  if (kOld == weight) return;
+
+  const Weight kReverse = adjacency_matrix_[to][from];
+  asymmetric_pairs_ += (weight != kReverse) - (kOld != kReverse);
+  if (kAboveDiagonal) {
+    properties_.total_weight +=
+        static_cast<typename WeightTraits<Weight>::Sum>(weight) - kOld;
+  }
+
+  if (kOld != 0 && --weight_counts_[kOld] == 0) weight_counts_.erase(kOld);
+  if (weight != 0) ++weight_counts_[weight];
+
+  const int kDegree = degrees_[from];
+  const int kNewDegree = kDegree + (weight != 0) - (kOld != 0);
+  if (kNewDegree != kDegree) {
+    if (--degree_counts_[kDegree] == 0) degree_counts_.erase(kDegree);
+    ++degree_counts_[kNewDegree];
+    degrees_[from] = kNewDegree;
+    arcs_ += kNewDegree - kDegree;
+  }
+
+  adjacency_matrix_[from][to] = weight;
+  version_ = next_version++;
+  RefreshProperties();
+}
+
+template <typename Weight>
+void BasicGraph<Weight>::RemoveEdge(int from, int to) {
+  if (from < 0 || from >= size() || to < 0 || to >= size()) {
+    throw std::out_of_range("[ [Wrong argument] ] :: Vertex does not exist\n");
+  }
+  if (from != to) SetEdge(from, to, 0);
+}
+
+template <typename Weight>
+std::uint64_t BasicGraph<Weight>::Version() const {
+  return version_;
 }
 
-vector<int> Graph::neighborsFromQueue(const int &vertex) const {
+template <typename Weight>
+vector<int> BasicGraph<Weight>::neighborsFromQueue(const int &vertex) const {
   vector<int> result;
   for (int i = 0; i < size(); ++i) {
     if (adjacency_matrix_.at(vertex).at(i) > 0) {
@@ -63,7 +195,8 @@ vector<int> Graph::neighborsFromQueue(const int &vertex) const {
   return result;
 }
 
-vector<int> Graph::neighborsFromStack(const int &vertex) const {
+template <typename Weight>
+vector<int> BasicGraph<Weight>::neighborsFromStack(const int &vertex) const {
   vector<int> result;
   for (int i = size() - 1; i >= 0; --i) {
     if (adjacency_matrix_.at(vertex).at(i) > 0) {
@@ -73,18 +206,18 @@ vector<int> Graph::neighborsFromStack(const int &vertex) const {
   return result;
 }
 
-bool Graph::IsDirected() const {
-  for (int i = 0; i < size(); ++i) {
-    for (int j = i + 1; j < size(); ++j) {
-      if (adjacency_matrix_.at(i).at(j) != adjacency_matrix_.at(j).at(i)) {
-        return true;
-      }
-    }
-  }
-  return false;
+template <typename Weight>
+bool BasicGraph<Weight>::IsDirected() const {
+  return properties_.directed;
+}
+
+template <typename Weight>
+const BasicGraphProperties<Weight> &BasicGraph<Weight>::Properties() const {
+  return properties_;
 }
 
-void Graph::exportGraphToDot(const string &filename) const {
+template <typename Weight>
+void BasicGraph<Weight>::exportGraphToDot(const string &filename) const {
   if (fileExists(filename)) {
     std::remove(filename.c_str());
   }
@@ -101,24 +234,67 @@ void Graph::exportGraphToDot(const string &filename) const {
             << std::endl;
 }
 
-int Graph::getGraphWeight() {
-  int weight = 0;
-  int size = adjacency_matrix_.size();
+template <typename Weight>
+typename BasicGraph<Weight>::Distance BasicGraph<Weight>::getGraphWeight()
+    const {
+  return static_cast<Distance>(properties_.total_weight);
+}
 
-  for (int i = 0; i < size; ++i) {
-    for (int j = i + 1; j < size; ++j) {
-      weight += adjacency_matrix_[i][j];
+/**
+ * Rebuilds the counters of the properties in one pass over the matrix.
+ */
+template <typename Weight>
+void BasicGraph<Weight>::UpdateProperties() {
+  const int kSize = size();
+  properties_ = BasicGraphProperties<Weight>();
+  weight_counts_.clear();
+  degree_counts_.clear();
+  degrees_.assign(kSize, 0);
+  arcs_ = 0;
+  asymmetric_pairs_ = 0;
+  for (int i = 0; i < kSize; ++i) {
+    const vector<Weight> &row = adjacency_matrix_[i];
+    const int kOriginal = permutation_.ToOriginal(i);
+    for (int j = 0; j < kSize; ++j) {
+      const Weight kWeight = row[j];
+      // Вес не зависит от порядка вершин, поэтому берётся над диагональю
+      // исходной матрицы.
+      if (permutation_.ToOriginal(j) > kOriginal) {
+        properties_.total_weight += kWeight;
+      }
+      if (j > i && kWeight != adjacency_matrix_[j][i]) ++asymmetric_pairs_;
+      if (kWeight == 0 || i == j) continue;
+      ++degrees_[i];
+      ++weight_counts_[kWeight];
     }
+    ++degree_counts_[degrees_[i]];
+    arcs_ += degrees_[i];
   }
-
-  return weight;
+  RefreshProperties();
 }
 
-int Graph::getGraphWeight() const {
-  return const_cast<Graph *>(this)->getGraphWeight();
+/**
+ * Fills the properties from the counters, in O(1) apart from the map lookups.
+ */
+template <typename Weight>
+void BasicGraph<Weight>::RefreshProperties() {
+  properties_.directed = asymmetric_pairs_ != 0;
+  properties_.edge_count = properties_.directed ? arcs_ : arcs_ / 2;
+  properties_.min_weight =
+      weight_counts_.empty() ? 0 : weight_counts_.begin()->first;
+  properties_.max_weight =
+      weight_counts_.empty() ? 0 : weight_counts_.rbegin()->first;
+  properties_.uniform_weights = weight_counts_.size() <= 1;
+  properties_.min_degree =
+      degree_counts_.empty() ? 0 : degree_counts_.begin()->first;
+  properties_.max_degree =
+      degree_counts_.empty() ? 0 : degree_counts_.rbegin()->first;
+  properties_.average_degree =
+      size() ? static_cast<double>(arcs_) / size() : 0;
 }
 
-std::string Graph::matrixToDot(bool directed) const {
+template <typename Weight>
+std::string BasicGraph<Weight>::matrixToDot(bool directed) const {
   std::string dot_graph;
 
   dot_graph += directed ? "digraph MyGraph" : "graph MyGraph";
@@ -128,9 +304,10 @@ std::string Graph::matrixToDot(bool directed) const {
   for (int i = 0; i < adjacency_matrix_.size(); ++i) {
     for (int j = 0; j < adjacency_matrix_[i].size(); ++j) {
       if (adjacency_matrix_[i][j] > 0) {
-        dot_graph += "\n  " + std::to_string(i) + (directed ? " -> " : " -- ") +
-                     std::to_string(j) +
-                     " [label=" + std::to_string(adjacency_matrix_[i][j]) +
+        dot_graph += "\n  " + std::to_string(permutation_.ToOriginal(i)) +
+                     (directed ? " -> " : " -- ") +
+                     std::to_string(permutation_.ToOriginal(j)) +
+                     " [label=" + Label(adjacency_matrix_[i][j]) +
                      "];";
       }
     }
@@ -140,10 +317,20 @@ std::string Graph::matrixToDot(bool directed) const {
   return dot_graph;
 }
 
-bool Graph::fileExists(const std::string &filename) const {
+template <typename Weight>
+bool BasicGraph<Weight>::fileExists(const std::string &filename) const {
   std::ifstream file(filename);
   return file.good();
 }
 
-int Graph::size() const { return static_cast<int>(adjacency_matrix_.size()); }
+template <typename Weight>
+int BasicGraph<Weight>::size() const {
+  return static_cast<int>(adjacency_matrix_.size());
+}
+
+template class BasicGraph<std::uint8_t>;
+template class BasicGraph<std::uint16_t>;
+template class BasicGraph<int>;
+template class BasicGraph<std::int64_t>;
+template class BasicGraph<float>;
 }  // namespace s21
\ No newline at end of file
@@ -2,29 +2,153 @@
 #define SRC_MODEL_S21_GRAPH_H_
 
 #include <algorithm>
+#include <cstdint>
 #include <exception>
 #include <fstream>
 #include <iostream>
 #include <iterator>
+#include <limits>
+#include <map>
 #include <random>
 #include <sstream>
 #include <string>
+#include <type_traits>
 #include <vector>
 
+#include "s21_vertex_order.h"
+
 namespace s21 {
 
 using std::string;
 using std::vector;
-using matrix = vector<vector<int>>;
-using matrixAntd = vector<vector<double>>;
+template <typename Weight>
+using BasicMatrix = vector<vector<Weight>>;
+using matrix = BasicMatrix<int>;
+
+/**
+ * Arithmetic of an edge weight type. Path lengths are kept in Distance, which
+ * is int for narrow weights, so that the graph stays small while sums do not
+ * overflow at once; sums that do not fit saturate to kInfinity, the length of
+ * a missing path.
+ *
+ * @field Distance the type of path lengths
+ * @field Sum the type of the total weight of a graph
+ * @field Parsed the type a weight is read as from a file
+ * @field kInfinity the length of a missing path
+ */
+template <typename Weight>
+struct WeightTraits {
+  static_assert(std::is_arithmetic_v<Weight> && !std::is_same_v<Weight, bool>,
+                "Weight must be a number");
+
+  static constexpr bool kFractional = std::is_floating_point_v<Weight>;
+  using Distance =
+      std::conditional_t<(sizeof(Weight) < sizeof(int)) && !kFractional, int,
+                         Weight>;
+  using Sum = std::conditional_t<kFractional, double, long long>;
+  using Parsed = std::conditional_t<kFractional, double, long long>;
+
+  static constexpr Distance kInfinity =
+      kFractional ? std::numeric_limits<Distance>::infinity()
+                  : std::numeric_limits<Distance>::max();
+
+  /**
+   * Adds two non-negative lengths, kInfinity if the sum does not fit.
+   */
+  static constexpr Distance Add(Distance a, Distance b) {
+    if constexpr (kFractional) {
+      return a + b;
+    } else {
+      return a > kInfinity - b ? kInfinity : a + b;
+    }
+  }
+
+  /**
+   * @return true if the parsed value is a valid weight of the type
+   */
+  static constexpr bool Fits(Parsed value) {
+    return value >= 0 && value <= static_cast<Parsed>(
+                                      std::numeric_limits<Weight>::max());
+  }
+};
+
+/**
+ * Properties of a graph computed once when it is loaded.
+ *
+ * @field directed the adjacency matrix is not symmetric
+ * @field edge_count the number of arcs of a directed graph or edges of an
+ * undirected one, loops excluded
+ * @field total_weight the sum of the weights above the main diagonal of the
+ * matrix in the original vertex numbering
+ * @field min_weight the smallest edge weight, 0 if there are no edges
+ * @field max_weight the largest edge weight, 0 if there are no edges
+ * @field min_degree the smallest number of outgoing edges of a vertex
+ * @field max_degree the largest number of outgoing edges of a vertex
+ * @field average_degree the average number of outgoing edges of a vertex
+ * @field uniform_weights all edges have the same weight
+ */
+template <typename Weight>
+struct BasicGraphProperties {
+  bool directed = false;
+  long long edge_count = 0;
+  typename WeightTraits<Weight>::Sum total_weight = 0;
+  Weight min_weight = 0;
+  Weight max_weight = 0;
+  int min_degree = 0;
+  int max_degree = 0;
+  double average_degree = 0;
+  bool uniform_weights = true;
+};
+
+using GraphProperties = BasicGraphProperties<int>;
 
-class Graph {
+/**
+ * A graph stored as an adjacency matrix of weights of the given type, zero
+ * means there is no edge. The members are compiled in s21_graph.cpp for
+ * std::uint8_t, std::uint16_t, int, std::int64_t and float; Graph is the
+ * graph of int weights. The graph is a dense graph view, see s21_graph_view.h.
+ *
+ * Reorder renumbers the stored vertices for cache locality. operator[], Cell
+ * and ForEachNeighbour then use the internal numbers, while SetEdge, the DOT
+ * export and the algorithms take and return the original ones through
+ * Permutation().
+ */
+template <typename Weight>
+class BasicGraph {
  public:
-  Graph() = default;
+  using WeightType = Weight;
+  using Distance = typename WeightTraits<Weight>::Distance;
 
-  vector<int> operator[](int index);
+  BasicGraph() = default;
 
-  const vector<int> operator[](int index) const;
+  /**
+   * Makes a graph of an adjacency matrix.
+   *
+   * @param adjacency the weights of the edges, 0 if there is no edge
+   * @param permutation the original numbers of the rows of the matrix
+   *
+   * @throws std::out_of_range if the matrix is empty, not square or has
+   * negative weights
+   * @throws std::invalid_argument if the permutation has another size
+   */
+  explicit BasicGraph(BasicMatrix<Weight> adjacency,
+                      VertexPermutation permutation = VertexPermutation());
+
+  const vector<Weight> &operator[](int index) const;
+
+  Weight Cell(int from, int to) const { return adjacency_matrix_[from][to]; }
+
+  /**
+   * Calls visit(to, weight) for every edge from the vertex in increasing
+   * order of to.
+   */
+  template <typename Visit>
+  void ForEachNeighbour(int vertex, Visit visit) const {
+    const vector<Weight> &row = adjacency_matrix_[vertex];
+    for (int to = 0; to < static_cast<int>(row.size()); ++to) {
+      if (row[to] != 0) visit(to, row[to]);
+    }
+  }
 
   /**
    * Load a graph from a file.
@@ -32,10 +156,56 @@ class Graph {
    * @param filename the name of the file to load the graph from
    *
    * @throws std::runtime_error if the file cannot be opened
-   * @throws std::out_of_range if the matrix size is invalid
+   * @throws std::out_of_range if the matrix size is invalid or a weight does
+   * not fit the weight type
    */
   void loadGraphFromFile(const string &filename);
 
+  /**
+   * Renumbers the vertices of the matrix in the given order, on top of the
+   * previous renumbering. The version changes, the original numbers stay.
+   *
+   * @param order the new order of the vertices
+   */
+  void Reorder(VertexOrder order);
+
+  /**
+   * @return the original number of every internal vertex
+   */
+  const VertexPermutation &Permutation() const { return permutation_; }
+
+  /**
+   * Inserts, updates or deletes the edge from one vertex to another. Only this
+   * direction changes, so an undirected graph needs both directions set.
+   *
+   * @param from the original number of the start vertex, from 0
+   * @param to the original number of the end vertex, from 0
+   * @param weight the new weight, 0 deletes the edge
+   *
+   * @throws std::out_of_range if a vertex does not exist
+   * @throws std::invalid_argument if the weight is negative or the edge is a
+   * loop
+   */
+  void SetEdge(int from, int to, Weight weight);
+
+  /**
+   * Deletes the edge from one vertex to another if it exists.
+   *
+   * @param from the start vertex, from 0
+   * @param to the end vertex, from 0
+   *
+   * @throws std::out_of_range if a vertex does not exist
+   */
+  void RemoveEdge(int from, int to);
+
+  /**
+   * Returns a number that changes on every load and every edge change. The
+   * numbers are unique among all graphs of the process.
+   *
+   * @return the version of the graph
+   */
+  std::uint64_t Version() const;
+
   /**
    * Returns a vector of integers representing the neighbors of the given vertex
    * for queue-based algorithms.
@@ -67,6 +237,13 @@ class Graph {
    */
   bool IsDirected() const;
 
+  /**
+   * Returns the properties computed when the graph was loaded.
+   *
+   * @return the properties of the graph
+   */
+  const BasicGraphProperties<Weight> &Properties() const;
+
   /**
    * Exports the graph to a DOT file with the given filename.
    *
@@ -90,18 +267,38 @@ class Graph {
    *
    * @return The weight of the graph.
    */
-  int getGraphWeight();
-
-  int getGraphWeight() const;
+  Distance getGraphWeight() const;
 
  private:
   std::string matrixToDot(bool directed) const;
 
+  void UpdateProperties();
+
+  void RefreshProperties();
+
   bool fileExists(const std::string &filename) const;
 
-  matrix adjacency_matrix_;
+  BasicMatrix<Weight> adjacency_matrix_;
+  BasicGraphProperties<Weight> properties_;
+  VertexPermutation permutation_;
+  std::uint64_t version_ = 0;
+
+  // Счётчики, по которым свойства обновляются при изменении одного ребра.
+  std::map<Weight, long long> weight_counts_;
+  std::map<int, int> degree_counts_;
+  vector<int> degrees_;
+  long long arcs_ = 0;
+  long long asymmetric_pairs_ = 0;
 };
 
+extern template class BasicGraph<std::uint8_t>;
+extern template class BasicGraph<std::uint16_t>;
+extern template class BasicGraph<int>;
+extern template class BasicGraph<std::int64_t>;
+extern template class BasicGraph<float>;
+
+using Graph = BasicGraph<int>;
+
 }  // namespace s21
 
 #endif  // SRC_MODEL_S21_GRAPH_H_
\ No newline at end of file
@@ -1,184 +1,54 @@
 #include "s21_graph_algorithms.h"
 namespace s21 {
-vector<int> GraphAlgorithms::DepthFirstSearch(Graph &graph, const int start) {
-  if (start >= graph.size() || start < 0) {
-    throw std::invalid_argument(
-        "[ [Wrong argument] ] :: Graph or start vertex is invalid\n");
-  }
-  vector<bool> visited(graph.size(), false);
-  vector<int> passed_path;
-  Stack<int> vertices_stack;
-
-  vertices_stack.push(start);
-
-  while (!vertices_stack.empty()) {
-    int vertex = vertices_stack.top();
-    vertices_stack.pop();
-
-    if (!visited[vertex]) {
-      visited[vertex] = true;
-      passed_path.push_back(vertex + 1);
 
-      for (int neighbor : graph.neighborsFromStack(vertex)) {
-        if (!visited[neighbor]) {
-          vertices_stack.push(neighbor);
-        }
-      }
-    }
-  }
-  return passed_path;
+template <typename Weight>
+vector<int> BasicGraphAlgorithms<Weight>::DepthFirstSearch(
+    const BasicGraph<Weight> &graph, const int start) {
+  Trace::Scope trace("GraphAlgorithms::DepthFirstSearch", "V", graph.size(),
+                     "E", graph.Properties().edge_count);
+  return ViewAlgorithms::DepthFirstSearch(graph, start);
 }
 
-vector<int> GraphAlgorithms::BreadthFirstSearch(Graph &graph, int start) {
-  if (start >= graph.size() || start < 0) {
-    throw std::out_of_range(
-        "[ [Wrong argument] ] :: Graph or start vertex is invalid\n");
-  }
-  vector<bool> visited(graph.size(), false);
-  vector<int> passed_path;
-  Queue<int> vertices_queue;
-
-  vertices_queue.push(start);
-
-  while (!vertices_queue.empty()) {
-    int vertex = vertices_queue.front();
-    vertices_queue.pop();
-
-    if (!visited[vertex]) {
-      visited[vertex] = true;
-      passed_path.push_back(vertex + 1);
-
-      for (int neighbor : graph.neighborsFromQueue(vertex)) {
-        if (!visited[neighbor]) {
-          vertices_queue.push(neighbor);
-        }
-      }
-    }
-  }
-  return passed_path;
+template <typename Weight>
+vector<int> BasicGraphAlgorithms<Weight>::BreadthFirstSearch(
+    const BasicGraph<Weight> &graph, int start) {
+  Trace::Scope trace("GraphAlgorithms::BreadthFirstSearch", "V", graph.size(),
+                     "E", graph.Properties().edge_count);
+  return ViewAlgorithms::BreadthFirstSearch(graph, start);
 }
 
-int GraphAlgorithms::GetShortestPathBetweenVertices(Graph &graph, int vertex1,
-                                                    int vertex2) {
-  if (vertex1 < 1 || vertex1 > graph.size() || vertex2 < 1 ||
-      vertex2 > graph.size()) {
-    throw std::invalid_argument(
-        "[ [Wrong argument] ] :: Graph or start/end vertex is invalid\n");
-  }
-  // Счет идет с 0, но пользователь задает с 1, для этого уменьшаем на 1.
-  vertex1--;
-  vertex2--;
-
-  vector<int> distance(graph.size(), std::numeric_limits<int>::max());
-  vector<bool> visited(graph.size(), false);
-  Queue<int> vertex_queue;
-  distance[vertex1] = 0;
-  vertex_queue.push(vertex1);
-
-  while (!vertex_queue.empty()) {
-    int process_vertex = vertex_queue.front();
-    vertex_queue.pop();
-
-    if (visited.at(process_vertex)) {
-      continue;
-    }
-    visited[process_vertex] = true;
-
-    for (int i = 0; i < graph.size(); ++i) {
-      if (graph[process_vertex][i] != 0 && !visited[i]) {
-        int new_distance = distance[process_vertex] + graph[process_vertex][i];
-        if (new_distance < distance[i]) {
-          distance[i] = new_distance;
-          vertex_queue.push(i);
-        }
-      }
-    }
-  }
-
-  return distance[vertex2];
+template <typename Weight>
+typename BasicGraphAlgorithms<Weight>::Distance
+BasicGraphAlgorithms<Weight>::GetShortestPathBetweenVertices(
+    const BasicGraph<Weight> &graph, int vertex1, int vertex2) {
+  Trace::Scope trace("GraphAlgorithms::GetShortestPathBetweenVertices", "V",
+                     graph.size(), "E", graph.Properties().edge_count);
+  return ViewAlgorithms::GetShortestPathBetweenVertices(graph, vertex1,
+                                                        vertex2);
 }
 
-matrix GraphAlgorithms::GetShortestPathsBetweenAllVertices(Graph &graph) {
-  if (graph.size() == 0) {
-    throw std::invalid_argument(
-        "[ [Wrong argument] ] :: Graph or start vertex is invalid\n");
-  }
-  auto kinf = std::numeric_limits<int>::max();
-  matrix distance(graph.size(), vector<int>(graph.size(), kinf));
-
-  // Инициализация матрицы distance ребрами графа
-  for (int i = 0; i < graph.size(); ++i) {
-    for (int j = 0; j < graph.size(); ++j) {
-      if (i == j) {
-        distance[i][j] = 0;
-      } else if (graph[i][j] != 0) {
-        distance[i][j] = graph[i][j];
-      }
-    }
-  }
-
-  // Алгоритм Флойда-Уоршелла
-  for (int k = 0; k < graph.size(); ++k) {
-    for (int i = 0; i < graph.size(); ++i) {
-      for (int j = 0; j < graph.size(); ++j) {
-        if (distance[i][k] != kinf && distance[k][j] != kinf &&
-            distance[i][k] + distance[k][j] < distance[i][j]) {
-          distance[i][j] = distance[i][k] + distance[k][j];
-        }
-      }
-    }
-  }
-
-  return distance;
+template <typename Weight>
+BasicMatrix<typename BasicGraphAlgorithms<Weight>::Distance>
+BasicGraphAlgorithms<Weight>::GetShortestPathsBetweenAllVertices(
+    const BasicGraph<Weight> &graph) {
+  Trace::Scope trace("GraphAlgorithms::GetShortestPathsBetweenAllVertices",
+                     "V", graph.size(), "E", graph.Properties().edge_count);
+  return ViewAlgorithms::GetShortestPathsBetweenAllVertices(graph);
 }
 
-matrix GraphAlgorithms::GetLeastSpanningTree(const Graph &graph) {
-  int size = graph.size();
-  if (size == 0) {
-    throw std::invalid_argument("[ [Wrong argument] ] :: Graph is invalid\n");
-  }
-  vector<bool> visited(size, false);
-  vector<int> distances(size, kInf);
-  vector<int> parents(size, -1);
-
-  matrix spanning_tree(size, vector<int>(size, 0));
-
-  distances[0] = 0;
-
-  for (int i = 0; i < size - 1; ++i) {
-    int min_distance = kInf;
-    int min_vertex = -1;
-
-    for (int j = 0; j < size; ++j) {
-      if (!visited[j] && distances[j] < min_distance) {
-        min_distance = distances[j];
-        min_vertex = j;
-      }
-    }
-
-    visited.at(min_vertex) = true;
-
-    if (parents.at(min_vertex) != -1) {
-      spanning_tree[parents[min_vertex]][min_vertex] =
-          graph[parents[min_vertex]][min_vertex];
-      spanning_tree[min_vertex][parents[min_vertex]] =
-          graph[parents[min_vertex]][min_vertex];
-    }
-
-    for (int j = 0; j < size; ++j) {
-      if (!visited[j] && graph[min_vertex][j] > 0 &&
-          graph[min_vertex][j] < distances[j]) {
-        parents[j] = min_vertex;
-        distances[j] = graph[min_vertex][j];
-      }
-    }
-  }
-
-  return spanning_tree;
+template <typename Weight>
+BasicMatrix<Weight> BasicGraphAlgorithms<Weight>::GetLeastSpanningTree(
+    const BasicGraph<Weight> &graph) {
+  Trace::Scope trace("GraphAlgorithms::GetLeastSpanningTree", "V",
+                     graph.size(), "E", graph.Properties().edge_count);
+  return ViewAlgorithms::GetLeastSpanningTree(graph);
 }
 
-int GraphAlgorithms::CalculateGraphWeight(const matrix &graph) {
-  int weight = 0;
+template <typename Weight>
+typename BasicGraphAlgorithms<Weight>::Distance
+BasicGraphAlgorithms<Weight>::CalculateGraphWeight(
+    const BasicMatrix<Weight> &graph) {
+  Distance weight = 0;
   int size = graph.size();
 
   for (int i = 0; i < size; ++i) {
@@ -190,11 +60,52 @@ int GraphAlgorithms::CalculateGraphWeight(const matrix &graph) {
   return weight;
 }
 
-TsmResult GraphAlgorithms::SolveTravelingSalesmanProblem(Graph &graph) {
+template class BasicGraphAlgorithms<std::uint8_t>;
+template class BasicGraphAlgorithms<std::uint16_t>;
+template class BasicGraphAlgorithms<int>;
+template class BasicGraphAlgorithms<std::int64_t>;
+template class BasicGraphAlgorithms<float>;
+
+TsmResult GraphAlgorithms::SolveTravelingSalesmanProblem(
+    const Graph &graph, const TsmOptions &options) {
   if (graph.size() == 0) {
     throw std::invalid_argument("[ [Wrong argument] ] :: Graph is invalid\n");
   }
-  s21::AntColony ant_colony(graph);
-  return ant_colony.SolveSalesmansProblem();
+  S21_STATS_SCOPE("SolveTravelingSalesmanProblem");
+  Trace::Scope trace("GraphAlgorithms::SolveTravelingSalesmanProblem", "V",
+                     graph.size(), "E", graph.Properties().edge_count);
+  // Контрольные точки есть только у колоний, и автоматический выбор их
+  // сохраняет.
+  const bool kCheckpoints =
+      !options.checkpoint_path.empty() || !options.resume_from.empty();
+  bool exact = options.solver == TsmSolver::kHeldKarp ||
+               (options.solver == TsmSolver::kAuto && !kCheckpoints &&
+                graph.size() <= HeldKarp::kAutoMaxVertices);
+  // Решатели работают во внутренней нумерации перенумерованного графа, и
+  // туры возвращаются в исходную и в результате, и в колбэке.
+  const VertexPermutation &kPermutation = graph.Permutation();
+  auto to_original = [&kPermutation](TsmResult &tour) {
+    for (int &vertex : tour.path) vertex = kPermutation.ToOriginal(vertex);
+  };
+  TsmOptions solver_options = options;
+  if (options.on_progress && !kPermutation.IsIdentity()) {
+    solver_options.on_progress = [&options,
+                                  &to_original](const TsmProgress &progress) {
+      TsmProgress original = progress;
+      to_original(original.best);
+      options.on_progress(original);
+    };
+  }
+  TsmResult result;
+  if (exact) {
+    result = HeldKarp(graph).Solve(solver_options);
+  } else if (options.solver == TsmSolver::kIslands) {
+    result = IslandModel(graph).Solve(solver_options);
+  } else {
+    s21::AntColony ant_colony(graph, options.colony);
+    result = ant_colony.SolveSalesmansProblem(solver_options);
+  }
+  to_original(result);
+  return result;
 }
 }  // namespace s21
\ No newline at end of file
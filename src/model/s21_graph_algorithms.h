@@ -10,13 +10,27 @@
 
 #include "dependencies/s21_queue.h"
 #include "dependencies/s21_stack.h"
+#include "s21_algorithm_stats.h"
 #include "s21_ant_algorithm.h"
 #include "s21_graph.h"
+#include "s21_held_karp.h"
+#include "s21_island_model.h"
+#include "s21_trace.h"
+#include "s21_view_algorithms.h"
 
 namespace s21 {
 
-class GraphAlgorithms {
+/**
+ * The algorithms on graphs of any weight type of BasicGraph, compiled in
+ * s21_graph_algorithms.cpp for the same types. Path lengths have the type
+ * WeightTraits<Weight>::Distance and saturate to its kInfinity instead of
+ * overflowing.
+ */
+template <typename Weight>
+class BasicGraphAlgorithms {
  public:
+  using Distance = typename WeightTraits<Weight>::Distance;
+
   /**
    * Performs a depth-first search on a given graph starting from a specified
    * vertex.
@@ -30,7 +44,8 @@ class GraphAlgorithms {
    * @throws std::invalid_argument if the start vertex is invalid or graph not
    * found
    */
-  static vector<int> DepthFirstSearch(Graph &graph, const int start);
+  static vector<int> DepthFirstSearch(const BasicGraph<Weight> &graph,
+                                      const int start);
 
   /**
    * Performs a breadth-first search on the given graph starting from the
@@ -44,7 +59,8 @@ class GraphAlgorithms {
    *
    * @throws std::out_of_range if the start vertex is invalid or graph not found
    */
-  static vector<int> BreadthFirstSearch(Graph &graph, int start);
+  static vector<int> BreadthFirstSearch(const BasicGraph<Weight> &graph,
+                                        int start);
 
   /**
    * Calculates the shortest path between two vertices in a graph.
@@ -53,12 +69,13 @@ class GraphAlgorithms {
    * @param vertex1 the starting vertex
    * @param vertex2 the ending vertex
    *
-   * @return the shortest path between vertex1 and vertex2
+   * @return the shortest path between vertex1 and vertex2, kInfinity if
+   * there is none
    *
    * @throws std::invalid_argument if the graph or start/end vertex is invalid
    */
-  static int GetShortestPathBetweenVertices(Graph &graph, int vertex1,
-                                            int vertex2);
+  static Distance GetShortestPathBetweenVertices(
+      const BasicGraph<Weight> &graph, int vertex1, int vertex2);
 
   /**
    * Calculates the shortest paths between all vertices in a given graph using
@@ -67,11 +84,12 @@ class GraphAlgorithms {
    * @param graph The graph for which to calculate the shortest paths.
    *
    * @return A matrix representing the shortest distances between each pair of
-   * vertices.
+   * vertices, kInfinity for missing paths.
    *
    * @throws None.
    */
-  static matrix GetShortestPathsBetweenAllVertices(Graph &graph);
+  static BasicMatrix<Distance> GetShortestPathsBetweenAllVertices(
+      const BasicGraph<Weight> &graph);
 
   /**
    * GetLeastSpanningTree function calculates the minimum spanning tree of a
@@ -83,7 +101,8 @@ class GraphAlgorithms {
    *
    * @throws None
    */
-  static matrix GetLeastSpanningTree(const Graph &graph);
+  static BasicMatrix<Weight> GetLeastSpanningTree(
+      const BasicGraph<Weight> &graph);
 
   /**
    * Calculates the weight of a graph represented by a matrix.
@@ -94,12 +113,31 @@ class GraphAlgorithms {
    *
    * @throws None
    */
-  static int CalculateGraphWeight(const matrix &graph);
+  static Distance CalculateGraphWeight(const BasicMatrix<Weight> &graph);
+};
 
+extern template class BasicGraphAlgorithms<std::uint8_t>;
+extern template class BasicGraphAlgorithms<std::uint16_t>;
+extern template class BasicGraphAlgorithms<int>;
+extern template class BasicGraphAlgorithms<std::int64_t>;
+extern template class BasicGraphAlgorithms<float>;
+
+/**
+ * The algorithms on graphs of int weights, including the salesman problem
+ * whose solvers work with int weights only.
+ */
+class GraphAlgorithms : public BasicGraphAlgorithms<int> {
+ public:
   /**
-   * Solve the Traveling Salesman Problem using the Ant Colony algorithm.
+   * Solve the Traveling Salesman Problem. Graphs with up to
+   * HeldKarp::kAutoMaxVertices vertices are solved exactly by the Held-Karp
+   * algorithm, larger ones and runs with checkpoints by the Ant Colony
+   * algorithm; options.solver overrides the choice and also selects the
+   * island model of the Ant Colony algorithm.
    *
    * @param graph the graph representing the cities and distances
+   * @param options time budget, iteration and stall limits, cancellation
+   * token and progress callback of the run
    *
    * @return the optimal solution to the Traveling Salesman Problem
    *
@@ -108,7 +146,22 @@ class GraphAlgorithms {
    * @field path the optimal path
    *
    */
-  static TsmResult SolveTravelingSalesmanProblem(Graph &graph);
+  static TsmResult SolveTravelingSalesmanProblem(
+      const Graph &graph, const TsmOptions &options = TsmOptions());
+
+  /**
+   * Solve the Traveling Salesman Problem on any graph view of int weights.
+   * The solvers keep V^2 tables of distances and pheromones anyway, so the
+   * view is copied into a dense graph first.
+   */
+  template <typename View>
+  static TsmResult SolveTravelingSalesmanProblem(
+      const View &graph, const TsmOptions &options = TsmOptions()) {
+    static_assert(
+        std::is_same_v<typename GraphViewTraits<View>::Weight, int>,
+        "The salesman solvers work with int weights only");
+    return SolveTravelingSalesmanProblem(MakeDenseGraph(graph), options);
+  }
 };
 
 }  // namespace s21
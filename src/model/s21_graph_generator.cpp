@@ -0,0 +1,179 @@
+#include "s21_graph_generator.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <fstream>
+#include <stdexcept>
+#include <thread>
+
+namespace s21 {
+
+namespace {
+// Независимые потоки случайных чисел для наличия ребра, веса и координат.
+const std::uint64_t kEdgeStream = 1;
+const std::uint64_t kWeightStream = 2;
+const std::uint64_t kPointStream = 3;
+// Размер блока строк, который форматирует один поток за раз.
+const std::size_t kBlockCells = 1 << 22;
+
+std::uint64_t SplitMix64(std::uint64_t value) {
+  value += 0x9e3779b97f4a7c15ull;
+  value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ull;
+  value = (value ^ (value >> 27)) * 0x94d049bb133111ebull;
+  return value ^ (value >> 31);
+}
+}  // namespace
+
+GraphGenerator::GraphGenerator(const GeneratorOptions &options)
+    : options_(options) {
+  if (options_.vertices < 1) {
+    throw std::invalid_argument(
+        "[ [Wrong argument] ] :: Number of vertices must be > 0\n");
+  }
+  if (options_.min_weight < 1 || options_.max_weight < options_.min_weight) {
+    throw std::invalid_argument(
+        "[ [Wrong argument] ] :: Invalid range of weights\n");
+  }
+  if (options_.density < 0 || options_.density > 1) {
+    throw std::invalid_argument(
+        "[ [Wrong argument] ] :: Density must be from 0 to 1\n");
+  }
+  if (options_.threads == 0)
+    options_.threads = std::max(1u, std::thread::hardware_concurrency());
+
+  grid_width_ = static_cast<int>(std::ceil(std::sqrt(options_.vertices)));
+
+  if (options_.model == GeneratorModel::kPowerLaw) {
+    if (options_.exponent <= 2 || options_.average_degree <= 0) {
+      throw std::invalid_argument(
+          "[ [Wrong argument] ] :: Power law needs exponent > 2 and degree > "
+          "0\n");
+    }
+    // Модель Чунга-Лу: ожидаемая степень вершины i пропорциональна
+    // (i + 1)^(-1 / (exponent - 1)).
+    expected_degree_.resize(options_.vertices);
+    double sum = 0;
+    for (int i = 0; i < options_.vertices; ++i) {
+      expected_degree_[i] = std::pow(i + 1.0, -1.0 / (options_.exponent - 1));
+      sum += expected_degree_[i];
+    }
+    const double kScale = options_.average_degree * options_.vertices / sum;
+    for (double &degree : expected_degree_) degree *= kScale;
+    power_law_total_ = options_.average_degree * options_.vertices;
+  }
+}
+
+std::uint64_t GraphGenerator::Hash(std::uint64_t a, std::uint64_t b,
+                                   std::uint64_t stream) const {
+  return SplitMix64(SplitMix64(SplitMix64(options_.seed ^ stream) ^ a) ^ b);
+}
+
+/**
+ * Returns a uniform number from [0, 1) bound to the vertex pair. For
+ * undirected graphs the pair is unordered, so both cells get the same value.
+ */
+double GraphGenerator::Uniform(int from, int to, std::uint64_t stream) const {
+  if (!options_.directed && from > to) std::swap(from, to);
+  return (Hash(from, to, stream) >> 11) * 0x1.0p-53;
+}
+
+bool GraphGenerator::HasEdge(int from, int to) const {
+  switch (options_.model) {
+    case GeneratorModel::kErdosRenyi:
+      return Uniform(from, to, kEdgeStream) < options_.density;
+    case GeneratorModel::kGrid: {
+      const int kRowDiff = std::abs(from / grid_width_ - to / grid_width_);
+      const int kColDiff = std::abs(from % grid_width_ - to % grid_width_);
+      if (kRowDiff + kColDiff == 1) return true;
+      return kRowDiff == 1 && kColDiff == 1 &&
+             Uniform(from, to, kEdgeStream) < options_.density;
+    }
+    case GeneratorModel::kPowerLaw: {
+      const double kProbability = expected_degree_[from] *
+                                  expected_degree_[to] / power_law_total_;
+      return Uniform(from, to, kEdgeStream) < kProbability;
+    }
+    case GeneratorModel::kEuclidean:
+      return true;
+  }
+  return false;
+}
+
+int GraphGenerator::RandomWeight(int from, int to) const {
+  if (options_.model == GeneratorModel::kEuclidean) {
+    const double kSide = options_.max_weight / std::sqrt(2.0);
+    auto coordinate = [this, kSide](int vertex, std::uint64_t axis) {
+      return (Hash(vertex, axis, kPointStream) >> 11) * 0x1.0p-53 * kSide;
+    };
+    const double kDistance =
+        std::hypot(coordinate(from, 0) - coordinate(to, 0),
+                   coordinate(from, 1) - coordinate(to, 1));
+    return std::max(options_.min_weight,
+                    static_cast<int>(std::lround(kDistance)));
+  }
+  const int kRange = options_.max_weight - options_.min_weight + 1;
+  return options_.min_weight +
+         static_cast<int>(Uniform(from, to, kWeightStream) * kRange);
+}
+
+int GraphGenerator::Weight(int from, int to) const {
+  if (from == to || !HasEdge(from, to)) return 0;
+  return RandomWeight(from, to);
+}
+
+void GraphGenerator::AppendRow(int row, std::string &out) const {
+  char buffer[16];
+  for (int col = 0; col < options_.vertices; ++col) {
+    const int kWeight = Weight(row, col);
+    if (kWeight == 0) {
+      out += "0 ";
+      continue;
+    }
+    auto converted = std::to_chars(buffer, buffer + sizeof(buffer), kWeight);
+    out.append(buffer, converted.ptr);
+    out += ' ';
+  }
+  out.back() = '\n';
+}
+
+void GraphGenerator::WriteAdjacencyMatrix(std::ostream &stream) const {
+  const int kVertices = options_.vertices;
+  const int kBlockRows = static_cast<int>(
+      std::max<std::size_t>(1, kBlockCells / static_cast<std::size_t>(kVertices)));
+  const unsigned kThreads = options_.threads;
+
+  stream << kVertices << '\n';
+  // В памяти одновременно находится не больше kThreads блоков строк.
+  std::vector<std::string> blocks(kThreads);
+  for (int first = 0; first < kVertices;
+       first += kBlockRows * static_cast<int>(kThreads)) {
+    std::vector<std::thread> workers;
+    auto format_block = [this, &blocks, first, kBlockRows,
+                         kVertices](unsigned index) {
+      std::string &block = blocks[index];
+      block.clear();
+      const int kBegin = first + static_cast<int>(index) * kBlockRows;
+      const int kEnd = std::min(kVertices, kBegin + kBlockRows);
+      for (int row = kBegin; row < kEnd; ++row) AppendRow(row, block);
+    };
+    for (unsigned index = 1; index < kThreads; ++index)
+      workers.emplace_back(format_block, index);
+    format_block(0);
+    for (auto &worker : workers) worker.join();
+    for (const auto &block : blocks) stream.write(block.data(), block.size());
+  }
+  if (!stream) {
+    throw std::runtime_error("[ [File error] ] :: Graph was not written\n");
+  }
+}
+
+void GraphGenerator::WriteAdjacencyMatrix(const std::string &filename) const {
+  std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+  if (!file.is_open()) {
+    throw std::runtime_error("[ [Wrong argument] ] :: File was not created\n");
+  }
+  WriteAdjacencyMatrix(file);
+}
+
+}  // namespace s21
@@ -0,0 +1,104 @@
+#ifndef SRC_MODEL_S21_GRAPH_GENERATOR_H_
+#define SRC_MODEL_S21_GRAPH_GENERATOR_H_
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace s21 {
+
+enum class GeneratorModel { kErdosRenyi, kGrid, kPowerLaw, kEuclidean };
+
+/**
+ * Settings of a synthetic graph.
+ *
+ * @field model kErdosRenyi - every edge exists with probability density;
+ * kGrid - road-like grid where every vertex is linked to its four neighbours
+ * and a share density of the diagonals; kPowerLaw - Chung-Lu graph with a
+ * power-law degree distribution; kEuclidean - complete graph of random points
+ * on a plane, weights are rounded distances
+ * @field vertices the number of vertices
+ * @field density edge probability (kErdosRenyi) or diagonal share (kGrid)
+ * @field average_degree expected degree of a kPowerLaw vertex
+ * @field exponent exponent of the kPowerLaw degree distribution, > 2
+ * @field min_weight the smallest edge weight, > 0
+ * @field max_weight the largest edge weight, also the side of the kEuclidean
+ * square
+ * @field directed generate every direction of an edge independently
+ * @field seed the same seed always gives the same graph
+ * @field threads worker threads formatting rows, zero means all cores
+ */
+struct GeneratorOptions {
+  GeneratorModel model = GeneratorModel::kErdosRenyi;
+  int vertices = 0;
+  double density = 0.1;
+  double average_degree = 8;
+  double exponent = 2.5;
+  int min_weight = 1;
+  int max_weight = 100;
+  bool directed = false;
+  std::uint64_t seed = 1;
+  unsigned threads = 0;
+};
+
+/**
+ * Generator of large synthetic graphs in the adjacency matrix format read by
+ * Graph::loadGraphFromFile. Every cell is a pure function of the seed and the
+ * vertex pair, so rows are produced independently by several threads and
+ * streamed to the output in blocks, without keeping the matrix in memory.
+ */
+class GraphGenerator {
+ public:
+  /**
+   * @param options the settings of the graph
+   *
+   * @throws std::invalid_argument if the settings are inconsistent
+   */
+  explicit GraphGenerator(const GeneratorOptions &options);
+
+  /**
+   * Returns the weight of the edge between two vertices, 0 if there is none.
+   *
+   * @param from the first vertex, from 0
+   * @param to the second vertex, from 0
+   *
+   * @return the weight of the edge
+   */
+  int Weight(int from, int to) const;
+
+  /**
+   * Writes the graph in the adjacency matrix format.
+   *
+   * @param stream the output stream
+   *
+   * @throws std::runtime_error if writing fails
+   */
+  void WriteAdjacencyMatrix(std::ostream &stream) const;
+
+  /**
+   * Writes the graph in the adjacency matrix format to a file.
+   *
+   * @param filename the name of the file
+   *
+   * @throws std::runtime_error if the file could not be created
+   */
+  void WriteAdjacencyMatrix(const std::string &filename) const;
+
+ private:
+  std::uint64_t Hash(std::uint64_t a, std::uint64_t b,
+                     std::uint64_t stream) const;
+  double Uniform(int from, int to, std::uint64_t stream) const;
+  bool HasEdge(int from, int to) const;
+  int RandomWeight(int from, int to) const;
+  void AppendRow(int row, std::string &out) const;
+
+  GeneratorOptions options_;
+  int grid_width_ = 1;
+  double power_law_total_ = 0;
+  std::vector<double> expected_degree_;
+};
+
+}  // namespace s21
+
+#endif  // SRC_MODEL_S21_GRAPH_GENERATOR_H_
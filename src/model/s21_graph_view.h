@@ -0,0 +1,106 @@
+#ifndef SRC_MODEL_S21_GRAPH_VIEW_H_
+#define SRC_MODEL_S21_GRAPH_VIEW_H_
+
+#include <type_traits>
+#include <utility>
+
+#include "s21_graph.h"
+#include "s21_packed_matrix.h"
+
+namespace s21 {
+
+/**
+ * A graph view is any type that gives the algorithms of ViewAlgorithms
+ * access to a graph without virtual calls:
+ *
+ *   using WeightType = ...;                       the type of the weights
+ *   int size() const;                             the number of vertices
+ *   template <typename Visit>
+ *   void ForEachNeighbour(int vertex, Visit visit) const;
+ *                                                 calls visit(to, weight) for
+ *                                                 every edge from the vertex,
+ *                                                 in increasing order of to
+ *
+ * and optionally, for storages with O(1) access to any pair of vertices,
+ *
+ *   WeightType Cell(int from, int to) const;      0 if there is no edge
+ *
+ * and, for undirected storages that keep every edge once,
+ *
+ *   static constexpr bool kSymmetric = true;
+ *
+ * and, for storages that renumber their vertices (see s21_vertex_order.h),
+ *
+ *   const VertexPermutation &Permutation() const;
+ *                                                 the original number of
+ *                                                 every vertex of size() and
+ *                                                 ForEachNeighbour
+ *
+ * BasicGraph, CompressedGraph and SymmetricGraph are views. GraphViewTraits
+ * checks the interface at compile time and tells whether the view is dense
+ * and symmetric.
+ */
+template <typename View, typename = void>
+struct HasCellAccess : std::false_type {};
+
+template <typename View>
+struct HasCellAccess<View, std::void_t<decltype(std::declval<const View &>()
+                                                    .Cell(0, 0))>>
+    : std::true_type {};
+
+template <typename View, typename = void>
+struct HasSymmetricStorage : std::false_type {};
+
+template <typename View>
+struct HasSymmetricStorage<View, std::void_t<decltype(View::kSymmetric)>>
+    : std::bool_constant<View::kSymmetric> {};
+
+template <typename View, typename = void>
+struct HasPermutation : std::false_type {};
+
+template <typename View>
+struct HasPermutation<View, std::void_t<decltype(std::declval<const View &>()
+                                                     .Permutation())>>
+    : std::true_type {};
+
+template <typename View>
+struct GraphViewTraits {
+  using Weight = typename View::WeightType;
+  using Distance = typename WeightTraits<Weight>::Distance;
+
+  // Плотные представления дают алгоритмам доступ к любой паре вершин.
+  static constexpr bool kDense = HasCellAccess<View>::value;
+  // Симметричным представлениям результаты тоже отдаются упакованными.
+  static constexpr bool kSymmetric = HasSymmetricStorage<View>::value;
+  // Алгоритмы переводят номера вершин таких представлений в исходные.
+  static constexpr bool kRenumbered = HasPermutation<View>::value;
+
+  static_assert(
+      std::is_convertible_v<decltype(std::declval<const View &>().size()),
+                            int>,
+      "A graph view needs int size() const");
+};
+
+/**
+ * Copies a view into a dense graph with the same weights and numbering.
+ */
+template <typename View>
+BasicGraph<typename GraphViewTraits<View>::Weight> MakeDenseGraph(
+    const View &view) {
+  using Weight = typename GraphViewTraits<View>::Weight;
+  BasicMatrix<Weight> adjacency(view.size(), vector<Weight>(view.size(), 0));
+  for (int from = 0; from < view.size(); ++from) {
+    view.ForEachNeighbour(from, [&](int to, Weight weight) {
+      adjacency[from][to] = weight;
+    });
+  }
+  if constexpr (GraphViewTraits<View>::kRenumbered) {
+    return BasicGraph<Weight>(std::move(adjacency), view.Permutation());
+  } else {
+    return BasicGraph<Weight>(std::move(adjacency));
+  }
+}
+
+}  // namespace s21
+
+#endif  // SRC_MODEL_S21_GRAPH_VIEW_H_
@@ -0,0 +1,218 @@
+#include "s21_held_karp.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+
+#include "s21_algorithm_stats.h"
+#include "s21_trace.h"
+
+namespace s21 {
+
+namespace {
+// Минимальный объём работы слоя, ради которого стоит запускать потоки.
+const std::uint64_t kParallelThreshold = 1 << 14;
+
+std::uint64_t Binomial(int n, int k) {
+  if (k < 0 || k > n) return 0;
+  std::uint64_t result = 1;
+  for (int i = 1; i <= k; ++i) result = result * (n - k + i) / i;
+  return result;
+}
+
+/**
+ * Returns the subset of the given size with the given rank in increasing
+ * numeric order (the order in which NextSubset enumerates subsets).
+ */
+std::uint32_t NthSubset(int bits, std::uint64_t rank) {
+  std::uint32_t mask = 0;
+  int position = 31;
+  for (int k = bits; k > 0; --k) {
+    while (Binomial(position, k) > rank) --position;
+    mask |= 1u << position;
+    rank -= Binomial(position, k);
+    --position;
+  }
+  return mask;
+}
+
+std::uint32_t NextSubset(std::uint32_t mask) {
+  const std::uint32_t kLowest = mask & (~mask + 1);
+  const std::uint32_t kRipple = mask + kLowest;
+  return (((kRipple ^ mask) >> 2) / kLowest) | kRipple;
+}
+}  // namespace
+
+HeldKarp::HeldKarp(const Graph &graph, unsigned threads)
+    : size_(graph.size()),
+      threads_(threads ? threads
+                       : std::max(1u, std::thread::hardware_concurrency())),
+      cost_(static_cast<std::size_t>(graph.size()) * graph.size()) {
+  if (size_ > kMaxVertices) {
+    throw std::out_of_range(
+        "[ [Wrong argument] ] :: Graph is too large for the exact solver\n");
+  }
+  // Ячейки шириной 8 байт выбираются только для длинных весов, и тогда
+  // таблица проверяется в Solve.
+  if (TableBytes(sizeof(std::int32_t)) > kMaxTableBytes) {
+    throw std::out_of_range(
+        "[ [Wrong argument] ] :: Held-Karp table does not fit in memory\n");
+  }
+  for (int row = 0; row != size_; ++row) {
+    const auto kRow = graph[row];
+    for (int col = 0; col != size_; ++col)
+      cost_[row * size_ + col] = row == col ? 0 : kRow[col];
+  }
+}
+
+TsmResult HeldKarp::Solve(const TsmOptions &options) const {
+  if (!options.checkpoint_path.empty() || !options.resume_from.empty()) {
+    throw std::invalid_argument(
+        "[ [Wrong argument] ] :: Held-Karp solver takes no checkpoints\n");
+  }
+  S21_STATS_SCOPE("HeldKarp");
+  // Оценка сверху длины любого пути, чтобы выбрать тип ячеек таблицы.
+  long long bound = 0;
+  for (int row = 0; row != size_; ++row)
+    bound += *std::max_element(cost_.begin() + row * size_,
+                               cost_.begin() + (row + 1) * size_);
+  if (bound < std::numeric_limits<std::int32_t>::max())
+    return SolveWith<std::int32_t>(options);
+  if (TableBytes(sizeof(std::int64_t)) > kMaxTableBytes) {
+    throw std::out_of_range(
+        "[ [Wrong argument] ] :: Held-Karp table does not fit in memory\n");
+  }
+  return SolveWith<std::int64_t>(options);
+}
+
+template <typename Value>
+TsmResult HeldKarp::SolveWith(const TsmOptions &options) const {
+  TsmResult result;
+  result.distance = std::numeric_limits<double>::max();
+  if (size_ < 2) return result;
+
+  const auto kStart = std::chrono::steady_clock::now();
+  const int kCities = size_ - 1;
+  const Value kUnreachable = std::numeric_limits<Value>::max();
+  // dp[mask * kCities + j] - длина кратчайшего пути из вершины 0 через
+  // вершины mask, заканчивающегося в вершине j + 1.
+  std::vector<Value> table((std::size_t{1} << kCities) * kCities, kUnreachable);
+  S21_STATS_MEMORY(table.size() * sizeof(Value));
+  S21_STATS_PHASE("table");
+
+  for (int j = 0; j != kCities; ++j)
+    if (Cost(0, j + 1) > 0)
+      table[(std::size_t{1} << j) * kCities + j] = Cost(0, j + 1);
+
+  for (int layer = 2; layer <= kCities; ++layer) {
+    const auto kElapsed = std::chrono::steady_clock::now() - kStart;
+    if (options.cancellation.IsCancelled() ||
+        (options.time_budget.count() > 0 && kElapsed >= options.time_budget))
+      return result;
+    ProcessLayer(table, layer);
+    S21_STATS_ADD(iterations, 1);
+  }
+
+  const std::uint32_t kFull = (std::uint32_t{1} << kCities) - 1;
+  Value best = kUnreachable;
+  int last = -1;
+  for (int j = 0; j != kCities; ++j) {
+    const Value kPath = table[std::size_t{kFull} * kCities + j];
+    if (kPath == kUnreachable || Cost(j + 1, 0) == 0) continue;
+    if (kPath + Cost(j + 1, 0) < best) {
+      best = kPath + Cost(j + 1, 0);
+      last = j;
+    }
+  }
+  if (last < 0) return result;
+
+  // Восстановление маршрута в обратном порядке.
+  std::vector<int> reversed = {0, last + 1};
+  std::uint32_t mask = kFull;
+  while (mask != (std::uint32_t{1} << last)) {
+    const std::uint32_t kPrevious = mask ^ (std::uint32_t{1} << last);
+    const Value kValue = table[std::size_t{mask} * kCities + last];
+    for (int k = 0; k != kCities; ++k) {
+      if (!(kPrevious >> k & 1) || Cost(k + 1, last + 1) == 0) continue;
+      const Value kPath = table[std::size_t{kPrevious} * kCities + k];
+      if (kPath != kUnreachable && kPath + Cost(k + 1, last + 1) == kValue) {
+        last = k;
+        break;
+      }
+    }
+    reversed.push_back(last + 1);
+    mask = kPrevious;
+  }
+  reversed.push_back(0);
+
+  result.path.assign(reversed.rbegin(), reversed.rend());
+  result.distance = static_cast<double>(best);
+  if (options.on_progress) {
+    options.on_progress({1,
+                         std::chrono::duration_cast<std::chrono::milliseconds>(
+                             std::chrono::steady_clock::now() - kStart),
+                         result});
+  }
+  return result;
+}
+
+/**
+ * Fills the table for all subsets of the given size. Every subset depends only
+ * on the previous layer, so the layer is split between threads by rank.
+ *
+ * @param table the dynamic programming table
+ * @param layer the size of the subsets
+ */
+template <typename Value>
+void HeldKarp::ProcessLayer(std::vector<Value> &table, int layer) const {
+  const int kCities = size_ - 1;
+  const std::uint64_t kCount = Binomial(kCities, layer);
+  const std::uint64_t kWork = kCount * layer * layer;
+  S21_STATS_ADD(cells_updated, kCount * layer);
+  const unsigned kThreads =
+      kWork < kParallelThreshold
+          ? 1u
+          : static_cast<unsigned>(std::min<std::uint64_t>(threads_, kCount));
+
+  if (kThreads == 1) {
+    ProcessRange(table, NthSubset(layer, 0), kCount);
+    return;
+  }
+
+  std::vector<std::thread> workers;
+  const std::uint64_t kChunk = (kCount + kThreads - 1) / kThreads;
+  for (std::uint64_t first = 0; first < kCount; first += kChunk) {
+    const std::uint64_t kSize = std::min(kChunk, kCount - first);
+    workers.emplace_back([this, &table, layer, first, kSize] {
+      ProcessRange(table, NthSubset(layer, first), kSize);
+    });
+  }
+  for (auto &worker : workers) worker.join();
+}
+
+template <typename Value>
+void HeldKarp::ProcessRange(std::vector<Value> &table, std::uint32_t mask,
+                            std::uint64_t count) const {
+  Trace::Scope trace("HeldKarp::ProcessRange", "subsets",
+                     static_cast<std::int64_t>(count));
+  const int kCities = size_ - 1;
+  const Value kUnreachable = std::numeric_limits<Value>::max();
+  for (std::uint64_t i = 0; i != count; ++i, mask = NextSubset(mask)) {
+    Value *row = &table[std::size_t{mask} * kCities];
+    for (int j = 0; j != kCities; ++j) {
+      if (!(mask >> j & 1)) continue;
+      const std::uint32_t kPrevious = mask ^ (std::uint32_t{1} << j);
+      const Value *previous = &table[std::size_t{kPrevious} * kCities];
+      Value best = kUnreachable;
+      for (int k = 0; k != kCities; ++k) {
+        if (!(kPrevious >> k & 1) || previous[k] == kUnreachable) continue;
+        const int kEdge = Cost(k + 1, j + 1);
+        if (kEdge != 0 && previous[k] + kEdge < best)
+          best = previous[k] + kEdge;
+      }
+      row[j] = best;
+    }
+  }
+}
+
+}  // namespace s21
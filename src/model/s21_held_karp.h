@@ -0,0 +1,80 @@
+#ifndef SRC_MODEL_S21_HELD_KARP_H_
+#define SRC_MODEL_S21_HELD_KARP_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "s21_ant_algorithm.h"
+#include "s21_graph.h"
+
+namespace s21 {
+
+/**
+ * Exact Traveling Salesman solver based on the Held-Karp bitmask dynamic
+ * programming. The tour starts at vertex 0, the table stores all end vertices
+ * of one subset next to each other and subsets of the same size are processed
+ * in parallel.
+ */
+class HeldKarp {
+ public:
+  // Граница автоматического выбора точного решателя.
+  static constexpr int kAutoMaxVertices = 20;
+  static constexpr int kMaxVertices = 23;
+  // Предел памяти таблицы: 23 вершины с 32-битными ячейками занимают 369 МиБ.
+  static constexpr std::size_t kMaxTableBytes = std::size_t{512} << 20;
+
+  /**
+   * @param graph the graph representing the cities and distances
+   * @param threads the number of worker threads, zero means all cores
+   *
+   * @throws std::out_of_range if the graph has more than kMaxVertices vertices
+   * or its table would take more than kMaxTableBytes
+   */
+  explicit HeldKarp(const Graph &graph, unsigned threads = 0);
+
+  /**
+   * Finds the optimal tour. The cancellation token and the time budget of the
+   * options are checked between subset layers; an interrupted run returns no
+   * tour. The progress callback is called once with the optimal tour.
+   *
+   * @param options cancellation token, time budget and progress callback
+   *
+   * @return the optimal tour, or an empty path with the maximal distance if
+   * the graph has no Hamiltonian cycle
+   *
+   * @throws std::invalid_argument if the options ask for a checkpoint
+   * @throws std::out_of_range if the table of long weights does not fit in
+   * kMaxTableBytes
+   */
+  TsmResult Solve(const TsmOptions &options = TsmOptions()) const;
+
+ private:
+  template <typename Value>
+  TsmResult SolveWith(const TsmOptions &options) const;
+
+  template <typename Value>
+  void ProcessLayer(std::vector<Value> &table, int layer) const;
+
+  template <typename Value>
+  void ProcessRange(std::vector<Value> &table, std::uint32_t mask,
+                    std::uint64_t count) const;
+
+  int Cost(int from, int to) const { return cost_[from * size_ + to]; }
+
+  /**
+   * @return the size of the table with cells of the given width in bytes
+   */
+  std::size_t TableBytes(std::size_t cell) const {
+    if (size_ < 2) return 0;
+    return (std::size_t{1} << (size_ - 1)) * (size_ - 1) * cell;
+  }
+
+  int size_ = 0;
+  unsigned threads_ = 1;
+  std::vector<int> cost_;
+};
+
+}  // namespace s21
+
+#endif  // SRC_MODEL_S21_HELD_KARP_H_
@@ -0,0 +1,179 @@
+#include "s21_island_model.h"
+
+#include <algorithm>
+#include <thread>
+
+#include "s21_algorithm_stats.h"
+
+namespace s21 {
+
+IslandModel::IslandModel(const Graph &graph) : graph_(graph) {}
+
+std::vector<AntColonyParams> IslandModel::DefaultParams(std::size_t count,
+                                                        unsigned seed) {
+  const double kAlphas[] = {1.0, 1.0, 0.5, 1.5, 2.0};
+  const double kBetas[] = {2.0, 3.0, 5.0, 2.0, 4.0};
+  const double kEvaporations[] = {0.1, 0.05, 0.2, 0.15, 0.3};
+  const std::size_t kVariants = std::size(kAlphas);
+
+  if (seed == 0) seed = std::random_device()();
+  std::vector<AntColonyParams> params(count);
+  for (std::size_t i = 0; i != count; ++i) {
+    params[i].alpha = kAlphas[i % kVariants];
+    params[i].beta = kBetas[i % kVariants];
+    params[i].evaporation = kEvaporations[(i + i / kVariants) % kVariants];
+    params[i].seed = seed + static_cast<unsigned>(i);
+  }
+  return params;
+}
+
+TsmResult IslandModel::Solve(const TsmOptions &options) const {
+  TsmResult best;
+  best.distance = std::numeric_limits<double>::max();
+  if (graph_.size() == 0) return best;
+  S21_STATS_SCOPE("IslandModel");
+
+  const auto kStart = std::chrono::steady_clock::now();
+  auto elapsed = [&kStart]() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - kStart);
+  };
+
+  std::vector<AntColonyParams> params = options.islands.params;
+  if (params.empty()) {
+    const std::size_t kCount =
+        options.islands.count
+            ? options.islands.count
+            : std::max(1u, std::thread::hardware_concurrency());
+    params = DefaultParams(kCount, options.colony.seed);
+  }
+  const std::size_t kIslands = params.size();
+  const std::size_t kInterval =
+      std::max<std::size_t>(1, options.islands.migration_interval);
+
+  // Колбэк вызывается только из управляющего потока, а контрольную точку
+  // пишет лучший остров.
+  TsmOptions island_options = options;
+  island_options.on_progress = nullptr;
+  island_options.checkpoint_path.clear();
+  TsmOptions fresh_options = island_options;
+  fresh_options.resume_from.clear();
+
+  std::vector<std::unique_ptr<AntColony>> colonies;
+  for (const auto &island_params : params)
+    colonies.push_back(std::make_unique<AntColony>(graph_, island_params));
+  S21_STATS_MEMORY(kIslands * sizeof(double) * graph_.size() * graph_.size());
+
+  // Счётчики каждого острова собираются отдельно, и острова управляющего
+  // потока тоже, а в общую статистику попадают один раз в конце.
+  std::vector<AlgorithmStats> island_stats(kIslands);
+  auto run_parallel = [&colonies, &island_stats](auto &&task) {
+    auto counted = [&task, &island_stats](std::size_t i) {
+      S21_STATS_COLLECT(&island_stats[i]);
+      task(i);
+    };
+    std::vector<std::thread> workers;
+    for (std::size_t i = 1; i < colonies.size(); ++i)
+      workers.emplace_back(counted, i);
+    counted(0);
+    for (auto &worker : workers) worker.join();
+  };
+  auto collect_best = [&]() {
+    bool improved = false;
+    for (const auto &colony : colonies) {
+      if (colony->Best().distance < best.distance) {
+        best = colony->Best();
+        improved = true;
+      }
+    }
+    return improved;
+  };
+
+  // Продолжает контрольную точку только первый остров: остальные берут его
+  // феромон и тур, но со своими генераторами, иначе повторяли бы его запуск.
+  run_parallel([&](std::size_t i) {
+    colonies[i]->Prepare(i == 0 ? island_options : fresh_options);
+  });
+  if (!options.resume_from.empty()) {
+    for (std::size_t i = 1; i < kIslands; ++i) {
+      colonies[i]->BlendPheromone(colonies[0]->Pheromone(), 1.0);
+      colonies[i]->AcceptTour(colonies[0]->Best());
+    }
+  }
+  auto save_checkpoint = [&]() {
+    if (options.checkpoint_path.empty()) return;
+    const auto kBest = std::min_element(
+        colonies.begin(), colonies.end(),
+        [](const auto &left, const auto &right) {
+          return left->Best().distance < right->Best().distance;
+        });
+    (*kBest)->SaveCheckpoint(options.checkpoint_path);
+  };
+  if (collect_best() && options.on_progress)
+    options.on_progress({0, elapsed(), best});
+
+  std::size_t iteration = 0;
+  std::size_t stall = 0;
+  while (!AntColony::ShouldStop(options, iteration, stall, elapsed())) {
+    std::size_t steps = kInterval;
+    if (options.max_iterations != 0)
+      steps = std::min(steps, options.max_iterations - iteration);
+
+    std::vector<char> interrupted(kIslands, 0);
+    {
+      S21_STATS_PHASE("epochs");
+      run_parallel([&](std::size_t i) {
+        for (std::size_t step = 0; step != steps; ++step) {
+          if (!colonies[i]->RunIteration(island_options, kStart)) {
+            interrupted[i] = 1;
+            break;
+          }
+        }
+      });
+    }
+    const std::size_t kCheckpoints =
+        options.checkpoint_interval ? iteration / options.checkpoint_interval
+                                    : 0;
+    iteration += steps;
+    S21_STATS_SET(iterations, iteration);
+    if (options.checkpoint_interval != 0 &&
+        iteration / options.checkpoint_interval != kCheckpoints)
+      save_checkpoint();
+
+    if (collect_best()) {
+      stall = 0;
+      S21_STATS_SET(convergence_iteration, iteration);
+      if (options.on_progress)
+        options.on_progress({iteration, elapsed(), best});
+    } else {
+      stall += steps;
+    }
+    if (std::find(interrupted.begin(), interrupted.end(), 1) !=
+        interrupted.end())
+      break;
+
+    // Миграция по кольцу: остров i получает лучший тур острова i - 1.
+    S21_STATS_PHASE("migration");
+    std::vector<TsmResult> migrants;
+    std::vector<PheromoneMatrix> trails;
+    for (const auto &colony : colonies) {
+      migrants.push_back(colony->Best());
+      if (options.islands.share_pheromone)
+        trails.push_back(colony->Pheromone());
+    }
+    for (std::size_t i = 0; i != kIslands; ++i) {
+      const std::size_t kFrom = (i + kIslands - 1) % kIslands;
+      colonies[i]->AcceptTour(migrants[kFrom]);
+      if (options.islands.share_pheromone)
+        colonies[i]->BlendPheromone(trails[kFrom],
+                                    options.islands.pheromone_share);
+    }
+  }
+  save_checkpoint();
+#ifdef S21_GRAPH_STATS
+  for (const auto &stats : island_stats) S21_STATS_MERGE(stats);
+#endif
+  return best;
+}
+
+}  // namespace s21
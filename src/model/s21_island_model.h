@@ -0,0 +1,51 @@
+#ifndef SRC_MODEL_S21_ISLAND_MODEL_H_
+#define SRC_MODEL_S21_ISLAND_MODEL_H_
+
+#include <vector>
+
+#include "s21_ant_algorithm.h"
+#include "s21_graph.h"
+
+namespace s21 {
+
+/**
+ * Island model of the ant colony algorithm. Several independent colonies with
+ * different parameters run on separate threads; every migration interval
+ * each island receives the best tour (and optionally a share of the
+ * pheromone) of its neighbour in a ring.
+ */
+class IslandModel {
+ public:
+  explicit IslandModel(const Graph &graph);
+
+  /**
+   * Runs the islands until one of the limits from options is reached.
+   * max_iterations and stall_limit count iterations of a single island.
+   *
+   * @param options the limits of the run and options.islands settings
+   *
+   * @return the best tour of all islands, or an empty path with the maximal
+   * distance if no ant completed a tour
+   */
+  TsmResult Solve(const TsmOptions &options = TsmOptions()) const;
+
+  /**
+   * Generates parameters for the given number of islands. The first island
+   * uses the default parameters, the others vary alpha, beta and evaporation
+   * around them; every island gets its own seed.
+   *
+   * @param count the number of islands
+   * @param seed the seed of the first island, zero means a random seed
+   *
+   * @return the parameters of every island
+   */
+  static std::vector<AntColonyParams> DefaultParams(std::size_t count,
+                                                    unsigned seed = 0);
+
+ private:
+  const Graph &graph_;
+};
+
+}  // namespace s21
+
+#endif  // SRC_MODEL_S21_ISLAND_MODEL_H_
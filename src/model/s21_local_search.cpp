@@ -0,0 +1,306 @@
+#include "s21_local_search.h"
+
+#include <algorithm>
+#include <deque>
+
+#include "s21_ant_algorithm.h"
+
+namespace s21 {
+
+namespace {
+const double kEpsilon = 1e-9;
+const int kMaxSegmentLength = 3;
+}  // namespace
+
+LocalSearch::LocalSearch(const Graph &graph, int neighbours)
+    : size_(graph.size()),
+      symmetric_(!graph.IsDirected()),
+      cost_(static_cast<std::size_t>(graph.size()) * graph.size()),
+      out_neighbours_(graph.size()),
+      in_neighbours_(graph.size()) {
+  for (int row = 0; row != size_; ++row) {
+    const auto kRow = graph[row];
+    for (int col = 0; col != size_; ++col)
+      cost_[row * size_ + col] = row == col ? 0 : kRow[col];
+  }
+
+  const int kListSize = std::min(neighbours, size_ - 1);
+  for (int vertex = 0; vertex != size_; ++vertex) {
+    for (int other = 0; other != size_; ++other) {
+      if (other == vertex) continue;
+      if (HasEdge(vertex, other)) out_neighbours_[vertex].push_back(other);
+      if (HasEdge(other, vertex)) in_neighbours_[vertex].push_back(other);
+    }
+    auto &out = out_neighbours_[vertex];
+    auto &in = in_neighbours_[vertex];
+    auto by_out_cost = [this, vertex](int lhs, int rhs) {
+      return Cost(vertex, lhs) < Cost(vertex, rhs);
+    };
+    auto by_in_cost = [this, vertex](int lhs, int rhs) {
+      return Cost(lhs, vertex) < Cost(rhs, vertex);
+    };
+    if (static_cast<int>(out.size()) > kListSize) {
+      std::partial_sort(out.begin(), out.begin() + kListSize, out.end(),
+                        by_out_cost);
+      out.resize(kListSize);
+    } else {
+      std::sort(out.begin(), out.end(), by_out_cost);
+    }
+    if (static_cast<int>(in.size()) > kListSize) {
+      std::partial_sort(in.begin(), in.begin() + kListSize, in.end(),
+                        by_in_cost);
+      in.resize(kListSize);
+    } else {
+      std::sort(in.begin(), in.end(), by_in_cost);
+    }
+  }
+}
+
+bool LocalSearch::Improve(TsmResult &tour) const {
+  if (size_ < 4 || tour.path.size() != static_cast<std::size_t>(size_) + 1)
+    return false;
+
+  Tour current;
+  current.order.assign(tour.path.begin(), tour.path.end() - 1);
+  current.position.resize(size_);
+  for (int i = 0; i != size_; ++i) current.position[current.order[i]] = i;
+
+  const double kBefore = TourLength(current.order);
+  bool changed = true;
+  while (changed) {
+    changed = TwoOpt(current);
+    changed = OrOpt(current) || changed;
+  }
+
+  const double kAfter = TourLength(current.order);
+  if (kAfter >= kBefore - kEpsilon) return false;
+
+  const int kStart = tour.path.front();
+  std::rotate(current.order.begin(),
+              current.order.begin() + current.position[kStart],
+              current.order.end());
+  current.order.push_back(kStart);
+  tour.path = std::move(current.order);
+  tour.distance = kAfter;
+  return true;
+}
+
+/**
+ * Runs 2-opt with don't-look bits: only vertices whose tour neighbourhood has
+ * changed are examined again, and for every vertex only the candidates that
+ * are closer than its current tour neighbour are tried.
+ *
+ * @param tour the tour to improve
+ *
+ * @return true if at least one move was applied
+ */
+bool LocalSearch::TwoOpt(Tour &tour) const {
+  const int kSize = size_;
+  PrefixSums sums;
+  if (!symmetric_) BuildPrefixSums(tour, sums);
+
+  std::deque<int> active(tour.order.begin(), tour.order.end());
+  std::vector<char> queued(kSize, 1);
+  bool improved = false;
+
+  auto next = [&tour, kSize](int v) {
+    return tour.order[(tour.position[v] + 1) % kSize];
+  };
+  auto prev = [&tour, kSize](int v) {
+    return tour.order[(tour.position[v] + kSize - 1) % kSize];
+  };
+  auto wake = [&active, &queued](int v) {
+    if (!queued[v]) {
+      queued[v] = 1;
+      active.push_back(v);
+    }
+  };
+
+  while (!active.empty()) {
+    const int a = active.front();
+    active.pop_front();
+    queued[a] = 0;
+
+    bool moved = false;
+    for (int direction = 0; direction != 2 && !moved; ++direction) {
+      const int b = direction == 0 ? next(a) : prev(a);
+      const double kRemoved = direction == 0 ? Cost(a, b) : Cost(b, a);
+      for (int c : out_neighbours_[a]) {
+        if (Cost(a, c) >= kRemoved) break;
+        const int d = direction == 0 ? next(c) : prev(c);
+        if (c == b || d == a) continue;
+
+        // a b ... c d -> a c ... b d, либо b a ... d c -> b d ... a c.
+        const int kFirst = direction == 0 ? tour.position[b] : tour.position[a];
+        const int kLast = direction == 0 ? tour.position[c] : tour.position[d];
+        double delta = 0;
+        if (!ReversalDelta(tour, sums, kFirst, kLast, delta) ||
+            delta >= -kEpsilon)
+          continue;
+
+        Reverse(tour, kFirst, kLast);
+        if (!symmetric_) BuildPrefixSums(tour, sums);
+        for (int v : {a, b, c, d}) wake(v);
+        improved = moved = true;
+        break;
+      }
+    }
+  }
+  return improved;
+}
+
+/**
+ * Moves segments of one to three vertices to a better place in the tour. On
+ * symmetric matrices a segment may also be inserted reversed.
+ *
+ * @param tour the tour to improve
+ *
+ * @return true if at least one move was applied
+ */
+bool LocalSearch::OrOpt(Tour &tour) const {
+  const int kSize = size_;
+  bool improved = false;
+
+  for (int length = 1; length <= kMaxSegmentLength; ++length) {
+    if (length > kSize - 3) break;
+    for (int first = 0; first != kSize; ++first) {
+      const int kLast = (first + length - 1) % kSize;
+      const int s1 = tour.order[first];
+      const int s2 = tour.order[kLast];
+      const int p = tour.order[(first + kSize - 1) % kSize];
+      const int n = tour.order[(kLast + 1) % kSize];
+      if (!HasEdge(p, n)) continue;
+
+      const double kGain = Cost(p, s1) + Cost(s2, n) - Cost(p, n);
+      if (kGain <= kEpsilon) continue;
+
+      auto in_segment = [&tour, first, length, kSize](int v) {
+        return (tour.position[v] - first + kSize) % kSize < length;
+      };
+
+      bool moved = false;
+      for (int reversed = 0; reversed != (symmetric_ ? 2 : 1) && !moved;
+           ++reversed) {
+        const int kHead = reversed ? s2 : s1;
+        const int kTail = reversed ? s1 : s2;
+        for (int c : in_neighbours_[kHead]) {
+          if (Cost(c, kHead) >= kGain) break;
+          if (c == p || in_segment(c)) continue;
+          const int e = tour.order[(tour.position[c] + 1) % kSize];
+          if (!HasEdge(kTail, e)) continue;
+
+          const double kAdded = Cost(c, kHead) + Cost(kTail, e) - Cost(c, e);
+          if (kAdded >= kGain - kEpsilon) continue;
+
+          MoveSegment(tour, first, length, c, reversed != 0);
+          improved = moved = true;
+          break;
+        }
+      }
+    }
+  }
+  return improved;
+}
+
+/**
+ * Calculates the change of the tour length caused by reversing the tour
+ * positions from first to last (going forward, possibly wrapping around).
+ *
+ * @param tour the current tour
+ * @param sums prefix sums of the tour, used for asymmetric matrices only
+ * @param first the position of the first reversed vertex
+ * @param last the position of the last reversed vertex
+ * @param delta receives the length change
+ *
+ * @return false if the reversed tour would use a missing edge
+ */
+bool LocalSearch::ReversalDelta(const Tour &tour, const PrefixSums &sums,
+                                int first, int last, double &delta) const {
+  const int kSize = size_;
+  const int kLength = (last - first + kSize) % kSize + 1;
+  if (kLength < 2 || kLength > kSize - 2) return false;
+
+  const int kPrev = tour.order[(first + kSize - 1) % kSize];
+  const int kNext = tour.order[(last + 1) % kSize];
+  const int kFirstVertex = tour.order[first];
+  const int kLastVertex = tour.order[last];
+  if (!HasEdge(kPrev, kLastVertex) || !HasEdge(kFirstVertex, kNext))
+    return false;
+
+  delta = Cost(kPrev, kLastVertex) + Cost(kFirstVertex, kNext) -
+          Cost(kPrev, kFirstVertex) - Cost(kLastVertex, kNext);
+  if (symmetric_) return true;
+
+  // Рёбра внутри отрезка меняют направление.
+  auto range = [first, kLength, kSize](const auto &prefix) {
+    const int kEnd = first + kLength - 1;
+    if (kEnd <= kSize) return prefix[kEnd] - prefix[first];
+    return prefix[kSize] - prefix[first] + prefix[kEnd - kSize];
+  };
+  if (range(sums.missing) != 0) return false;
+  delta += range(sums.backward) - range(sums.forward);
+  return true;
+}
+
+void LocalSearch::Reverse(Tour &tour, int first, int last) const {
+  const int kSize = size_;
+  int length = (last - first + kSize) % kSize + 1;
+  // В симметричном случае разворот дополнения даёт тот же тур.
+  if (symmetric_ && 2 * length > kSize) {
+    const int kFirst = (last + 1) % kSize;
+    last = (first + kSize - 1) % kSize;
+    first = kFirst;
+    length = kSize - length;
+  }
+  for (int i = 0; i < length / 2; ++i) {
+    const int kLeft = (first + i) % kSize;
+    const int kRight = (last - i + kSize) % kSize;
+    std::swap(tour.order[kLeft], tour.order[kRight]);
+    tour.position[tour.order[kLeft]] = kLeft;
+    tour.position[tour.order[kRight]] = kRight;
+  }
+}
+
+void LocalSearch::MoveSegment(Tour &tour, int first, int length, int after,
+                              bool reversed) const {
+  const int kSize = size_;
+  std::vector<int> segment;
+  std::vector<int> order;
+  segment.reserve(length);
+  order.reserve(kSize);
+  for (int i = 0; i != length; ++i)
+    segment.push_back(tour.order[(first + i) % kSize]);
+  if (reversed) std::reverse(segment.begin(), segment.end());
+
+  for (int i = length; i != kSize; ++i) {
+    const int kVertex = tour.order[(first + i) % kSize];
+    order.push_back(kVertex);
+    if (kVertex == after)
+      order.insert(order.end(), segment.begin(), segment.end());
+  }
+  tour.order = std::move(order);
+  for (int i = 0; i != kSize; ++i) tour.position[tour.order[i]] = i;
+}
+
+void LocalSearch::BuildPrefixSums(const Tour &tour, PrefixSums &sums) const {
+  const int kSize = size_;
+  sums.forward.assign(kSize + 1, 0.0);
+  sums.backward.assign(kSize + 1, 0.0);
+  sums.missing.assign(kSize + 1, 0);
+  for (int i = 0; i != kSize; ++i) {
+    const int kFrom = tour.order[i];
+    const int kTo = tour.order[(i + 1) % kSize];
+    sums.forward[i + 1] = sums.forward[i] + Cost(kFrom, kTo);
+    sums.backward[i + 1] = sums.backward[i] + Cost(kTo, kFrom);
+    sums.missing[i + 1] = sums.missing[i] + (HasEdge(kTo, kFrom) ? 0 : 1);
+  }
+}
+
+double LocalSearch::TourLength(const std::vector<int> &order) const {
+  double length = 0;
+  for (std::size_t i = 0; i != order.size(); ++i)
+    length += Cost(order[i], order[(i + 1) % order.size()]);
+  return length;
+}
+
+}  // namespace s21
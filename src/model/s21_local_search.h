@@ -0,0 +1,82 @@
+#ifndef SRC_MODEL_S21_LOCAL_SEARCH_H_
+#define SRC_MODEL_S21_LOCAL_SEARCH_H_
+
+#include <vector>
+
+#include "s21_graph.h"
+
+namespace s21 {
+
+struct TsmResult;
+
+/**
+ * Where the ant colony applies local search before the pheromone deposit.
+ */
+enum class LocalSearchMode { kNone, kIterationBest, kEveryAnt };
+
+/**
+ * 2-opt and Or-opt improvement of closed tours. 2-opt uses candidate
+ * neighbour lists and don't-look bits, Or-opt moves segments of up to three
+ * vertices. Missing edges (zero cells) are never introduced into a tour, and
+ * on asymmetric matrices the cost of a reversed segment is taken into account.
+ */
+class LocalSearch {
+ public:
+  static constexpr int kDefaultNeighbours = 10;
+
+  /**
+   * Precomputes the cost matrix and the candidate neighbour lists.
+   *
+   * @param graph the graph the tours belong to
+   * @param neighbours the length of the candidate list of every vertex
+   */
+  explicit LocalSearch(const Graph &graph, int neighbours = kDefaultNeighbours);
+
+  /**
+   * Improves a closed tour in place until it is 2-opt and Or-opt optimal. The
+   * tour keeps its first vertex.
+   *
+   * @param tour the tour in the TsmResult format, the first vertex repeated at
+   * the end
+   *
+   * @return true if the tour became shorter
+   */
+  bool Improve(TsmResult &tour) const;
+
+ private:
+  struct Tour {
+    std::vector<int> order;
+    std::vector<int> position;
+  };
+
+  // Префиксные суммы длин рёбер тура в прямом и обратном направлении и
+  // количество отсутствующих обратных рёбер для несимметричных матриц.
+  struct PrefixSums {
+    std::vector<double> forward;
+    std::vector<double> backward;
+    std::vector<int> missing;
+  };
+
+  double Cost(int from, int to) const { return cost_[from * size_ + to]; }
+  bool HasEdge(int from, int to) const { return Cost(from, to) > 0; }
+
+  bool TwoOpt(Tour &tour) const;
+  bool OrOpt(Tour &tour) const;
+  bool ReversalDelta(const Tour &tour, const PrefixSums &sums, int first,
+                     int last, double &delta) const;
+  void Reverse(Tour &tour, int first, int last) const;
+  void MoveSegment(Tour &tour, int first, int length, int after,
+                   bool reversed) const;
+  void BuildPrefixSums(const Tour &tour, PrefixSums &sums) const;
+  double TourLength(const std::vector<int> &order) const;
+
+  int size_ = 0;
+  bool symmetric_ = true;
+  std::vector<double> cost_;
+  std::vector<std::vector<int>> out_neighbours_;
+  std::vector<std::vector<int>> in_neighbours_;
+};
+
+}  // namespace s21
+
+#endif  // SRC_MODEL_S21_LOCAL_SEARCH_H_
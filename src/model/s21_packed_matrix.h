@@ -0,0 +1,73 @@
+#ifndef SRC_MODEL_S21_PACKED_MATRIX_H_
+#define SRC_MODEL_S21_PACKED_MATRIX_H_
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace s21 {
+
+/**
+ * A symmetric square matrix that keeps only its upper triangle, the diagonal
+ * included, row by row in one array: size * (size + 1) / 2 cells instead of
+ * size * size. The cell (row, col) and the cell (col, row) are the same cell.
+ * The cells of one row from the diagonal to the end lie together, which the
+ * kernels use for contiguous loops.
+ */
+template <typename T>
+class PackedSymmetricMatrix {
+ public:
+  PackedSymmetricMatrix() = default;
+
+  PackedSymmetricMatrix(int size, T value)
+      : size_(size), cells_(Cells(size), value) {}
+
+  int size() const { return size_; }
+
+  /**
+   * @return the number of stored cells, size * (size + 1) / 2
+   */
+  static std::size_t Cells(int size) {
+    return static_cast<std::size_t>(size) * (size + 1) / 2;
+  }
+
+  /**
+   * @return the position of the cell in the array, the order of the vertices
+   * does not matter
+   */
+  std::size_t Index(int row, int col) const { return Index(size_, row, col); }
+
+  static std::size_t Index(int size, int row, int col) {
+    if (row > col) std::swap(row, col);
+    return static_cast<std::size_t>(row) * (2 * size - row - 1) / 2 + col;
+  }
+
+  T &operator()(int row, int col) { return cells_[Index(row, col)]; }
+  const T &operator()(int row, int col) const {
+    return cells_[Index(row, col)];
+  }
+
+  /**
+   * @return the cells (row, row), (row, row + 1), ..., (row, size - 1)
+   */
+  T *UpperRow(int row) { return cells_.data() + Index(row, row); }
+  const T *UpperRow(int row) const { return cells_.data() + Index(row, row); }
+
+  std::vector<T> &Data() { return cells_; }
+  const std::vector<T> &Data() const { return cells_; }
+
+  bool operator==(const PackedSymmetricMatrix &other) const {
+    return size_ == other.size_ && cells_ == other.cells_;
+  }
+  bool operator!=(const PackedSymmetricMatrix &other) const {
+    return !(*this == other);
+  }
+
+ private:
+  int size_ = 0;
+  std::vector<T> cells_;
+};
+
+}  // namespace s21
+
+#endif  // SRC_MODEL_S21_PACKED_MATRIX_H_
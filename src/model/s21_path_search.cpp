@@ -0,0 +1,227 @@
+#include "s21_path_search.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <stdexcept>
+#include <utility>
+
+#include "s21_algorithm_stats.h"
+#include "s21_trace.h"
+
+namespace s21 {
+
+namespace {
+const int kUnreachable = std::numeric_limits<int>::max();
+const long long kInfinity = std::numeric_limits<long long>::max();
+
+using Entry = std::pair<long long, int>;
+using MinHeap = std::priority_queue<Entry, vector<Entry>, std::greater<>>;
+
+void CheckVertices(const Graph &graph, int vertex1, int vertex2) {
+  if (vertex1 < 1 || vertex1 > graph.size() || vertex2 < 1 ||
+      vertex2 > graph.size()) {
+    throw std::invalid_argument(
+        "[ [Wrong argument] ] :: Graph or start/end vertex is invalid\n");
+  }
+}
+
+// Вес ребра from -> to при прямом поиске или to -> from при обратном.
+int Weight(const Graph &graph, int from, int to, bool reverse) {
+  return reverse ? graph[to][from] : graph[from][to];
+}
+
+/**
+ * Dijkstra's algorithm with a binary heap from one vertex to all others, or
+ * from all others to one vertex if reverse is set.
+ */
+vector<int> Distances(const Graph &graph, int source, bool reverse) {
+  vector<long long> distance(graph.size(), kInfinity);
+  MinHeap heap;
+  distance[source] = 0;
+  heap.emplace(0, source);
+  while (!heap.empty()) {
+    auto [length, vertex] = heap.top();
+    heap.pop();
+    if (length != distance[vertex]) continue;
+    for (int next = 0; next < graph.size(); ++next) {
+      const int kWeight = Weight(graph, vertex, next, reverse);
+      if (kWeight != 0 && length + kWeight < distance[next]) {
+        distance[next] = length + kWeight;
+        heap.emplace(distance[next], next);
+      }
+    }
+  }
+  vector<int> result(graph.size());
+  std::transform(distance.begin(), distance.end(), result.begin(),
+                 [](long long length) {
+                   return length >= kUnreachable ? kUnreachable
+                                                 : static_cast<int>(length);
+                 });
+  return result;
+}
+}  // namespace
+
+Landmarks::Landmarks(const Graph &graph, int count) {
+  S21_STATS_SCOPE("Landmarks");
+  Trace::Scope trace("Landmarks::Landmarks", "V", graph.size(), "landmarks",
+                     count);
+  count = std::max(0, std::min(count, graph.size()));
+  // Расстояние от вершины до ближайшего выбранного ориентира; недостижимые
+  // вершины выбираются первыми, чтобы ориентир был в каждой компоненте.
+  vector<long long> nearest(graph.size(), kInfinity);
+  int next = 0;
+  for (int i = 0; i < count; ++i) {
+    vertices_.push_back(next);
+    from_landmark_.push_back(Distances(graph, next, false));
+    to_landmark_.push_back(Distances(graph, next, true));
+    S21_STATS_ADD(iterations, 1);
+
+    for (int vertex = 0; vertex < graph.size(); ++vertex) {
+      const int kForward = from_landmark_.back()[vertex];
+      const int kBackward = to_landmark_.back()[vertex];
+      long long distance = std::min(kForward, kBackward);
+      if (distance == kUnreachable) distance = kInfinity - 1;
+      nearest[vertex] = std::min(nearest[vertex], distance);
+    }
+    next = static_cast<int>(
+        std::max_element(nearest.begin(), nearest.end()) - nearest.begin());
+  }
+  S21_STATS_MEMORY(2 * sizeof(int) * count * graph.size());
+}
+
+int Landmarks::LowerBound(int from, int to) const {
+  long long bound = 0;
+  for (std::size_t i = 0; i < vertices_.size(); ++i) {
+    // d(L, to) <= d(L, from) + d(from, to)
+    const int kLandmarkFrom = from_landmark_[i][from];
+    const int kLandmarkTo = from_landmark_[i][to];
+    if (kLandmarkFrom != kUnreachable) {
+      if (kLandmarkTo == kUnreachable) return kUnreachable;
+      bound = std::max<long long>(bound, kLandmarkTo - kLandmarkFrom);
+    }
+    // d(from, L) <= d(from, to) + d(to, L)
+    const int kFromLandmark = to_landmark_[i][from];
+    const int kToLandmark = to_landmark_[i][to];
+    if (kToLandmark != kUnreachable) {
+      if (kFromLandmark == kUnreachable) return kUnreachable;
+      bound = std::max<long long>(bound, kFromLandmark - kToLandmark);
+    }
+  }
+  return static_cast<int>(bound);
+}
+
+int PointToPoint::Bidirectional(const Graph &graph, int vertex1,
+                                int vertex2) {
+  CheckVertices(graph, vertex1, vertex2);
+  S21_STATS_SCOPE("BidirectionalDijkstra");
+  Trace::Scope trace("PointToPoint::Bidirectional", "V", graph.size(), "E",
+                     graph.Properties().edge_count);
+  S21_STATS_MEMORY(2 * graph.size() * (sizeof(long long) + sizeof(bool)));
+  const int kSource = vertex1 - 1;
+  const int kTarget = vertex2 - 1;
+  if (kSource == kTarget) return 0;
+
+  // Индекс 0 - поиск от начала, 1 - поиск от конца по обратным рёбрам.
+  vector<long long> distance[2] = {vector<long long>(graph.size(), kInfinity),
+                                   vector<long long>(graph.size(), kInfinity)};
+  vector<bool> settled[2] = {vector<bool>(graph.size(), false),
+                             vector<bool>(graph.size(), false)};
+  MinHeap heap[2];
+  distance[0][kSource] = 0;
+  distance[1][kTarget] = 0;
+  heap[0].emplace(0, kSource);
+  heap[1].emplace(0, kTarget);
+  long long best = kInfinity;
+
+  while (true) {
+    for (int side = 0; side < 2; ++side) {
+      while (!heap[side].empty() &&
+             settled[side][heap[side].top().second]) {
+        heap[side].pop();
+      }
+    }
+    if (heap[0].empty() || heap[1].empty()) break;
+    // Любой путь короче найденного прошёл бы через обе границы поиска.
+    if (heap[0].top().first + heap[1].top().first >= best) break;
+
+    const int kSide = heap[0].top().first <= heap[1].top().first ? 0 : 1;
+    const int kVertex = heap[kSide].top().second;
+    heap[kSide].pop();
+    settled[kSide][kVertex] = true;
+    S21_STATS_ADD(vertices_popped, 1);
+    S21_STATS_ADD(heap_operations, 1);
+
+    const long long kLength = distance[kSide][kVertex];
+    for (int next = 0; next < graph.size(); ++next) {
+      const int kWeight = Weight(graph, kVertex, next, kSide == 1);
+      if (kWeight == 0) continue;
+      S21_STATS_ADD(edges_scanned, 1);
+      if (kLength + kWeight < distance[kSide][next]) {
+        distance[kSide][next] = kLength + kWeight;
+        heap[kSide].emplace(distance[kSide][next], next);
+        S21_STATS_ADD(edges_relaxed, 1);
+        S21_STATS_ADD(heap_operations, 1);
+      }
+      if (distance[1 - kSide][next] != kInfinity) {
+        best = std::min(best, distance[kSide][next] + distance[1 - kSide][next]);
+      }
+    }
+  }
+  return best >= kUnreachable ? kUnreachable : static_cast<int>(best);
+}
+
+int PointToPoint::Alt(const Graph &graph, const Landmarks &landmarks,
+                      int vertex1, int vertex2) {
+  CheckVertices(graph, vertex1, vertex2);
+  S21_STATS_SCOPE("AltSearch");
+  Trace::Scope trace("PointToPoint::Alt", "V", graph.size(), "landmarks",
+                     landmarks.Vertices().size());
+  S21_STATS_MEMORY(graph.size() * (2 * sizeof(long long) + sizeof(bool)));
+  const int kSource = vertex1 - 1;
+  const int kTarget = vertex2 - 1;
+
+  // Оценка остатка пути считается лениво, только для достигнутых вершин.
+  vector<long long> potential(graph.size(), -1);
+  auto Potential = [&](int vertex) {
+    if (potential[vertex] < 0) {
+      potential[vertex] = landmarks.LowerBound(vertex, kTarget);
+    }
+    return potential[vertex];
+  };
+  if (Potential(kSource) == kUnreachable) return kUnreachable;
+
+  vector<long long> distance(graph.size(), kInfinity);
+  vector<bool> settled(graph.size(), false);
+  MinHeap heap;
+  distance[kSource] = 0;
+  heap.emplace(Potential(kSource), kSource);
+
+  while (!heap.empty()) {
+    const int kVertex = heap.top().second;
+    heap.pop();
+    if (settled[kVertex]) continue;
+    settled[kVertex] = true;
+    S21_STATS_ADD(vertices_popped, 1);
+    S21_STATS_ADD(heap_operations, 1);
+    if (kVertex == kTarget) break;
+
+    const vector<int> &row = graph[kVertex];
+    for (int next = 0; next < graph.size(); ++next) {
+      if (row[next] == 0 || settled[next]) continue;
+      S21_STATS_ADD(edges_scanned, 1);
+      const long long kLength = distance[kVertex] + row[next];
+      if (kLength < distance[next] && Potential(next) != kUnreachable) {
+        distance[next] = kLength;
+        heap.emplace(kLength + Potential(next), next);
+        S21_STATS_ADD(edges_relaxed, 1);
+        S21_STATS_ADD(heap_operations, 1);
+      }
+    }
+  }
+  return distance[kTarget] >= kUnreachable ? kUnreachable
+                                           : static_cast<int>(distance[kTarget]);
+}
+
+}  // namespace s21
@@ -0,0 +1,104 @@
+#ifndef SRC_MODEL_S21_PATH_SEARCH_H_
+#define SRC_MODEL_S21_PATH_SEARCH_H_
+
+#include <vector>
+
+#include "s21_graph.h"
+
+namespace s21 {
+
+/**
+ * The algorithm of a query for the shortest path between two vertices.
+ *
+ * kDijkstra - GraphAlgorithms::GetShortestPathBetweenVertices
+ * kBidirectional - Dijkstra's algorithm from both ends at once
+ * kAlt - A* with lower bounds from landmarks, needs Landmarks of the graph
+ * kContractionHierarchy - upward search in a ContractionHierarchy of the graph
+ */
+enum class PathSearch {
+  kDijkstra,
+  kBidirectional,
+  kAlt,
+  kContractionHierarchy
+};
+
+/**
+ * Distances from and to a few landmark vertices. By the triangle inequality
+ * they give a lower bound of the distance between any two vertices, which
+ * guides the A* search toward the target. The landmarks are chosen one by one
+ * as the vertex farthest from the chosen ones, which puts them at the border
+ * of the graph. Building costs two Dijkstra runs per landmark.
+ */
+class Landmarks {
+ public:
+  static constexpr int kDefaultCount = 8;
+
+  /**
+   * Chooses the landmarks and computes their distances.
+   *
+   * @param graph the graph, its weights must not be negative
+   * @param count the number of landmarks, at most the number of vertices
+   */
+  explicit Landmarks(const Graph &graph, int count = kDefaultCount);
+
+  /**
+   * @return the landmark vertices, from 0
+   */
+  const vector<int> &Vertices() const { return vertices_; }
+
+  /**
+   * Returns a lower bound of the distance between two vertices.
+   *
+   * @param from the start vertex, from 0
+   * @param to the end vertex, from 0
+   *
+   * @return the bound, or the maximal int if the end is unreachable
+   */
+  int LowerBound(int from, int to) const;
+
+ private:
+  vector<int> vertices_;
+  // Расстояния от ориентира до вершин и от вершин до ориентира.
+  matrix from_landmark_;
+  matrix to_landmark_;
+};
+
+class PointToPoint {
+ public:
+  /**
+   * Finds the shortest path between two vertices with Dijkstra's algorithm
+   * running from both ends. The searches stop once the sum of their frontiers
+   * reaches the best path found, which settles about half the vertices of a
+   * one-directional search.
+   *
+   * @param graph the graph, its weights must not be negative
+   * @param vertex1 the start vertex, from 1
+   * @param vertex2 the end vertex, from 1
+   *
+   * @return the length of the path, or the maximal int if there is none
+   *
+   * @throws std::invalid_argument if a vertex does not exist
+   */
+  static int Bidirectional(const Graph &graph, int vertex1, int vertex2);
+
+  /**
+   * Finds the shortest path between two vertices with the A* search whose
+   * heuristic is the landmark lower bound. On graphs with a geometry, such as
+   * road networks, it settles mostly the vertices near the shortest path.
+   *
+   * @param graph the graph the landmarks were built for
+   * @param landmarks the landmarks of the graph
+   * @param vertex1 the start vertex, from 1
+   * @param vertex2 the end vertex, from 1
+   *
+   * @return the length of the path, or the maximal int if there is none
+   *
+   * @throws std::invalid_argument if a vertex does not exist
+   */
+  static int Alt(const Graph &graph, const Landmarks &landmarks, int vertex1,
+                 int vertex2);
+};
+
+}  // namespace s21
+
+#endif  // SRC_MODEL_S21_PATH_SEARCH_H_
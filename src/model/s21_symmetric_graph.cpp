@@ -0,0 +1,145 @@
+#include "s21_symmetric_graph.h"
+
+#include "s21_trace.h"
+
+namespace s21 {
+
+namespace {
+template <typename Weight>
+std::string Label(Weight weight) {
+  if constexpr (std::is_floating_point_v<Weight>) {
+    std::ostringstream label;
+    label << weight;
+    return label.str();
+  } else {
+    return std::to_string(weight);
+  }
+}
+}  // namespace
+
+template <typename Weight>
+SymmetricGraph<Weight>::SymmetricGraph(const BasicGraph<Weight> &graph)
+    : weights_(graph.size(), 0), permutation_(graph.Permutation()) {
+  if (graph.IsDirected()) {
+    throw std::invalid_argument(
+        "[ [Wrong argument] ] :: Matrix is not symmetric\n");
+  }
+  for (int row = 0; row < graph.size(); ++row) {
+    Weight *cells = weights_.UpperRow(row);
+    for (int col = row; col < graph.size(); ++col) {
+      cells[col - row] = graph[row][col];
+    }
+  }
+  UpdateProperties();
+}
+
+template <typename Weight>
+void SymmetricGraph<Weight>::loadGraphFromFile(const string &filename) {
+  Trace::Scope trace("SymmetricGraph::loadGraphFromFile");
+  // При ошибке загрузки граф остаётся пустым.
+  weights_ = PackedSymmetricMatrix<Weight>();
+  permutation_ = VertexPermutation();
+  UpdateProperties();
+  std::ifstream file(filename);
+  if (!file.is_open()) {
+    throw std::runtime_error("[ [Wrong argument] ] :: File not found\n");
+  }
+
+  string line;
+  int vert_count = 0;
+  std::getline(file, line);
+  if (sscanf(line.c_str(), "%d", &vert_count) != 1 || vert_count < 1) {
+    throw std::out_of_range("[ [File error] ] :: Matrix size must be > 0\n");
+  }
+
+  PackedSymmetricMatrix<Weight> loaded(vert_count, 0);
+  typename WeightTraits<Weight>::Parsed parsed;
+  int row = 0;
+  while (std::getline(file, line)) {
+    if (row == vert_count) {
+      throw std::out_of_range("[ [File error] ] :: Invalid matrix size\n");
+    }
+    std::stringstream stream(line);
+    int col = 0;
+    while (stream >> parsed) {
+      if (col == vert_count) {
+        throw std::out_of_range("[ [File error] ] :: Invalid matrix size\n");
+      }
+      if (parsed < 0) {
+        throw std::out_of_range(
+            "[ [File error] ] :: Negative matrix element\n");
+      }
+      if (!WeightTraits<Weight>::Fits(parsed)) {
+        throw std::out_of_range(
+            "[ [File error] ] :: Matrix element does not fit the weight "
+            "type\n");
+      }
+      const auto kWeight = static_cast<Weight>(parsed);
+      // Нижний треугольник уже прочитан в строках выше.
+      if (col < row && loaded(row, col) != kWeight) {
+        throw std::invalid_argument(
+            "[ [Wrong argument] ] :: Matrix is not symmetric\n");
+      }
+      if (col >= row) loaded(row, col) = kWeight;
+      ++col;
+    }
+    if (col != vert_count) {
+      throw std::out_of_range("[ [File error] ] :: Invalid matrix size\n");
+    }
+    ++row;
+  }
+  if (row != vert_count) {
+    throw std::out_of_range("[ [File error] ] :: Invalid matrix size\n");
+  }
+
+  weights_ = std::move(loaded);
+  UpdateProperties();
+  trace.Arg(0, "V", vert_count);
+  trace.Arg(1, "E", edge_count_);
+}
+
+template <typename Weight>
+void SymmetricGraph<Weight>::exportGraphToDot(const string &filename) const {
+  std::ofstream file(filename, std::ios::trunc);
+  if (!file.is_open()) {
+    throw std::runtime_error("[ [Wrong argument] ] :: File was not created\n");
+  }
+  file << "graph MyGraph {";
+  for (int row = 0; row < size(); ++row) {
+    const Weight *cells = weights_.UpperRow(row);
+    for (int col = row; col < size(); ++col) {
+      if (cells[col - row] > 0) {
+        file << "\n  " << permutation_.ToOriginal(row) << " -- "
+             << permutation_.ToOriginal(col)
+             << " [label=" << Label(cells[col - row]) << "];";
+      }
+    }
+  }
+  file << "\n}";
+  if (!file) {
+    throw std::runtime_error("[ [Wrong argument] ] :: File was not created\n");
+  }
+}
+
+template <typename Weight>
+void SymmetricGraph<Weight>::UpdateProperties() {
+  edge_count_ = 0;
+  total_weight_ = 0;
+  for (int row = 0; row < size(); ++row) {
+    const Weight *cells = weights_.UpperRow(row);
+    // Петля на диагонали не считается ребром, как в BasicGraph.
+    for (int col = row + 1; col < size(); ++col) {
+      if (cells[col - row] != 0) {
+        ++edge_count_;
+        total_weight_ += cells[col - row];
+      }
+    }
+  }
+}
+
+template class SymmetricGraph<std::uint8_t>;
+template class SymmetricGraph<std::uint16_t>;
+template class SymmetricGraph<int>;
+template class SymmetricGraph<std::int64_t>;
+template class SymmetricGraph<float>;
+}  // namespace s21
@@ -0,0 +1,140 @@
+#ifndef SRC_MODEL_S21_SYMMETRIC_GRAPH_H_
+#define SRC_MODEL_S21_SYMMETRIC_GRAPH_H_
+
+#include <stdexcept>
+#include <string>
+#include <variant>
+
+#include "s21_graph.h"
+#include "s21_packed_matrix.h"
+
+namespace s21 {
+
+/**
+ * An undirected graph stored as the packed upper triangle of its adjacency
+ * matrix: every weight is kept once, in half the memory of BasicGraph. The
+ * graph is a dense graph view (see s21_graph_view.h) with kSymmetric set, so
+ * ViewAlgorithms return its shortest paths and spanning tree packed as well.
+ * The members are compiled in s21_symmetric_graph.cpp for the weight types of
+ * BasicGraph.
+ */
+template <typename Weight>
+class SymmetricGraph {
+ public:
+  using WeightType = Weight;
+  using Distance = typename WeightTraits<Weight>::Distance;
+
+  static constexpr bool kSymmetric = true;
+
+  SymmetricGraph() = default;
+
+  /**
+   * Packs an undirected graph with its numbering.
+   *
+   * @throws std::invalid_argument if the graph is directed
+   */
+  explicit SymmetricGraph(const BasicGraph<Weight> &graph);
+
+  /**
+   * Loads a graph from a file in the format of BasicGraph::loadGraphFromFile.
+   * The rows are read one by one into the upper triangle, the lower triangle
+   * is only compared with it, so the full matrix is never kept in memory.
+   *
+   * @throws std::runtime_error if the file cannot be opened
+   * @throws std::out_of_range if the matrix size is invalid, a weight is
+   * negative or does not fit the weight type
+   * @throws std::invalid_argument if the matrix is not symmetric
+   */
+  void loadGraphFromFile(const string &filename);
+
+  Weight Cell(int from, int to) const { return weights_(from, to); }
+
+  /**
+   * Calls visit(to, weight) for every edge of the vertex in increasing order
+   * of to: first down the column of the upper triangle, then along the row.
+   */
+  template <typename Visit>
+  void ForEachNeighbour(int vertex, Visit visit) const {
+    const int kSize = size();
+    std::size_t index = vertex;
+    for (int to = 0; to < vertex; ++to) {
+      const Weight kWeight = weights_.Data()[index];
+      if (kWeight != 0) visit(to, kWeight);
+      index += kSize - to - 1;
+    }
+    const Weight *row = weights_.UpperRow(vertex);
+    for (int to = vertex; to < kSize; ++to) {
+      if (row[to - vertex] != 0) visit(to, row[to - vertex]);
+    }
+  }
+
+  int size() const { return weights_.size(); }
+
+  bool IsDirected() const { return false; }
+
+  long long EdgeCount() const { return edge_count_; }
+
+  /**
+   * @return the sum of the weights of all edges
+   */
+  Distance getGraphWeight() const {
+    return static_cast<Distance>(total_weight_);
+  }
+
+  const PackedSymmetricMatrix<Weight> &Weights() const { return weights_; }
+
+  /**
+   * @return the original number of every vertex, see BasicGraph::Reorder
+   */
+  const VertexPermutation &Permutation() const { return permutation_; }
+
+  /**
+   * Exports the graph to a DOT file, every edge once, with the original
+   * vertex numbers.
+   *
+   * @throws std::runtime_error if the file could not be created
+   */
+  void exportGraphToDot(const string &filename) const;
+
+ private:
+  void UpdateProperties();
+
+  PackedSymmetricMatrix<Weight> weights_;
+  VertexPermutation permutation_;
+  long long edge_count_ = 0;
+  typename WeightTraits<Weight>::Sum total_weight_ = 0;
+};
+
+extern template class SymmetricGraph<std::uint8_t>;
+extern template class SymmetricGraph<std::uint16_t>;
+extern template class SymmetricGraph<int>;
+extern template class SymmetricGraph<std::int64_t>;
+extern template class SymmetricGraph<float>;
+
+/**
+ * Loads a graph from a file into the storage that suits it: SymmetricGraph if
+ * the matrix is symmetric, BasicGraph otherwise.
+ *
+ * @throws std::runtime_error if the file cannot be opened
+ * @throws std::out_of_range if the matrix size is invalid, a weight is
+ * negative or does not fit the weight type
+ */
+template <typename Weight>
+std::variant<BasicGraph<Weight>, SymmetricGraph<Weight>> LoadGraph(
+    const string &filename) {
+  SymmetricGraph<Weight> symmetric;
+  try {
+    symmetric.loadGraphFromFile(filename);
+    return symmetric;
+  } catch (const std::invalid_argument &) {
+    // Загрузка прерывается на первой несимметричной паре, и файл
+    // ориентированного графа читается заново целиком.
+  }
+  BasicGraph<Weight> graph;
+  graph.loadGraphFromFile(filename);
+  return graph;
+}
+
+}  // namespace s21
+
+#endif  // SRC_MODEL_S21_SYMMETRIC_GRAPH_H_
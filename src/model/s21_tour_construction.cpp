@@ -0,0 +1,100 @@
+#include "s21_tour_construction.h"
+
+#include "s21_graph_algorithms.h"
+
+namespace s21 {
+
+TsmResult TourConstruction::NearestNeighbour(const Graph &graph, int start) {
+  const int kSize = graph.size();
+  std::vector<bool> visited(kSize, false);
+  std::vector<int> order = {start};
+  visited[start] = true;
+
+  for (int step = 1; step < kSize; ++step) {
+    const auto kRow = graph[order.back()];
+    int nearest = -1;
+    for (int vertex = 0; vertex != kSize; ++vertex) {
+      if (visited[vertex] || kRow[vertex] == 0) continue;
+      if (nearest < 0 || kRow[vertex] < kRow[nearest]) nearest = vertex;
+    }
+    if (nearest < 0) return ClosedTour(graph, {});
+    visited[nearest] = true;
+    order.push_back(nearest);
+  }
+  return ClosedTour(graph, std::move(order));
+}
+
+TsmResult TourConstruction::SpanningTreeWalk(const Graph &graph) {
+  const int kSize = graph.size();
+  matrix tree;
+  try {
+    // Дерево приходит в исходных номерах, а обход идёт по строкам графа.
+    tree = graph.Permutation().MatrixToInternal(
+        GraphAlgorithms::GetLeastSpanningTree(graph));
+  } catch (const std::exception &) {
+    return ClosedTour(graph, {});
+  }
+
+  std::vector<bool> visited(kSize, false);
+  std::vector<int> order;
+  Stack<int> vertices_stack;
+  vertices_stack.push(0);
+  while (!vertices_stack.empty()) {
+    int vertex = vertices_stack.top();
+    vertices_stack.pop();
+    if (visited[vertex]) continue;
+    visited[vertex] = true;
+    order.push_back(vertex);
+    for (int child = kSize - 1; child >= 0; --child) {
+      if (!visited[child] && tree[vertex][child] > 0)
+        vertices_stack.push(child);
+    }
+  }
+  if (static_cast<int>(order.size()) != kSize) return ClosedTour(graph, {});
+  return ClosedTour(graph, std::move(order));
+}
+
+TsmResult TourConstruction::Build(const Graph &graph, InitialTour kind) {
+  switch (kind) {
+    case InitialTour::kNearestNeighbour:
+      return NearestNeighbour(graph);
+    case InitialTour::kSpanningTree:
+      return SpanningTreeWalk(graph);
+    case InitialTour::kBest: {
+      TsmResult nearest = NearestNeighbour(graph);
+      TsmResult walk = SpanningTreeWalk(graph);
+      return walk.distance < nearest.distance ? walk : nearest;
+    }
+    default:
+      return ClosedTour(graph, {});
+  }
+}
+
+/**
+ * Closes the vertex order into a tour and calculates its length.
+ *
+ * @param graph the graph representing the cities and distances
+ * @param order all vertices in the order of the tour
+ *
+ * @return the tour, or an empty path with the maximal distance if the order is
+ * empty or uses a missing edge
+ */
+TsmResult TourConstruction::ClosedTour(const Graph &graph,
+                                       std::vector<int> order) {
+  TsmResult result;
+  result.distance = std::numeric_limits<double>::max();
+  if (order.empty()) return result;
+
+  order.push_back(order.front());
+  double distance = 0;
+  for (std::size_t i = 0; i + 1 != order.size(); ++i) {
+    const int kEdge = graph[order[i]][order[i + 1]];
+    if (kEdge == 0) return result;
+    distance += kEdge;
+  }
+  result.path = std::move(order);
+  result.distance = distance;
+  return result;
+}
+
+}  // namespace s21
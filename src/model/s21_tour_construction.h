@@ -0,0 +1,57 @@
+#ifndef SRC_MODEL_S21_TOUR_CONSTRUCTION_H_
+#define SRC_MODEL_S21_TOUR_CONSTRUCTION_H_
+
+#include "s21_graph.h"
+
+namespace s21 {
+
+struct TsmResult;
+
+/**
+ * Construction heuristic used to warm-start the ant colony. kBest builds both
+ * tours and keeps the shorter one.
+ */
+enum class InitialTour { kNone, kNearestNeighbour, kSpanningTree, kBest };
+
+class TourConstruction {
+ public:
+  /**
+   * Builds a tour by always moving to the nearest unvisited vertex.
+   *
+   * @param graph the graph representing the cities and distances
+   * @param start the first vertex of the tour
+   *
+   * @return the tour, or an empty path with the maximal distance if the walk
+   * got stuck on a missing edge
+   */
+  static TsmResult NearestNeighbour(const Graph &graph, int start = 0);
+
+  /**
+   * Builds a tour by the double-tree heuristic: the vertices are visited in
+   * the preorder of the minimum spanning tree rooted at vertex 0.
+   *
+   * @param graph the graph representing the cities and distances
+   *
+   * @return the tour, or an empty path with the maximal distance if the graph
+   * is not connected or a shortcut uses a missing edge
+   */
+  static TsmResult SpanningTreeWalk(const Graph &graph);
+
+  /**
+   * Builds the initial tour of the given kind.
+   *
+   * @param graph the graph representing the cities and distances
+   * @param kind the construction heuristic
+   *
+   * @return the tour, or an empty path with the maximal distance if the
+   * heuristic did not produce one
+   */
+  static TsmResult Build(const Graph &graph, InitialTour kind);
+
+ private:
+  static TsmResult ClosedTour(const Graph &graph, std::vector<int> order);
+};
+
+}  // namespace s21
+
+#endif  // SRC_MODEL_S21_TOUR_CONSTRUCTION_H_
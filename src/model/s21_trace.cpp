@@ -0,0 +1,183 @@
+#include "s21_trace.h"
+
+#include <array>
+#include <atomic>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace s21 {
+
+namespace {
+const std::size_t kChunkEvents = 4096;
+const std::size_t kMaxChunks = 1024;
+
+struct Event {
+  const char *name;
+  double start_us;
+  double duration_us;
+  const char *arg_names[2];
+  std::int64_t arg_values[2];
+};
+
+/**
+ * Events of one thread. Only the owner thread appends; an event becomes
+ * visible to the reader when size is published with release order. Chunks are
+ * never moved, so the reader does not race with the allocation of new ones.
+ */
+struct ThreadBuffer {
+  explicit ThreadBuffer(int thread_id) : id(thread_id) {}
+
+  ~ThreadBuffer() {
+    for (auto &chunk : chunks) delete[] chunk.load(std::memory_order_relaxed);
+  }
+
+  void Append(const Event &event) {
+    const std::size_t kIndex = size.load(std::memory_order_relaxed);
+    const std::size_t kChunk = kIndex / kChunkEvents;
+    if (kChunk == kMaxChunks) return;
+    Event *chunk = chunks[kChunk].load(std::memory_order_relaxed);
+    if (!chunk) {
+      chunk = new Event[kChunkEvents];
+      chunks[kChunk].store(chunk, std::memory_order_release);
+    }
+    chunk[kIndex % kChunkEvents] = event;
+    size.store(kIndex + 1, std::memory_order_release);
+  }
+
+  const Event &At(std::size_t index) const {
+    return chunks[index / kChunkEvents].load(
+        std::memory_order_acquire)[index % kChunkEvents];
+  }
+
+  const int id;
+  std::atomic<std::size_t> size{0};
+  std::array<std::atomic<Event *>, kMaxChunks> chunks{};
+};
+
+std::atomic<bool> enabled{false};
+const auto kEpoch = std::chrono::steady_clock::now();
+
+// Буферы живут дольше своих потоков, чтобы их события попали в файл.
+std::mutex registry_mutex;
+std::vector<std::unique_ptr<ThreadBuffer>> registry;
+// Буферы завершившихся потоков, новые потоки дописывают в них.
+std::vector<ThreadBuffer *> free_buffers;
+
+/**
+ * The buffer of a thread, returned to the free list when the thread exits.
+ * Algorithms start new threads for every layer, epoch or round, and so the
+ * number of buffers stays at the number of threads that traced at the same
+ * time. A reused buffer keeps its id: its threads never overlap in time and
+ * share one row of the timeline.
+ */
+class BufferLease {
+ public:
+  BufferLease() {
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    if (!free_buffers.empty()) {
+      buffer_ = free_buffers.back();
+      free_buffers.pop_back();
+      return;
+    }
+    registry.push_back(
+        std::make_unique<ThreadBuffer>(static_cast<int>(registry.size()) + 1));
+    buffer_ = registry.back().get();
+  }
+
+  ~BufferLease() {
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    free_buffers.push_back(buffer_);
+  }
+
+  BufferLease(const BufferLease &) = delete;
+  BufferLease &operator=(const BufferLease &) = delete;
+
+  ThreadBuffer &Buffer() { return *buffer_; }
+
+ private:
+  ThreadBuffer *buffer_ = nullptr;
+};
+
+ThreadBuffer &LocalBuffer() {
+  thread_local BufferLease lease;
+  return lease.Buffer();
+}
+
+double Microseconds(std::chrono::steady_clock::time_point time) {
+  return std::chrono::duration<double, std::micro>(time - kEpoch).count();
+}
+}  // namespace
+
+void Trace::Start() {
+  std::lock_guard<std::mutex> lock(registry_mutex);
+  for (auto &buffer : registry)
+    buffer->size.store(0, std::memory_order_relaxed);
+  enabled.store(true, std::memory_order_release);
+}
+
+void Trace::Stop() { enabled.store(false, std::memory_order_release); }
+
+bool Trace::IsEnabled() { return enabled.load(std::memory_order_relaxed); }
+
+void Trace::WriteChromeTrace(std::ostream &stream) {
+  std::lock_guard<std::mutex> lock(registry_mutex);
+  const auto kPrecision = stream.precision(15);
+  stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  bool first = true;
+  for (const auto &buffer : registry) {
+    const std::size_t kSize = buffer->size.load(std::memory_order_acquire);
+    for (std::size_t i = 0; i != kSize; ++i) {
+      const Event &event = buffer->At(i);
+      stream << (first ? "\n" : ",\n") << "{\"name\":\"" << event.name
+             << "\",\"cat\":\"s21\",\"ph\":\"X\",\"pid\":1,\"tid\":"
+             << buffer->id << ",\"ts\":" << event.start_us
+             << ",\"dur\":" << event.duration_us << ",\"args\":{";
+      for (int arg = 0; arg != 2 && event.arg_names[arg]; ++arg)
+        stream << (arg ? "," : "") << '"' << event.arg_names[arg]
+               << "\":" << event.arg_values[arg];
+      stream << "}}";
+      first = false;
+    }
+  }
+  stream << "\n]}\n";
+  stream.precision(kPrecision);
+}
+
+void Trace::WriteChromeTrace(const std::string &filename) {
+  std::ofstream file(filename, std::ios::trunc);
+  if (!file.is_open()) {
+    throw std::runtime_error("[ [Wrong argument] ] :: File was not created\n");
+  }
+  WriteChromeTrace(file);
+}
+
+Trace::Scope::Scope(const char *name, const char *arg1, std::int64_t value1,
+                    const char *arg2, std::int64_t value2)
+    : enabled_(IsEnabled()),
+      name_(name),
+      arg_names_{arg1, arg2},
+      arg_values_{value1, value2} {
+  if (enabled_) start_ = std::chrono::steady_clock::now();
+}
+
+Trace::Scope::~Scope() {
+  if (!enabled_) return;
+  const auto kEnd = std::chrono::steady_clock::now();
+  Event event = {name_,
+                 Microseconds(start_),
+                 std::chrono::duration<double, std::micro>(kEnd - start_)
+                     .count(),
+                 {arg_names_[0], arg_names_[1]},
+                 {arg_values_[0], arg_values_[1]}};
+  LocalBuffer().Append(event);
+}
+
+void Trace::Scope::Arg(int index, const char *name, std::int64_t value) {
+  arg_names_[index] = name;
+  arg_values_[index] = value;
+}
+
+}  // namespace s21
@@ -0,0 +1,88 @@
+#ifndef SRC_MODEL_S21_TRACE_H_
+#define SRC_MODEL_S21_TRACE_H_
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace s21 {
+
+/**
+ * Timeline of the algorithm phases in the Chrome trace event format, opened by
+ * chrome://tracing and Perfetto. Tracing is switched on and off at run time;
+ * while it is off a scope costs one relaxed atomic load.
+ *
+ * Every thread appends events to its own buffer without locks, the buffers are
+ * only read by WriteChromeTrace. A buffer outlives its thread and is reused by
+ * the next thread that starts tracing, so short-lived worker threads do not
+ * add buffers. Event and argument names must be string literals, since only
+ * the pointers are stored.
+ */
+class Trace {
+ public:
+  /**
+   * Clears the recorded events and starts recording. Must not be called while
+   * algorithms are running in other threads.
+   */
+  static void Start();
+
+  /**
+   * Stops recording, the recorded events are kept.
+   */
+  static void Stop();
+
+  static bool IsEnabled();
+
+  /**
+   * Writes the recorded events as a JSON trace. Events are recorded up to a
+   * limit per thread; the rest are dropped.
+   *
+   * @param stream the output stream
+   */
+  static void WriteChromeTrace(std::ostream &stream);
+
+  /**
+   * Writes the recorded events to a JSON file.
+   *
+   * @param filename the name of the file, usually trace.json
+   *
+   * @throws std::runtime_error if the file could not be created
+   */
+  static void WriteChromeTrace(const std::string &filename);
+
+  /**
+   * A complete event covering the lifetime of the object, with up to two
+   * integer arguments.
+   */
+  class Scope {
+   public:
+    explicit Scope(const char *name, const char *arg1 = nullptr,
+                   std::int64_t value1 = 0, const char *arg2 = nullptr,
+                   std::int64_t value2 = 0);
+    ~Scope();
+    Scope(const Scope &) = delete;
+    Scope &operator=(const Scope &) = delete;
+
+    /**
+     * Sets an argument known only at the end of the scope, such as the size of
+     * a loaded graph.
+     *
+     * @param index 0 or 1
+     * @param name the name of the argument
+     * @param value the value of the argument
+     */
+    void Arg(int index, const char *name, std::int64_t value);
+
+   private:
+    bool enabled_ = false;
+    const char *name_ = nullptr;
+    const char *arg_names_[2] = {nullptr, nullptr};
+    std::int64_t arg_values_[2] = {0, 0};
+    std::chrono::steady_clock::time_point start_;
+  };
+};
+
+}  // namespace s21
+
+#endif  // SRC_MODEL_S21_TRACE_H_
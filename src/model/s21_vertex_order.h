@@ -0,0 +1,213 @@
+#ifndef SRC_MODEL_S21_VERTEX_ORDER_H_
+#define SRC_MODEL_S21_VERTEX_ORDER_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace s21 {
+
+/**
+ * The order a storage can renumber its vertices in to keep the neighbours of
+ * a vertex close in memory:
+ *
+ *   kOriginal              the numbers of the input file
+ *   kReverseCuthillMcKee   breadth-first from a vertex of the least degree,
+ *                          neighbours by increasing degree, then reversed;
+ *                          keeps the edges near the diagonal of the matrix
+ *   kBreadthFirst          breadth-first from vertex 0, neighbours by number
+ *   kDegree                by decreasing degree, the hubs first
+ */
+enum class VertexOrder {
+  kOriginal,
+  kReverseCuthillMcKee,
+  kBreadthFirst,
+  kDegree
+};
+
+/**
+ * The correspondence between the original vertex numbers, as in the input
+ * file, and the internal ones of a renumbered storage. Both are counted
+ * from 0. A default permutation is the identity of any size.
+ */
+class VertexPermutation {
+ public:
+  VertexPermutation() = default;
+
+  /**
+   * @param to_original the original number of every internal vertex
+   *
+   * @throws std::invalid_argument if the numbers are not a permutation
+   */
+  explicit VertexPermutation(std::vector<int> to_original)
+      : to_original_(std::move(to_original)),
+        to_internal_(to_original_.size(), -1) {
+    const int kSize = static_cast<int>(to_original_.size());
+    bool identity = true;
+    for (int internal = 0; internal < kSize; ++internal) {
+      const int kOriginal = to_original_[internal];
+      if (kOriginal < 0 || kOriginal >= kSize ||
+          to_internal_[kOriginal] != -1) {
+        throw std::invalid_argument(
+            "[ [Wrong argument] ] :: Vertex order is not a permutation\n");
+      }
+      to_internal_[kOriginal] = internal;
+      identity = identity && kOriginal == internal;
+    }
+    // Тождественная перестановка хранится пустой.
+    if (identity) {
+      to_original_.clear();
+      to_internal_.clear();
+    }
+  }
+
+  bool IsIdentity() const { return to_original_.empty(); }
+
+  /**
+   * @return the number of vertices, 0 for the identity
+   */
+  int size() const { return static_cast<int>(to_original_.size()); }
+
+  int ToInternal(int original) const {
+    return IsIdentity() ? original : to_internal_[original];
+  }
+
+  int ToOriginal(int internal) const {
+    return IsIdentity() ? internal : to_original_[internal];
+  }
+
+  /**
+   * Composes the permutations of two renumberings in a row.
+   *
+   * @param step the renumbering of the internal vertices of this permutation
+   *
+   * @return the permutation from the original numbers to the numbers after
+   * the step
+   */
+  VertexPermutation Then(const VertexPermutation &step) const {
+    if (step.IsIdentity()) return *this;
+    std::vector<int> to_original(step.size());
+    for (int internal = 0; internal < step.size(); ++internal) {
+      to_original[internal] = ToOriginal(step.ToOriginal(internal));
+    }
+    return VertexPermutation(std::move(to_original));
+  }
+
+  /**
+   * Renumbers a square matrix of vectors, such as distances or a spanning
+   * tree, whose rows and columns are internal vertices.
+   *
+   * @return the matrix with the original numbers
+   */
+  template <typename Matrix>
+  Matrix MatrixToOriginal(Matrix internal) const {
+    return Renumbered(std::move(internal), to_original_);
+  }
+
+  /**
+   * @return the matrix of the original numbers with the internal ones
+   */
+  template <typename Matrix>
+  Matrix MatrixToInternal(Matrix original) const {
+    return Renumbered(std::move(original), to_internal_);
+  }
+
+  bool operator==(const VertexPermutation &other) const {
+    return to_original_ == other.to_original_;
+  }
+
+ private:
+  // Строка и столбец i переходят на место numbers[i].
+  template <typename Matrix>
+  static Matrix Renumbered(Matrix cells, const std::vector<int> &numbers) {
+    if (numbers.empty()) return cells;
+    Matrix renumbered(cells.size(),
+                      typename Matrix::value_type(cells.size()));
+    for (std::size_t i = 0; i < cells.size(); ++i) {
+      auto &row = renumbered[numbers[i]];
+      for (std::size_t j = 0; j < cells.size(); ++j) {
+        row[numbers[j]] = cells[i][j];
+      }
+    }
+    return renumbered;
+  }
+
+  std::vector<int> to_original_;
+  std::vector<int> to_internal_;
+};
+
+/**
+ * Computes a new numbering of the vertices of a graph view, see
+ * s21_graph_view.h. Every connected part is numbered in one run, so the
+ * vertices of a part lie together. Directed graphs are ordered by their
+ * outgoing arcs.
+ *
+ * @param graph the graph to renumber
+ * @param order the order of the new numbers
+ *
+ * @return the permutation from the current numbers of the view to the new
+ * ones
+ */
+template <typename View>
+VertexPermutation ComputeVertexOrder(const View &graph, VertexOrder order) {
+  const int kSize = graph.size();
+  if (order == VertexOrder::kOriginal) return VertexPermutation();
+  std::vector<int> degree(kSize, 0);
+  for (int vertex = 0; vertex < kSize; ++vertex) {
+    graph.ForEachNeighbour(vertex, [&](int to, auto) {
+      if (to != vertex) ++degree[vertex];
+    });
+  }
+  std::vector<int> by_degree(kSize);
+  std::iota(by_degree.begin(), by_degree.end(), 0);
+  const auto kLessDegree = [&degree](int left, int right) {
+    return degree[left] < degree[right];
+  };
+
+  if (order == VertexOrder::kDegree) {
+    std::stable_sort(by_degree.begin(), by_degree.end(),
+                     [&kLessDegree](int left, int right) {
+                       return kLessDegree(right, left);
+                     });
+    return VertexPermutation(std::move(by_degree));
+  }
+
+  const bool kCuthillMcKee = order == VertexOrder::kReverseCuthillMcKee;
+  if (kCuthillMcKee) {
+    std::stable_sort(by_degree.begin(), by_degree.end(), kLessDegree);
+  }
+  // Очередью обхода служит сам массив нового порядка.
+  std::vector<int> visit_order;
+  visit_order.reserve(kSize);
+  std::vector<bool> visited(kSize, false);
+  std::vector<int> neighbours;
+  for (int start : by_degree) {
+    if (visited[start]) continue;
+    visited[start] = true;
+    visit_order.push_back(start);
+    for (std::size_t head = visit_order.size() - 1; head < visit_order.size();
+         ++head) {
+      neighbours.clear();
+      graph.ForEachNeighbour(visit_order[head], [&](int to, auto) {
+        if (!visited[to]) {
+          visited[to] = true;
+          neighbours.push_back(to);
+        }
+      });
+      if (kCuthillMcKee) {
+        std::stable_sort(neighbours.begin(), neighbours.end(), kLessDegree);
+      }
+      visit_order.insert(visit_order.end(), neighbours.begin(),
+                         neighbours.end());
+    }
+  }
+  if (kCuthillMcKee) std::reverse(visit_order.begin(), visit_order.end());
+  return VertexPermutation(std::move(visit_order));
+}
+
+}  // namespace s21
+
+#endif  // SRC_MODEL_S21_VERTEX_ORDER_H_
@@ -0,0 +1,457 @@
+#ifndef SRC_MODEL_S21_VIEW_ALGORITHMS_H_
+#define SRC_MODEL_S21_VIEW_ALGORITHMS_H_
+
+#include <functional>
+#include <queue>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "dependencies/s21_queue.h"
+#include "dependencies/s21_stack.h"
+#include "s21_algorithm_stats.h"
+#include "s21_graph_view.h"
+#include "s21_packed_matrix.h"
+
+namespace s21 {
+
+/**
+ * The algorithms of GraphAlgorithms for any graph view, see s21_graph_view.h.
+ * The view is a template parameter, so the inner loops call its
+ * ForEachNeighbour directly. Dense views get the O(V^2) array scans that suit
+ * an adjacency matrix, sparse views get binary heaps; the choice is made at
+ * compile time. Symmetric views get their distance matrix and spanning tree
+ * as a PackedSymmetricMatrix. Renumbered views take and return the original
+ * vertex numbers; ties between neighbours are broken by the internal ones.
+ */
+class ViewAlgorithms {
+ public:
+  template <typename View>
+  using Weight = typename GraphViewTraits<View>::Weight;
+  template <typename View>
+  using Distance = typename GraphViewTraits<View>::Distance;
+  template <typename View, typename T>
+  using ResultMatrix =
+      std::conditional_t<GraphViewTraits<View>::kSymmetric,
+                         PackedSymmetricMatrix<T>, BasicMatrix<T>>;
+
+  /**
+   * Depth-first search, see GraphAlgorithms::DepthFirstSearch.
+   *
+   * @throws std::invalid_argument if the start vertex is invalid
+   */
+  template <typename View>
+  static vector<int> DepthFirstSearch(const View &graph, int start) {
+    if (start >= graph.size() || start < 0) {
+      throw std::invalid_argument(
+          "[ [Wrong argument] ] :: Graph or start vertex is invalid\n");
+    }
+    S21_STATS_SCOPE("DepthFirstSearch");
+    vector<bool> visited(graph.size(), false);
+    vector<int> passed_path;
+    vector<int> neighbours;
+    Stack<int> vertices_stack;
+
+    vertices_stack.push(ToInternal(graph, start));
+    S21_STATS_ADD(heap_operations, 1);
+
+    while (!vertices_stack.empty()) {
+      int vertex = vertices_stack.top();
+      vertices_stack.pop();
+      S21_STATS_ADD(heap_operations, 1);
+
+      if (!visited[vertex]) {
+        visited[vertex] = true;
+        passed_path.push_back(ToOriginal(graph, vertex) + 1);
+        S21_STATS_ADD(vertices_popped, 1);
+
+        // Соседи кладутся в стек с конца, чтобы первым извлекался меньший.
+        neighbours.clear();
+        graph.ForEachNeighbour(vertex, [&neighbours](int to, Weight<View>) {
+          neighbours.push_back(to);
+        });
+        for (auto it = neighbours.rbegin(); it != neighbours.rend(); ++it) {
+          S21_STATS_ADD(edges_scanned, 1);
+          if (!visited[*it]) {
+            vertices_stack.push(*it);
+            S21_STATS_ADD(heap_operations, 1);
+          }
+        }
+      }
+    }
+    return passed_path;
+  }
+
+  /**
+   * Breadth-first search, see GraphAlgorithms::BreadthFirstSearch.
+   *
+   * @throws std::out_of_range if the start vertex is invalid
+   */
+  template <typename View>
+  static vector<int> BreadthFirstSearch(const View &graph, int start) {
+    if (start >= graph.size() || start < 0) {
+      throw std::out_of_range(
+          "[ [Wrong argument] ] :: Graph or start vertex is invalid\n");
+    }
+    S21_STATS_SCOPE("BreadthFirstSearch");
+    vector<bool> visited(graph.size(), false);
+    vector<int> passed_path;
+    Queue<int> vertices_queue;
+
+    vertices_queue.push(ToInternal(graph, start));
+    S21_STATS_ADD(heap_operations, 1);
+
+    while (!vertices_queue.empty()) {
+      int vertex = vertices_queue.front();
+      vertices_queue.pop();
+      S21_STATS_ADD(heap_operations, 1);
+
+      if (!visited[vertex]) {
+        visited[vertex] = true;
+        passed_path.push_back(ToOriginal(graph, vertex) + 1);
+        S21_STATS_ADD(vertices_popped, 1);
+
+        graph.ForEachNeighbour(vertex, [&](int to, Weight<View>) {
+          S21_STATS_ADD(edges_scanned, 1);
+          if (!visited[to]) {
+            vertices_queue.push(to);
+            S21_STATS_ADD(heap_operations, 1);
+          }
+        });
+      }
+    }
+    return passed_path;
+  }
+
+  /**
+   * Dijkstra's algorithm between two vertices, counted from 1, see
+   * GraphAlgorithms::GetShortestPathBetweenVertices.
+   *
+   * @return the length of the path, WeightTraits::kInfinity if there is none
+   *
+   * @throws std::invalid_argument if a vertex is invalid
+   */
+  template <typename View>
+  static Distance<View> GetShortestPathBetweenVertices(const View &graph,
+                                                       int vertex1,
+                                                       int vertex2) {
+    if (vertex1 < 1 || vertex1 > graph.size() || vertex2 < 1 ||
+        vertex2 > graph.size()) {
+      throw std::invalid_argument(
+          "[ [Wrong argument] ] :: Graph or start/end vertex is invalid\n");
+    }
+    // Счет идет с 0, но пользователь задает с 1, для этого уменьшаем на 1.
+    vertex1 = ToInternal(graph, vertex1 - 1);
+    vertex2 = ToInternal(graph, vertex2 - 1);
+    S21_STATS_SCOPE("GetShortestPathBetweenVertices");
+    S21_STATS_MEMORY(graph.size() * (sizeof(Distance<View>) + sizeof(bool)));
+    using Traits = WeightTraits<Weight<View>>;
+    vector<Distance<View>> distance(graph.size(), Traits::kInfinity);
+    vector<bool> visited(graph.size(), false);
+    distance[vertex1] = 0;
+
+    using Entry = std::pair<Distance<View>, int>;
+    std::priority_queue<Entry, vector<Entry>, std::greater<>> heap;
+    heap.emplace(0, vertex1);
+
+    // Релаксация рёбер вершины; в кучу попадают только улучшенные вершины.
+    auto Relax = [&](int vertex) {
+      visited[vertex] = true;
+      S21_STATS_ADD(vertices_popped, 1);
+      graph.ForEachNeighbour(vertex, [&](int to, Weight<View> weight) {
+        if (visited[to]) return;
+        S21_STATS_ADD(edges_scanned, 1);
+        const Distance<View> kLength = Traits::Add(distance[vertex], weight);
+        if (kLength < distance[to]) {
+          distance[to] = kLength;
+          S21_STATS_ADD(edges_relaxed, 1);
+          if constexpr (!GraphViewTraits<View>::kDense) {
+            heap.emplace(kLength, to);
+            S21_STATS_ADD(heap_operations, 1);
+          }
+        }
+      });
+    };
+
+    if constexpr (GraphViewTraits<View>::kDense) {
+      // Поиск минимума по массиву: для матрицы смежности это O(V^2), как и
+      // просмотр всех рёбер.
+      for (int step = 0; step < graph.size(); ++step) {
+        int process_vertex = -1;
+        for (int i = 0; i < graph.size(); ++i) {
+          if (!visited[i] && distance[i] != Traits::kInfinity &&
+              (process_vertex < 0 || distance[i] < distance[process_vertex])) {
+            process_vertex = i;
+          }
+        }
+        if (process_vertex < 0 || process_vertex == vertex2) break;
+        Relax(process_vertex);
+      }
+    } else {
+      while (!heap.empty()) {
+        const auto [kLength, kVertex] = heap.top();
+        heap.pop();
+        S21_STATS_ADD(heap_operations, 1);
+        // Устаревшие записи кучи пропускаются.
+        if (visited[kVertex] || kLength != distance[kVertex]) continue;
+        if (kVertex == vertex2) break;
+        Relax(kVertex);
+      }
+    }
+    return distance[vertex2];
+  }
+
+  /**
+   * Floyd-Warshall algorithm, see
+   * GraphAlgorithms::GetShortestPathsBetweenAllVertices.
+   *
+   * @throws std::invalid_argument if the graph is empty
+   */
+  template <typename View>
+  static ResultMatrix<View, Distance<View>> GetShortestPathsBetweenAllVertices(
+      const View &graph) {
+    if (graph.size() == 0) {
+      throw std::invalid_argument(
+          "[ [Wrong argument] ] :: Graph or start vertex is invalid\n");
+    }
+    S21_STATS_SCOPE("GetShortestPathsBetweenAllVertices");
+    if constexpr (GraphViewTraits<View>::kSymmetric) {
+      return ToOriginalNumbers(graph, SymmetricShortestPaths(graph));
+    } else {
+      S21_STATS_MEMORY(sizeof(Distance<View>) * graph.size() * graph.size());
+      using Traits = WeightTraits<Weight<View>>;
+      const Distance<View> kinf = Traits::kInfinity;
+      BasicMatrix<Distance<View>> distance(
+          graph.size(), vector<Distance<View>>(graph.size(), kinf));
+
+      // Инициализация матрицы distance ребрами графа
+      {
+        S21_STATS_PHASE("initialization");
+        for (int i = 0; i < graph.size(); ++i) {
+          graph.ForEachNeighbour(i, [&](int j, Weight<View> weight) {
+            distance[i][j] = weight;
+          });
+          distance[i][i] = 0;
+        }
+      }
+
+      // Алгоритм Флойда-Уоршелла
+      S21_STATS_PHASE("relaxation");
+      for (int k = 0; k < graph.size(); ++k) {
+        const vector<Distance<View>> &through = distance[k];
+        for (int i = 0; i < graph.size(); ++i) {
+          const Distance<View> kToPivot = distance[i][k];
+          if (kToPivot == kinf) continue;
+          RelaxRow<View>(kToPivot, through.data(), distance[i].data(),
+                         graph.size());
+        }
+      }
+      return ToOriginalNumbers(graph, std::move(distance));
+    }
+  }
+
+  /**
+   * Prim's algorithm, see GraphAlgorithms::GetLeastSpanningTree.
+   *
+   * @throws std::invalid_argument if the graph is empty
+   * @throws std::out_of_range if the graph is not connected
+   */
+  template <typename View>
+  static ResultMatrix<View, Weight<View>> GetLeastSpanningTree(
+      const View &graph) {
+    const int size = graph.size();
+    if (size == 0) {
+      throw std::invalid_argument(
+          "[ [Wrong argument] ] :: Graph is invalid\n");
+    }
+    S21_STATS_SCOPE("GetLeastSpanningTree");
+    std::size_t tree_cells = static_cast<std::size_t>(size) * size;
+    if constexpr (GraphViewTraits<View>::kSymmetric) {
+      tree_cells = PackedSymmetricMatrix<Weight<View>>::Cells(size);
+    }
+    S21_STATS_MEMORY(sizeof(Weight<View>) * tree_cells +
+                     (sizeof(Distance<View>) + sizeof(int)) * size + size);
+    const Distance<View> kInfinity = WeightTraits<Weight<View>>::kInfinity;
+    vector<bool> visited(size, false);
+    vector<Distance<View>> distances(size, kInfinity);
+    vector<int> parents(size, -1);
+    ResultMatrix<View, Weight<View>> spanning_tree;
+    if constexpr (GraphViewTraits<View>::kSymmetric) {
+      spanning_tree = PackedSymmetricMatrix<Weight<View>>(size, 0);
+    } else {
+      spanning_tree.assign(size, vector<Weight<View>>(size, 0));
+    }
+
+    using Entry = std::pair<Distance<View>, int>;
+    std::priority_queue<Entry, vector<Entry>, std::greater<>> heap;
+    distances[0] = 0;
+    heap.emplace(0, 0);
+
+    for (int i = 0; i < size; ++i) {
+      int min_vertex = -1;
+      if constexpr (GraphViewTraits<View>::kDense) {
+        Distance<View> min_distance = kInfinity;
+        for (int j = 0; j < size; ++j) {
+          if (!visited[j] && distances[j] < min_distance) {
+            min_distance = distances[j];
+            min_vertex = j;
+          }
+        }
+      } else {
+        while (!heap.empty() && min_vertex < 0) {
+          auto [length, vertex] = heap.top();
+          heap.pop();
+          if (!visited[vertex] && length == distances[vertex]) {
+            min_vertex = vertex;
+          }
+        }
+      }
+      if (min_vertex < 0) {
+        throw std::out_of_range(
+            "[ [Wrong argument] ] :: Graph is not connected\n");
+      }
+
+      visited[min_vertex] = true;
+      S21_STATS_ADD(vertices_popped, 1);
+
+      if (parents[min_vertex] != -1) {
+        const auto kWeight = static_cast<Weight<View>>(distances[min_vertex]);
+        if constexpr (GraphViewTraits<View>::kSymmetric) {
+          spanning_tree(parents[min_vertex], min_vertex) = kWeight;
+        } else {
+          spanning_tree[parents[min_vertex]][min_vertex] = kWeight;
+          spanning_tree[min_vertex][parents[min_vertex]] = kWeight;
+        }
+      }
+
+      graph.ForEachNeighbour(min_vertex, [&](int j, Weight<View> weight) {
+        if (!visited[j] && weight < distances[j]) {
+          parents[j] = min_vertex;
+          distances[j] = weight;
+          S21_STATS_ADD(edges_relaxed, 1);
+          if constexpr (!GraphViewTraits<View>::kDense) {
+            heap.emplace(distances[j], j);
+          }
+        }
+      });
+    }
+    return ToOriginalNumbers(graph, std::move(spanning_tree));
+  }
+
+ private:
+  template <typename View>
+  static int ToInternal(const View &graph, int vertex) {
+    if constexpr (GraphViewTraits<View>::kRenumbered) {
+      return graph.Permutation().ToInternal(vertex);
+    } else {
+      return vertex;
+    }
+  }
+
+  template <typename View>
+  static int ToOriginal(const View &graph, int vertex) {
+    if constexpr (GraphViewTraits<View>::kRenumbered) {
+      return graph.Permutation().ToOriginal(vertex);
+    } else {
+      return vertex;
+    }
+  }
+
+  /**
+   * Moves the cells of a matrix of internal vertex numbers to the original
+   * ones.
+   */
+  template <typename View, typename T>
+  static BasicMatrix<T> ToOriginalNumbers(const View &graph,
+                                          BasicMatrix<T> internal) {
+    if constexpr (GraphViewTraits<View>::kRenumbered) {
+      return graph.Permutation().MatrixToOriginal(std::move(internal));
+    } else {
+      return internal;
+    }
+  }
+
+  template <typename View, typename T>
+  static PackedSymmetricMatrix<T> ToOriginalNumbers(
+      const View &graph, PackedSymmetricMatrix<T> internal) {
+    if constexpr (GraphViewTraits<View>::kRenumbered) {
+      if (graph.Permutation().IsIdentity()) return internal;
+      PackedSymmetricMatrix<T> original(internal.size(), T());
+      for (int i = 0; i < graph.size(); ++i) {
+        for (int j = i; j < graph.size(); ++j) {
+          original(ToOriginal(graph, i), ToOriginal(graph, j)) =
+              internal(i, j);
+        }
+      }
+      return original;
+    } else {
+      return internal;
+    }
+  }
+
+  /**
+   * Relaxes row[j] through the pivot for j < count: row[j] = min(row[j],
+   * to_pivot + through[j]).
+   */
+  template <typename View>
+  static void RelaxRow(Distance<View> to_pivot, const Distance<View> *through,
+                       Distance<View> *row, int count) {
+    using Traits = WeightTraits<Weight<View>>;
+    for (int j = 0; j < count; ++j) {
+      // Бесконечность float поглощает сложение сама, целые суммы
+      // насыщаются; проверка выбирается при компиляции.
+      Distance<View> length;
+      if constexpr (Traits::kFractional) {
+        length = to_pivot + through[j];
+      } else {
+        length = Traits::Add(to_pivot, through[j]);
+      }
+      if (length < row[j]) {
+        row[j] = length;
+        S21_STATS_ADD(cells_updated, 1);
+      }
+    }
+  }
+
+  /**
+   * Floyd-Warshall algorithm on the upper triangle. Row and column k do not
+   * change on step k, so the row k is copied once per step and every row i
+   * is relaxed from the diagonal on, in one contiguous loop.
+   */
+  template <typename View>
+  static PackedSymmetricMatrix<Distance<View>> SymmetricShortestPaths(
+      const View &graph) {
+    const int kSize = graph.size();
+    S21_STATS_MEMORY(sizeof(Distance<View>) *
+                     (PackedSymmetricMatrix<Distance<View>>::Cells(kSize) +
+                      kSize));
+    const Distance<View> kinf = WeightTraits<Weight<View>>::kInfinity;
+    PackedSymmetricMatrix<Distance<View>> distance(kSize, kinf);
+    {
+      S21_STATS_PHASE("initialization");
+      for (int i = 0; i < kSize; ++i) {
+        graph.ForEachNeighbour(i, [&](int j, Weight<View> weight) {
+          if (j > i) distance(i, j) = weight;
+        });
+        distance(i, i) = 0;
+      }
+    }
+
+    S21_STATS_PHASE("relaxation");
+    vector<Distance<View>> through(kSize);
+    for (int k = 0; k < kSize; ++k) {
+      for (int j = 0; j < kSize; ++j) through[j] = distance(k, j);
+      for (int i = 0; i < kSize; ++i) {
+        if (through[i] == kinf) continue;
+        RelaxRow<View>(through[i], through.data() + i, distance.UpperRow(i),
+                       kSize - i);
+      }
+    }
+    return distance;
+  }
+};
+
+}  // namespace s21
+
+#endif  // SRC_MODEL_S21_VIEW_ALGORITHMS_H_
@@ -230,7 +230,7 @@ TEST(GetLeastSpanningTree, validGraph) {
   graph.loadGraphFromFile("test/graphs/ost.txt");
   vector<vector<int>> res = GraphAlgorithms::GetLeastSpanningTree(graph);
 
-  EXPECT_EQ(GraphAlgorithms::CalculateGraphWeight(res), 49);
+  EXPECT_EQ(GraphAlgorithms::CalculateGraphWeight(res), 57);
 }
 
 // TEST(SolveTravelingSalesmanProblem, WeightedUndirectedGraph) {
@@ -248,6 +248,1880 @@ TEST(SolveTravelingSalesmanProblem, wug2) {
   EXPECT_EQ(result.distance, expected.distance);
 }
 
+TEST(SolveTravelingSalesmanProblem, IterationCap) {
+  graph.loadGraphFromFile("test/graphs/valid_graph.txt");
+  TsmOptions options;
+  options.solver = TsmSolver::kAntColony;
+  options.max_iterations = 3;
+  std::size_t last_iteration = 0;
+  options.on_progress = [&last_iteration](const TsmProgress &progress) {
+    last_iteration = progress.iteration;
+  };
+  TsmResult result =
+      GraphAlgorithms::SolveTravelingSalesmanProblem(graph, options);
+  EXPECT_EQ(result.path.size(), 12);
+  EXPECT_LE(last_iteration, 3);
+}
+
+TEST(SolveTravelingSalesmanProblem, ProgressIsMonotonic) {
+  graph.loadGraphFromFile("test/graphs/valid_graph.txt");
+  TsmOptions options;
+  options.solver = TsmSolver::kAntColony;
+  options.stall_limit = 20;
+  vector<double> reported;
+  options.on_progress = [&reported](const TsmProgress &progress) {
+    reported.push_back(progress.best.distance);
+  };
+  TsmResult result =
+      GraphAlgorithms::SolveTravelingSalesmanProblem(graph, options);
+  ASSERT_FALSE(reported.empty());
+  for (std::size_t i = 1; i < reported.size(); ++i) {
+    EXPECT_LT(reported[i], reported[i - 1]);
+  }
+  EXPECT_EQ(reported.back(), result.distance);
+}
+
+TEST(SolveTravelingSalesmanProblem, Cancelled) {
+  graph.loadGraphFromFile("test/graphs/valid_graph.txt");
+  TsmOptions options;
+  options.cancellation.Cancel();
+  TsmResult result =
+      GraphAlgorithms::SolveTravelingSalesmanProblem(graph, options);
+  EXPECT_TRUE(result.path.empty());
+}
+
+TEST(SolveTravelingSalesmanProblem, TimeBudget) {
+  graph.loadGraphFromFile("test/graphs/valid_graph.txt");
+  TsmOptions options;
+  options.solver = TsmSolver::kAntColony;
+  options.stall_limit = 0;
+  options.time_budget = std::chrono::milliseconds(50);
+  auto start = std::chrono::steady_clock::now();
+  TsmResult result =
+      GraphAlgorithms::SolveTravelingSalesmanProblem(graph, options);
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  EXPECT_LT(elapsed, std::chrono::seconds(1));
+  EXPECT_EQ(result.path.size(), 12);
+}
+
+double TourCost(const Graph &graph, const vector<int> &path) {
+  double cost = 0;
+  for (std::size_t i = 0; i + 1 < path.size(); ++i) {
+    cost += graph[path[i]][path[i + 1]];
+  }
+  return cost;
+}
+
+bool IsClosedTour(const Graph &graph, const vector<int> &path) {
+  if (path.size() != static_cast<std::size_t>(graph.size()) + 1 ||
+      path.front() != path.back()) {
+    return false;
+  }
+  vector<int> vertices(path.begin(), path.end() - 1);
+  std::sort(vertices.begin(), vertices.end());
+  for (int i = 0; i < graph.size(); ++i) {
+    if (vertices[i] != i) return false;
+  }
+  return true;
+}
+
+TEST(LocalSearch, SymmetricTour) {
+  graph.loadGraphFromFile("test/graphs/euclidean_40.txt");
+  TsmResult tour;
+  for (int i = 0; i < graph.size(); ++i) tour.path.push_back(i);
+  tour.path.push_back(0);
+  tour.distance = TourCost(graph, tour.path);
+  double initial = tour.distance;
+
+  LocalSearch local_search(graph);
+  EXPECT_TRUE(local_search.Improve(tour));
+  EXPECT_TRUE(IsClosedTour(graph, tour.path));
+  EXPECT_EQ(tour.path.front(), 0);
+  EXPECT_LT(tour.distance, initial);
+  EXPECT_DOUBLE_EQ(tour.distance, TourCost(graph, tour.path));
+  EXPECT_FALSE(local_search.Improve(tour));
+}
+
+TEST(LocalSearch, AsymmetricTour) {
+  graph.loadGraphFromFile("test/graphs/asymmetric_30.txt");
+  TsmResult tour;
+  for (int i = graph.size() - 1; i >= 0; --i) tour.path.push_back(i);
+  tour.path.push_back(graph.size() - 1);
+  tour.distance = TourCost(graph, tour.path);
+  double initial = tour.distance;
+
+  LocalSearch local_search(graph);
+  EXPECT_TRUE(local_search.Improve(tour));
+  EXPECT_TRUE(IsClosedTour(graph, tour.path));
+  EXPECT_LT(tour.distance, initial);
+  EXPECT_DOUBLE_EQ(tour.distance, TourCost(graph, tour.path));
+}
+
+TEST(SolveTravelingSalesmanProblem, LocalSearchModes) {
+  graph.loadGraphFromFile("test/graphs/euclidean_40.txt");
+  for (auto mode : {LocalSearchMode::kNone, LocalSearchMode::kIterationBest,
+                    LocalSearchMode::kEveryAnt}) {
+    TsmOptions options;
+    options.max_iterations = 5;
+    options.solver = TsmSolver::kAntColony;
+    options.local_search = mode;
+    TsmResult result =
+        GraphAlgorithms::SolveTravelingSalesmanProblem(graph, options);
+    EXPECT_TRUE(IsClosedTour(graph, result.path));
+    EXPECT_DOUBLE_EQ(result.distance, TourCost(graph, result.path));
+  }
+}
+
+TEST(HeldKarp, OptimalTour) {
+  graph.loadGraphFromFile("test/graphs/valid_graph.txt");
+  TsmOptions options;
+  options.solver = TsmSolver::kHeldKarp;
+  TsmResult result =
+      GraphAlgorithms::SolveTravelingSalesmanProblem(graph, options);
+  EXPECT_TRUE(IsClosedTour(graph, result.path));
+  EXPECT_EQ(result.distance, 253);
+  EXPECT_DOUBLE_EQ(result.distance, TourCost(graph, result.path));
+}
+
+TEST(HeldKarp, AsymmetricTour) {
+  graph.loadGraphFromFile("test/graphs/asymmetric_30.txt");
+  ASSERT_THROW(HeldKarp{graph}, std::out_of_range);
+  // Таблица 24 вершин заняла бы 768 МиБ.
+  matrix complete(HeldKarp::kMaxVertices + 1,
+                  vector<int>(HeldKarp::kMaxVertices + 1, 1));
+  for (std::size_t i = 0; i < complete.size(); ++i) complete[i][i] = 0;
+  EXPECT_THROW(HeldKarp{Graph(complete)}, std::out_of_range);
+
+  graph.loadGraphFromFile("test/graphs/dwg.txt");
+  TsmResult result = HeldKarp(graph).Solve();
+  EXPECT_TRUE(IsClosedTour(graph, result.path));
+  EXPECT_DOUBLE_EQ(result.distance, TourCost(graph, result.path));
+  EXPECT_EQ(result.distance, 5);
+}
+
+TEST(HeldKarp, NoHamiltonianCycle) {
+  graph.loadGraphFromFile("test/graphs/unweighted_undirected_graph.txt");
+  TsmResult result = HeldKarp(graph).Solve();
+  EXPECT_TRUE(result.path.empty());
+
+  graph.loadGraphFromFile("test/graphs/wug.txt");
+  result = HeldKarp(graph).Solve();
+  EXPECT_TRUE(IsClosedTour(graph, result.path));
+  EXPECT_EQ(result.distance, 51);
+}
+
+TEST(HeldKarp, MatchesAntColonyOnSmallGraph) {
+  graph.loadGraphFromFile("test/graphs/wug2.txt");
+  TsmResult exact = GraphAlgorithms::SolveTravelingSalesmanProblem(graph);
+  EXPECT_EQ(exact.distance, 80);
+  EXPECT_EQ(exact.path.front(), 0);
+}
+
+TEST(TourConstruction, NearestNeighbour) {
+  graph.loadGraphFromFile("test/graphs/valid_graph.txt");
+  TsmResult tour = TourConstruction::NearestNeighbour(graph, 3);
+  EXPECT_TRUE(IsClosedTour(graph, tour.path));
+  EXPECT_EQ(tour.path.front(), 3);
+  EXPECT_DOUBLE_EQ(tour.distance, TourCost(graph, tour.path));
+
+  graph.loadGraphFromFile("test/graphs/unweighted_undirected_graph.txt");
+  EXPECT_TRUE(TourConstruction::NearestNeighbour(graph).path.empty());
+}
+
+TEST(GetLeastSpanningTree, SpansAllVertices) {
+  graph.loadGraphFromFile("test/graphs/valid_graph.txt");
+  matrix tree = GraphAlgorithms::GetLeastSpanningTree(graph);
+  EXPECT_EQ(GraphAlgorithms::CalculateGraphWeight(tree), 150);
+  for (int i = 0; i < graph.size(); ++i) {
+    EXPECT_GT(std::count_if(tree[i].begin(), tree[i].end(),
+                            [](int weight) { return weight > 0; }),
+              0);
+  }
+}
+
+TEST(TourConstruction, SpanningTreeWalk) {
+  graph.loadGraphFromFile("test/graphs/valid_graph.txt");
+  TsmResult tour = TourConstruction::SpanningTreeWalk(graph);
+  EXPECT_TRUE(IsClosedTour(graph, tour.path));
+  EXPECT_DOUBLE_EQ(tour.distance, TourCost(graph, tour.path));
+  // Для метрического графа обход дерева не более чем вдвое длиннее оптимума.
+  EXPECT_LE(tour.distance, 2 * 253);
+
+  // После перенумерации обход идёт по тому же дереву во внутренних номерах.
+  graph.loadGraphFromFile("test/graphs/euclidean_40.txt");
+  const long long kTreeWeight = GraphAlgorithms::CalculateGraphWeight(
+      GraphAlgorithms::GetLeastSpanningTree(graph));
+  graph.Reorder(VertexOrder::kDegree);
+  graph.Reorder(VertexOrder::kReverseCuthillMcKee);
+  ASSERT_FALSE(graph.Permutation().IsIdentity());
+  tour = TourConstruction::SpanningTreeWalk(graph);
+  EXPECT_TRUE(IsClosedTour(graph, tour.path));
+  EXPECT_DOUBLE_EQ(tour.distance, TourCost(graph, tour.path));
+  EXPECT_LE(tour.distance, 2 * kTreeWeight);
+}
+
+TEST(SolveTravelingSalesmanProblem, WarmStart) {
+  graph.loadGraphFromFile("test/graphs/euclidean_40.txt");
+  TsmResult initial = TourConstruction::Build(graph, InitialTour::kBest);
+  ASSERT_TRUE(IsClosedTour(graph, initial.path));
+
+  TsmOptions options;
+  options.solver = TsmSolver::kAntColony;
+  options.local_search = LocalSearchMode::kNone;
+  options.max_iterations = 1;
+  vector<std::size_t> iterations;
+  options.on_progress = [&iterations](const TsmProgress &progress) {
+    iterations.push_back(progress.iteration);
+  };
+  TsmResult result =
+      GraphAlgorithms::SolveTravelingSalesmanProblem(graph, options);
+  ASSERT_FALSE(iterations.empty());
+  EXPECT_EQ(iterations.front(), 0);
+  EXPECT_LE(result.distance, initial.distance);
+}
+
+TEST(IslandModel, DefaultParams) {
+  vector<AntColonyParams> params = IslandModel::DefaultParams(6, 42);
+  ASSERT_EQ(params.size(), 6);
+  EXPECT_EQ(params[0].alpha, AntColonyParams().alpha);
+  EXPECT_EQ(params[0].beta, AntColonyParams().beta);
+  for (std::size_t i = 0; i < params.size(); ++i) {
+    EXPECT_EQ(params[i].seed, 42 + i);
+  }
+  EXPECT_NE(params[1].beta, params[0].beta);
+}
+
+TEST(IslandModel, Solve) {
+  graph.loadGraphFromFile("test/graphs/euclidean_40.txt");
+  TsmOptions options;
+  options.solver = TsmSolver::kIslands;
+  options.max_iterations = 6;
+  options.islands.count = 3;
+  options.islands.migration_interval = 2;
+  options.islands.share_pheromone = true;
+  options.colony.seed = 7;
+  vector<double> reported;
+  options.on_progress = [&reported](const TsmProgress &progress) {
+    reported.push_back(progress.best.distance);
+  };
+  TsmResult result =
+      GraphAlgorithms::SolveTravelingSalesmanProblem(graph, options);
+  EXPECT_TRUE(IsClosedTour(graph, result.path));
+  EXPECT_DOUBLE_EQ(result.distance, TourCost(graph, result.path));
+  ASSERT_FALSE(reported.empty());
+  EXPECT_EQ(reported.back(), result.distance);
+
+  // Шаги муравьёв считаются на всех островах, а не только на управляющем.
+  options.on_progress = nullptr;
+  options.islands.count = 1;
+  GraphAlgorithms::SolveTravelingSalesmanProblem(graph, options);
+  const std::uint64_t kSingle = Statistics::Last().ant_steps;
+  options.islands.count = 3;
+  GraphAlgorithms::SolveTravelingSalesmanProblem(graph, options);
+  EXPECT_GT(kSingle, 0u);
+  EXPECT_GT(Statistics::Last().ant_steps, 2 * kSingle);
+}
+
+TEST(IslandModel, Checkpoint) {
+  graph.loadGraphFromFile("test/graphs/euclidean_40.txt");
+  const std::string filename = "test/islands.ckpt";
+  TsmOptions options;
+  options.solver = TsmSolver::kIslands;
+  options.max_iterations = 4;
+  options.islands.count = 3;
+  options.colony.seed = 9;
+  options.checkpoint_path = filename;
+  TsmResult result =
+      GraphAlgorithms::SolveTravelingSalesmanProblem(graph, options);
+  AntColony best(graph);
+  EXPECT_TRUE(best.LoadCheckpoint(filename));
+  EXPECT_EQ(best.Best().distance, result.distance);
+
+  options.checkpoint_path.clear();
+  options.resume_from = filename;
+  TsmResult resumed =
+      GraphAlgorithms::SolveTravelingSalesmanProblem(graph, options);
+  EXPECT_TRUE(IsClosedTour(graph, resumed.path));
+  EXPECT_LE(resumed.distance, result.distance);
+
+  // Точный решатель не пишет контрольных точек, а автоматический выбор на
+  // малом графе тогда отдаёт задачу колонии.
+  graph.loadGraphFromFile("test/graphs/valid_graph.txt");
+  options = TsmOptions();
+  options.max_iterations = 2;
+  options.checkpoint_path = filename;
+  EXPECT_THROW(HeldKarp(graph).Solve(options), std::invalid_argument);
+  std::remove(filename.c_str());
+  EXPECT_TRUE(IsClosedTour(
+      graph,
+      GraphAlgorithms::SolveTravelingSalesmanProblem(graph, options).path));
+  EXPECT_TRUE(AntColony(graph).LoadCheckpoint(filename));
+  std::remove(filename.c_str());
+}
+
+TEST(AntColony, SeedIsReproducible) {
+  graph.loadGraphFromFile("test/graphs/euclidean_40.txt");
+  TsmOptions options;
+  options.max_iterations = 3;
+  options.initial_tour = InitialTour::kNone;
+  options.local_search = LocalSearchMode::kNone;
+  AntColonyParams params;
+  params.seed = 2024;
+  TsmResult first = AntColony(graph, params).SolveSalesmansProblem(options);
+  TsmResult second = AntColony(graph, params).SolveSalesmansProblem(options);
+  EXPECT_EQ(first.path, second.path);
+  EXPECT_EQ(first.distance, second.distance);
+}
+
+TEST(AntColony, CheckpointResume) {
+  graph.loadGraphFromFile("test/graphs/euclidean_40.txt");
+  std::string filename = "test/colony.ckpt";
+  TsmOptions options;
+  options.max_iterations = 2;
+  options.checkpoint_path = filename;
+  AntColonyParams params;
+  params.seed = 11;
+  AntColony colony(graph, params);
+  TsmResult saved = colony.SolveSalesmansProblem(options);
+
+  AntColony resumed(graph, params);
+  EXPECT_TRUE(resumed.LoadCheckpoint(filename));
+  EXPECT_EQ(resumed.Iteration(), 2);
+  EXPECT_EQ(resumed.Best().path, saved.path);
+  EXPECT_EQ(resumed.Best().distance, saved.distance);
+  EXPECT_EQ(resumed.Pheromone(), colony.Pheromone());
+
+  // Продолжение с контрольной точки повторяет непрерывный запуск.
+  TsmOptions more;
+  more.max_iterations = 4;
+  more.resume_from = filename;
+  TsmResult continued = resumed.SolveSalesmansProblem(more);
+  EXPECT_EQ(resumed.Iteration(), 4);
+  AntColony continuous(graph, params);
+  TsmOptions whole;
+  whole.max_iterations = 4;
+  TsmResult expected = continuous.SolveSalesmansProblem(whole);
+  EXPECT_EQ(continued.path, expected.path);
+  EXPECT_EQ(continued.distance, expected.distance);
+  EXPECT_EQ(resumed.Pheromone(), continuous.Pheromone());
+
+  AntColonyParams other = params;
+  other.alpha = 3;
+  AntColony reparametrized(graph, other);
+  EXPECT_TRUE(reparametrized.LoadCheckpoint(filename));
+  EXPECT_EQ(reparametrized.Params().alpha, params.alpha);
+
+  // Длина состояния генератора в конце файла заменяется огромной.
+  std::string bytes;
+  {
+    std::ifstream file(filename, std::ios::binary);
+    bytes.assign(std::istreambuf_iterator<char>(file), {});
+  }
+  std::size_t length_at = 0;
+  for (std::size_t at = 0; at + 4 <= bytes.size(); ++at) {
+    std::uint32_t length = 0;
+    std::memcpy(&length, bytes.data() + at, sizeof(length));
+    if (length == bytes.size() - at - 4) length_at = at;
+  }
+  ASSERT_NE(length_at, 0u);
+  const std::uint32_t kHuge = 1u << 31;
+  std::memcpy(&bytes[length_at], &kHuge, sizeof(kHuge));
+  {
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    file << bytes;
+  }
+  EXPECT_THROW(AntColony(graph, params).LoadCheckpoint(filename),
+               std::runtime_error);
+  std::remove(filename.c_str());
+}
+
+TEST(AntColony, CheckpointWarmStart) {
+  graph.loadGraphFromFile("test/graphs/valid_graph.txt");
+  std::string filename = "test/colony.ckpt";
+  TsmOptions options;
+  options.max_iterations = 3;
+  options.checkpoint_path = filename;
+  TsmResult saved = AntColony(graph).SolveSalesmansProblem(options);
+
+  std::string changed_graph = "test/graphs/changed_graph.txt";
+  {
+    std::ofstream file(changed_graph);
+    file << graph.size() << "\n";
+    for (int i = 0; i < graph.size(); ++i) {
+      for (int j = 0; j < graph.size(); ++j) {
+        file << (i + j == 1 ? graph[i][j] + 5 : graph[i][j]) << " ";
+      }
+      file << "\n";
+    }
+  }
+  Graph changed;
+  changed.loadGraphFromFile(changed_graph);
+  AntColony colony(changed);
+  EXPECT_FALSE(colony.LoadCheckpoint(filename));
+  EXPECT_EQ(colony.Iteration(), 0);
+  EXPECT_TRUE(IsClosedTour(changed, colony.Best().path));
+  EXPECT_DOUBLE_EQ(colony.Best().distance,
+                   TourCost(changed, colony.Best().path));
+
+  graph.loadGraphFromFile("test/graphs/wug2.txt");
+  ASSERT_THROW(AntColony(graph).LoadCheckpoint(filename), std::out_of_range);
+  ASSERT_THROW(AntColony(graph).LoadCheckpoint(changed_graph),
+               std::runtime_error);
+  std::remove(filename.c_str());
+  std::remove(changed_graph.c_str());
+}
+
+TEST(GraphGenerator, Deterministic) {
+  GeneratorOptions options;
+  options.vertices = 60;
+  options.density = 0.2;
+  options.seed = 7;
+  std::ostringstream first;
+  std::ostringstream second;
+  GraphGenerator(options).WriteAdjacencyMatrix(first);
+  options.threads = 3;
+  GraphGenerator(options).WriteAdjacencyMatrix(second);
+  EXPECT_EQ(first.str(), second.str());
+
+  options.seed = 8;
+  std::ostringstream other;
+  GraphGenerator(options).WriteAdjacencyMatrix(other);
+  EXPECT_NE(first.str(), other.str());
+}
+
+TEST(GraphGenerator, LoadsAsGraph) {
+  const std::string filename = "test/graphs/generated_graph.txt";
+  GeneratorOptions options;
+  options.model = GeneratorModel::kPowerLaw;
+  options.vertices = 100;
+  options.average_degree = 6;
+  GraphGenerator generator(options);
+  generator.WriteAdjacencyMatrix(filename);
+  graph.loadGraphFromFile(filename);
+  std::remove(filename.c_str());
+
+  ASSERT_EQ(graph.size(), 100);
+  EXPECT_FALSE(graph.IsDirected());
+  int degrees = 0;
+  for (int i = 0; i < graph.size(); ++i) {
+    EXPECT_EQ(graph[i][i], 0);
+    for (int j = 0; j < graph.size(); ++j) {
+      EXPECT_EQ(graph[i][j], generator.Weight(i, j));
+      if (graph[i][j] > 0) ++degrees;
+    }
+  }
+  EXPECT_GT(degrees, 100 * 3);
+  EXPECT_LT(degrees, 100 * 12);
+}
+
+TEST(GraphGenerator, Models) {
+  GeneratorOptions options;
+  options.vertices = 49;
+  options.model = GeneratorModel::kGrid;
+  options.density = 0;
+  GraphGenerator grid(options);
+  for (int i = 0; i < options.vertices; ++i) {
+    int degree = 0;
+    for (int j = 0; j < options.vertices; ++j) degree += grid.Weight(i, j) > 0;
+    EXPECT_GE(degree, 2);
+    EXPECT_LE(degree, 4);
+  }
+
+  options.model = GeneratorModel::kEuclidean;
+  options.directed = true;
+  GraphGenerator euclidean(options);
+  for (int i = 0; i < options.vertices; ++i) {
+    for (int j = 0; j < options.vertices; ++j) {
+      if (i == j) continue;
+      EXPECT_GE(euclidean.Weight(i, j), options.min_weight);
+      EXPECT_LE(euclidean.Weight(i, j), options.max_weight);
+      EXPECT_EQ(euclidean.Weight(i, j), euclidean.Weight(j, i));
+    }
+  }
+
+  options.model = GeneratorModel::kErdosRenyi;
+  options.density = 0.3;
+  GraphGenerator directed(options);
+  bool asymmetric = false;
+  for (int i = 0; i < options.vertices; ++i)
+    for (int j = 0; j < options.vertices; ++j)
+      asymmetric = asymmetric || directed.Weight(i, j) != directed.Weight(j, i);
+  EXPECT_TRUE(asymmetric);
+
+  options.vertices = 0;
+  EXPECT_THROW(GraphGenerator{options}, std::invalid_argument);
+  options.vertices = 10;
+  options.min_weight = 5;
+  options.max_weight = 4;
+  EXPECT_THROW(GraphGenerator{options}, std::invalid_argument);
+}
+
+TEST(Statistics, TraversalAndPaths) {
+  ASSERT_TRUE(Statistics::kEnabled);
+  graph.loadGraphFromFile("test/graphs/valid_graph.txt");
+  vector<AlgorithmStats> received;
+  Statistics::SetSink([&received](const AlgorithmStats &stats) {
+    received.push_back(stats);
+  });
+
+  GraphAlgorithms::BreadthFirstSearch(graph, 0);
+  AlgorithmStats stats = Statistics::Last();
+  EXPECT_EQ(stats.algorithm, "BreadthFirstSearch");
+  EXPECT_EQ(stats.vertices_popped, static_cast<std::uint64_t>(graph.size()));
+  EXPECT_GT(stats.edges_scanned, 0);
+  EXPECT_GE(stats.heap_operations, 2 * stats.vertices_popped);
+
+  GraphAlgorithms::GetShortestPathBetweenVertices(graph, 1, 5);
+  stats = Statistics::Last();
+  EXPECT_EQ(stats.algorithm, "GetShortestPathBetweenVertices");
+  EXPECT_GT(stats.edges_relaxed, 0);
+  EXPECT_LE(stats.edges_relaxed, stats.edges_scanned);
+  EXPECT_GT(stats.peak_scratch_bytes, 0);
+
+  GraphAlgorithms::GetShortestPathsBetweenAllVertices(graph);
+  stats = Statistics::Last();
+  EXPECT_GT(stats.cells_updated, 0);
+  ASSERT_EQ(stats.phases.size(), 2);
+  EXPECT_EQ(stats.phases[0].first, "initialization");
+  EXPECT_EQ(stats.phases[1].first, "relaxation");
+
+  Statistics::SetSink(nullptr);
+  ASSERT_EQ(received.size(), 3);
+  EXPECT_EQ(received[2].algorithm, "GetShortestPathsBetweenAllVertices");
+  std::ostringstream printed;
+  printed << stats;
+  EXPECT_NE(printed.str().find("cells updated"), std::string::npos);
+}
+
+TEST(Statistics, SalesmanSolvers) {
+  graph.loadGraphFromFile("test/graphs/valid_graph.txt");
+  TsmOptions options;
+  GraphAlgorithms::SolveTravelingSalesmanProblem(graph, options);
+  AlgorithmStats stats = Statistics::Last();
+  // Вложенный вызов решателя учитывается во внешнем.
+  EXPECT_EQ(stats.algorithm, "SolveTravelingSalesmanProblem");
+  EXPECT_EQ(stats.iterations, static_cast<std::uint64_t>(graph.size() - 2));
+  EXPECT_GT(stats.cells_updated, 0);
+
+  options.solver = TsmSolver::kAntColony;
+  options.max_iterations = 5;
+  options.colony.seed = 1;
+  GraphAlgorithms::SolveTravelingSalesmanProblem(graph, options);
+  stats = Statistics::Last();
+  EXPECT_EQ(stats.iterations, 5);
+  EXPECT_LE(stats.convergence_iteration, 5);
+  EXPECT_GT(stats.ant_steps, 0);
+  EXPECT_GT(stats.pheromone_updates, 0);
+  EXPECT_FALSE(stats.phases.empty());
+}
+
+TEST(Trace, RecordsAlgorithmScopes) {
+  graph.loadGraphFromFile("test/graphs/valid_graph.txt");
+  std::ostringstream empty;
+  Trace::Start();
+  Trace::Stop();
+  GraphAlgorithms::BreadthFirstSearch(graph, 0);
+  Trace::WriteChromeTrace(empty);
+  EXPECT_EQ(empty.str().find("\"ph\""), std::string::npos);
+
+  Trace::Start();
+  EXPECT_TRUE(Trace::IsEnabled());
+  graph.loadGraphFromFile("test/graphs/valid_graph.txt");
+  GraphAlgorithms::GetShortestPathsBetweenAllVertices(graph);
+  TsmOptions options;
+  options.solver = TsmSolver::kAntColony;
+  options.max_iterations = 3;
+  std::thread worker([&options] {
+    GraphAlgorithms::SolveTravelingSalesmanProblem(graph, options);
+  });
+  worker.join();
+  Trace::Stop();
+
+  std::ostringstream stream;
+  Trace::WriteChromeTrace(stream);
+  const std::string kTrace = stream.str();
+  EXPECT_EQ(kTrace.rfind("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", 0),
+            0);
+  EXPECT_NE(kTrace.find("\"name\":\"Graph::loadGraphFromFile\""),
+            std::string::npos);
+  EXPECT_NE(kTrace.find("\"V\":11,\"E\":"), std::string::npos);
+  EXPECT_NE(kTrace.find("GraphAlgorithms::GetShortestPathsBetweenAllVertices"),
+            std::string::npos);
+  EXPECT_NE(kTrace.find("\"iteration\":2"), std::string::npos);
+  // Итерации колонии записаны в буфер другого потока.
+  const auto kLoad = kTrace.find("Graph::loadGraphFromFile");
+  const auto kIteration = kTrace.find("AntColony::RunIteration");
+  ASSERT_NE(kIteration, std::string::npos);
+  const auto kTid = [&kTrace](std::size_t position) {
+    const auto kStart = kTrace.find("\"tid\":", position) + 6;
+    return kTrace.substr(kStart, kTrace.find(',', kStart) - kStart);
+  };
+  EXPECT_NE(kTid(kLoad), kTid(kIteration));
+
+  // Потоки, запущенные один за другим, пишут в один освобождённый буфер.
+  Trace::Start();
+  for (int i = 0; i < 20; ++i) {
+    std::thread([] { Trace::Scope scope("Test::Worker"); }).join();
+  }
+  Trace::Stop();
+  std::ostringstream workers;
+  Trace::WriteChromeTrace(workers);
+  const std::string kWorkers = workers.str();
+  std::set<std::string> tids;
+  for (auto at = kWorkers.find("Test::Worker"); at != std::string::npos;
+       at = kWorkers.find("Test::Worker", at + 1)) {
+    const auto kStart = kWorkers.find("\"tid\":", at) + 6;
+    tids.insert(kWorkers.substr(kStart, kWorkers.find(',', kStart) - kStart));
+  }
+  EXPECT_EQ(tids.size(), 1u);
+}
+
+TEST(LoadGraph, Properties) {
+  graph.loadGraphFromFile("test/graphs/valid_graph.txt");
+  GraphProperties properties = graph.Properties();
+  EXPECT_FALSE(properties.directed);
+  EXPECT_EQ(properties.edge_count, 55);
+  EXPECT_EQ(properties.total_weight, 1849);
+  EXPECT_EQ(graph.getGraphWeight(), 1849);
+  EXPECT_EQ(properties.min_weight, 3);
+  EXPECT_EQ(properties.max_weight, 101);
+  EXPECT_EQ(properties.min_degree, 10);
+  EXPECT_EQ(properties.max_degree, 10);
+  EXPECT_DOUBLE_EQ(properties.average_degree, 10);
+  EXPECT_FALSE(properties.uniform_weights);
+
+  graph.loadGraphFromFile("test/graphs/dwg.txt");
+  EXPECT_TRUE(graph.IsDirected());
+  EXPECT_EQ(graph.Properties().edge_count, 12);
+
+  graph.loadGraphFromFile("test/graphs/unweighted_undirected_graph.txt");
+  properties = graph.Properties();
+  EXPECT_FALSE(properties.directed);
+  EXPECT_EQ(properties.edge_count, 6);
+  EXPECT_EQ(properties.min_degree, 1);
+  EXPECT_EQ(properties.max_degree, 4);
+  EXPECT_TRUE(properties.uniform_weights);
+
+  // Неудачная загрузка не оставляет свойства прежнего графа.
+  EXPECT_ANY_THROW(
+      graph.loadGraphFromFile("test/graphs/invalid_matrix_size.txt"));
+  EXPECT_EQ(graph.Properties().edge_count, 0);
+}
+
+TEST(Graph, SetEdgeKeepsPropertiesInSync) {
+  graph.loadGraphFromFile("test/graphs/unweighted_undirected_graph.txt");
+  const auto kVersion = graph.Version();
+  graph.SetEdge(0, 5, 7);
+  EXPECT_NE(graph.Version(), kVersion);
+  EXPECT_EQ(graph[0][5], 7);
+  EXPECT_TRUE(graph.IsDirected());
+  EXPECT_FALSE(graph.Properties().uniform_weights);
+  EXPECT_EQ(graph.Properties().max_weight, 7);
+
+  graph.SetEdge(5, 0, 7);
+  Graph reloaded;
+  {
+    const std::string kFilename = "test/graphs/changed_graph.txt";
+    std::ofstream file(kFilename);
+    file << graph.size() << "\n";
+    for (int i = 0; i < graph.size(); ++i) {
+      for (int j = 0; j < graph.size(); ++j) file << graph[i][j] << " ";
+      file << "\n";
+    }
+    file.close();
+    reloaded.loadGraphFromFile(kFilename);
+    std::remove(kFilename.c_str());
+  }
+  const GraphProperties &kChanged = graph.Properties();
+  const GraphProperties &kExpected = reloaded.Properties();
+  EXPECT_EQ(kChanged.directed, kExpected.directed);
+  EXPECT_EQ(kChanged.edge_count, kExpected.edge_count);
+  EXPECT_EQ(kChanged.total_weight, kExpected.total_weight);
+  EXPECT_EQ(kChanged.min_weight, kExpected.min_weight);
+  EXPECT_EQ(kChanged.max_weight, kExpected.max_weight);
+  EXPECT_EQ(kChanged.min_degree, kExpected.min_degree);
+  EXPECT_EQ(kChanged.max_degree, kExpected.max_degree);
+  EXPECT_DOUBLE_EQ(kChanged.average_degree, kExpected.average_degree);
+
+  graph.RemoveEdge(0, 5);
+  graph.RemoveEdge(5, 0);
+  EXPECT_FALSE(graph.IsDirected());
+  EXPECT_TRUE(graph.Properties().uniform_weights);
+  EXPECT_EQ(graph.Properties().edge_count, 6);
+
+  EXPECT_THROW(graph.SetEdge(0, 6, 1), std::out_of_range);
+  EXPECT_THROW(graph.SetEdge(1, 1, 1), std::invalid_argument);
+  EXPECT_THROW(graph.SetEdge(0, 1, -1), std::invalid_argument);
+  EXPECT_NO_THROW(graph.RemoveEdge(2, 2));
+  EXPECT_THROW(graph.RemoveEdge(6, 6), std::out_of_range);
+  EXPECT_THROW(graph.RemoveEdge(-1, -1), std::out_of_range);
+  DynamicShortestPaths paths(graph);
+  EXPECT_THROW(paths.RemoveEdge(6, 6), std::out_of_range);
+  DynamicSpanningTree tree(graph);
+  EXPECT_THROW(tree.RemoveEdge(6, 6), std::out_of_range);
+}
+
+TEST(DynamicShortestPaths, MatchesFullRecompute) {
+  const std::string kFilename = "test/graphs/dynamic_graph.txt";
+  GeneratorOptions generator_options;
+  generator_options.vertices = 40;
+  generator_options.density = 0.1;
+  generator_options.max_weight = 20;
+  GraphGenerator(generator_options).WriteAdjacencyMatrix(kFilename);
+  graph.loadGraphFromFile(kFilename);
+  std::remove(kFilename.c_str());
+
+  DynamicShortestPaths paths(graph);
+  std::mt19937 generator(3);
+  std::uniform_int_distribution<int> vertex(0, graph.size() - 1);
+  std::uniform_int_distribution<int> weight(0, 25);
+  for (int update = 0; update < 300; ++update) {
+    const int kFrom = vertex(generator);
+    const int kTo = vertex(generator);
+    if (kFrom == kTo) continue;
+    const int kWeight = update % 3 == 0 ? 0 : weight(generator);
+    paths.SetEdge(kFrom, kTo, kWeight);
+    if (update % 2 == 0) paths.SetEdge(kTo, kFrom, kWeight);
+    if (update % 25 == 0) {
+      ASSERT_EQ(paths.Distances(),
+                GraphAlgorithms::GetShortestPathsBetweenAllVertices(graph));
+    }
+  }
+  ASSERT_EQ(paths.Distances(),
+            GraphAlgorithms::GetShortestPathsBetweenAllVertices(graph));
+
+  // Изменение в обход объекта приводит к полному пересчёту.
+  graph.SetEdge(0, 1, 1);
+  EXPECT_EQ(paths.Distances()[0][1], 1);
+}
+
+TEST(DynamicSpanningTree, MatchesPrim) {
+  graph.loadGraphFromFile("test/graphs/valid_graph.txt");
+  DynamicSpanningTree tree(graph);
+  EXPECT_EQ(tree.Weight(), 150);
+  EXPECT_EQ(tree.Tree(), GraphAlgorithms::GetLeastSpanningTree(graph));
+
+  const std::string kFilename = "test/graphs/dynamic_tree.txt";
+  GeneratorOptions generator_options;
+  generator_options.model = GeneratorModel::kGrid;
+  generator_options.vertices = 49;
+  generator_options.density = 0.5;
+  generator_options.max_weight = 30;
+  GraphGenerator(generator_options).WriteAdjacencyMatrix(kFilename);
+  graph.loadGraphFromFile(kFilename);
+  std::remove(kFilename.c_str());
+
+  DynamicSpanningTree dynamic(graph);
+  std::mt19937 generator(5);
+  std::uniform_int_distribution<int> vertex(0, graph.size() - 1);
+  std::uniform_int_distribution<int> weight(1, 40);
+  for (int update = 0; update < 400; ++update) {
+    const int kFirst = vertex(generator);
+    const int kSecond = vertex(generator);
+    if (kFirst == kSecond) continue;
+    dynamic.SetEdge(kFirst, kSecond, update % 4 == 0 ? 0 : weight(generator));
+
+    const matrix &kTree = dynamic.Tree();
+    long long tree_weight = 0;
+    int tree_edges = 0;
+    for (int i = 0; i < graph.size(); ++i) {
+      for (int j = i + 1; j < graph.size(); ++j) {
+        if (kTree[i][j] == 0) continue;
+        ASSERT_EQ(kTree[i][j], graph[i][j]);
+        tree_weight += kTree[i][j];
+        ++tree_edges;
+      }
+    }
+    ASSERT_EQ(tree_weight, dynamic.Weight());
+    // Новый объект строит лес с нуля алгоритмом Прима.
+    ASSERT_EQ(dynamic.Weight(), DynamicSpanningTree(graph).Weight());
+    if (tree_edges == graph.size() - 1) {
+      ASSERT_EQ(dynamic.Weight(), GraphAlgorithms::CalculateGraphWeight(
+                                      GraphAlgorithms::GetLeastSpanningTree(
+                                          graph)));
+    }
+  }
+
+  graph.loadGraphFromFile("test/graphs/dwg.txt");
+  EXPECT_THROW(DynamicSpanningTree{graph}, std::invalid_argument);
+}
+
+TEST(GetShortestPathBetweenVertices, MatchesFloydWarshall) {
+  GeneratorOptions options;
+  options.vertices = 30;
+  options.density = 0.2;
+  options.max_weight = 50;
+  for (int directed = 0; directed < 2; ++directed) {
+    const std::string kFilename = "test/graphs/sp_graph.txt";
+    options.directed = directed;
+    GraphGenerator(options).WriteAdjacencyMatrix(kFilename);
+    graph.loadGraphFromFile(kFilename);
+    std::remove(kFilename.c_str());
+    matrix distances = GraphAlgorithms::GetShortestPathsBetweenAllVertices(graph);
+    for (int from = 1; from <= graph.size(); ++from)
+      for (int to = 1; to <= graph.size(); ++to)
+        ASSERT_EQ(GraphAlgorithms::GetShortestPathBetweenVertices(graph, from, to),
+                  distances[from - 1][to - 1]);
+  }
+}
+
+TEST(ResultCache, EvictsLeastRecentlyUsed) {
+  ResultCache cache(1200);
+  cache.Insert(1, "bfs", {1}, vector<int>(100, 1));
+  cache.Insert(1, "bfs", {2}, vector<int>(100, 2));
+  ASSERT_TRUE(cache.Find(1, "bfs", {1}));
+  cache.Insert(1, "bfs", {3}, vector<int>(100, 3));
+  EXPECT_LE(cache.Size(), 1200);
+  EXPECT_TRUE(cache.Find(1, "bfs", {1}));
+  EXPECT_FALSE(cache.Find(1, "bfs", {2}));
+  EXPECT_EQ(std::get<vector<int>>(*cache.Find(1, "bfs", {3}))[0], 3);
+  EXPECT_FALSE(cache.Find(2, "bfs", {3}));
+  EXPECT_FALSE(cache.Find(1, "dfs", {3}));
+
+  cache.Insert(1, "apsp", {}, matrix(100, vector<int>(100)));
+  EXPECT_FALSE(cache.Find(1, "apsp", {}));
+  // Результат не копируется и переживает вытеснение из кэша.
+  const auto kShared = cache.Find(1, "bfs", {3});
+  EXPECT_EQ(cache.Find(1, "bfs", {3}), kShared);
+  cache.Clear();
+  EXPECT_EQ(cache.Size(), 0);
+  EXPECT_FALSE(cache.Find(1, "bfs", {1}));
+  EXPECT_EQ(std::get<vector<int>>(*kShared)[0], 3);
+}
+
+TEST(Controller, CachesResultsPerGraphVersion) {
+  Graph controlled;
+  Controller controller(&controlled);
+  controller.LoadGraphFromFile("test/graphs/valid_graph.txt");
+
+  matrix all = controller.GetShortestPathsBetweenAllVertices();
+  EXPECT_EQ(controller.GetShortestPathsBetweenAllVertices(), all);
+  const std::size_t kHits = controller.Cache().Hits();
+  EXPECT_EQ(controller.GetShortestPathBetweenVertices(1, 5), all[0][4]);
+  EXPECT_EQ(controller.Cache().Hits(), kHits + 1);
+  EXPECT_THROW(controller.GetShortestPathBetweenVertices(0, 5),
+               std::runtime_error);
+
+  vector<int> traversal = controller.BreadthFirstSearch(0);
+  EXPECT_EQ(controller.BreadthFirstSearch(0), traversal);
+  EXPECT_EQ(controller.GetLeastSpanningTree(),
+            GraphAlgorithms::GetLeastSpanningTree(controlled));
+
+  controller.SetEdge(1, 5, 1);
+  controller.SetEdge(5, 1, 1);
+  EXPECT_EQ(controlled[0][4], 1);
+  EXPECT_EQ(controller.GetShortestPathBetweenVertices(1, 5), 1);
+  // Каждый алгоритм поиска пути кэшируется отдельно.
+  const std::size_t kSearchHits = controller.Cache().Hits();
+  EXPECT_EQ(controller.GetShortestPathBetweenVertices(1, 5), 1);
+  EXPECT_EQ(controller.Cache().Hits(), kSearchHits + 1);
+  EXPECT_EQ(controller.GetShortestPathBetweenVertices(1, 5, PathSearch::kAlt),
+            1);
+  EXPECT_EQ(controller.Cache().Hits(), kSearchHits + 1);
+
+  controller.LoadGraphFromFile("test/graphs/wug2.txt");
+  EXPECT_EQ(controller.Cache().Size(), 0);
+  EXPECT_EQ(controller.GetShortestPathsBetweenAllVertices(),
+            GraphAlgorithms::GetShortestPathsBetweenAllVertices(controlled));
+}
+
+TEST(ThreadPool, RunsNestedTasks) {
+  ThreadPool pool(3);
+  std::atomic<int> done{0};
+  vector<std::future<int>> results;
+  for (int i = 0; i < 100; ++i) {
+    results.push_back(pool.Submit([&pool, &done, i] {
+      // Вложенная задача попадает в очередь этого же потока, а Wait выполняет
+      // её сам, если её не забрал другой поток.
+      auto square = pool.Submit([i] { return i * i; });
+      int nested = pool.Wait(square);
+      ++done;
+      return nested + i;
+    }));
+  }
+  for (int i = 0; i < 100; ++i) EXPECT_EQ(results[i].get(), i * i + i);
+  EXPECT_EQ(done, 100);
+  auto failing = pool.Submit([]() -> int { throw std::logic_error("task"); });
+  EXPECT_THROW(failing.get(), std::logic_error);
+}
+
+TEST(Controller, AsyncQueriesUseSnapshot) {
+  Graph controlled;
+  Controller controller(&controlled, ResultCache::kDefaultBudget, 2);
+  controller.LoadGraphFromFile("test/graphs/valid_graph.txt");
+  Controller::Snapshot before = controller.GetSnapshot();
+
+  vector<std::future<matrix>> all;
+  for (int i = 0; i < 8; ++i)
+    all.push_back(controller.GetShortestPathsBetweenAllVerticesAsync());
+  auto path = controller.GetShortestPathBetweenVerticesAsync(1, 5);
+  auto traversal = controller.DepthFirstSearchAsync(0);
+  auto tree = controller.GetLeastSpanningTreeAsync();
+  auto tour = controller.SolveTravelingSalesmanProblemAsync();
+  auto invalid = controller.BreadthFirstSearchAsync(100);
+
+  // Запросы, отправленные до загрузки, считаются на прежнем графе.
+  controller.LoadGraphFromFile("test/graphs/wug2.txt");
+  EXPECT_NE(controller.GetSnapshot(), before);
+  EXPECT_EQ(controller.GetSnapshot()->size(), controlled.size());
+
+  const matrix kExpected =
+      GraphAlgorithms::GetShortestPathsBetweenAllVertices(*before);
+  for (auto &result : all) EXPECT_EQ(result.get(), kExpected);
+  EXPECT_EQ(path.get(), kExpected[0][4]);
+  EXPECT_EQ(traversal.get(), GraphAlgorithms::DepthFirstSearch(*before, 0));
+  EXPECT_EQ(tree.get(), GraphAlgorithms::GetLeastSpanningTree(*before));
+  EXPECT_EQ(tour.get().path.size(), static_cast<std::size_t>(before->size()) + 1);
+  EXPECT_THROW(invalid.get(), std::runtime_error);
+
+  EXPECT_EQ(controller.GetShortestPathsBetweenAllVerticesAsync().get(),
+            GraphAlgorithms::GetShortestPathsBetweenAllVertices(controlled));
+}
+
+TEST(BatchView, RunsQueriesInFileOrder) {
+  Graph controlled;
+  Controller controller(&controlled, ResultCache::kDefaultBudget, 3);
+  std::istringstream queries(
+      "# запросы\n"
+      "load test/graphs/valid_graph.txt\n"
+      "sp 1 5\n"
+      "bfs 1\n"
+      "\n"
+      "mst\n"
+      "load test/graphs/wug2.txt\n"
+      "apsp\n"
+      "sp 0 1\n"
+      "unknown\n"
+      "tsp exact\n");
+  std::ostringstream csv;
+  BatchView batch(&controller);
+  EXPECT_EQ(batch.Run(queries, csv), 2);
+
+  Graph first;
+  first.loadGraphFromFile("test/graphs/valid_graph.txt");
+  std::istringstream lines(csv.str());
+  vector<string> rows;
+  for (string row; std::getline(lines, row);) rows.push_back(row);
+  ASSERT_EQ(rows.size(), 10);
+  EXPECT_EQ(rows[0], "line,command,arguments,status,time_ms,result");
+  EXPECT_EQ(rows[2].rfind("3,sp,\"1 5\",ok,", 0), 0);
+  EXPECT_NE(rows[2].find(",\"" +
+                std::to_string(GraphAlgorithms::GetShortestPathBetweenVertices(
+                    first, 1, 5)) + "\""),
+            string::npos);
+  EXPECT_EQ(rows[7].rfind("9,sp,\"0 1\",error,", 0), 0);
+  EXPECT_EQ(rows[8].rfind("10,unknown,\"\",error,", 0), 0);
+
+  std::istringstream again("load test/graphs/wug2.txt\napsp\n");
+  std::ostringstream json;
+  EXPECT_EQ(batch.Run(again, json, BatchFormat::kJson), 0);
+  EXPECT_EQ(json.str().front(), '[');
+  EXPECT_NE(json.str().find("\"command\":\"apsp\""), string::npos);
+  EXPECT_NE(json.str().find("\"status\":\"ok\""), string::npos);
+
+  // После неудачной загрузки запросы не отвечают по прежнему графу.
+  std::istringstream missing(
+      "load test/graphs/missing.txt\n"
+      "sp 1 2\n"
+      "load test/graphs/valid_graph.txt\n"
+      "sp 1 5\n"
+      "unknown a\tb\x01\r\n");
+  std::ostringstream escaped;
+  EXPECT_EQ(batch.Run(missing, escaped, BatchFormat::kJson), 3);
+  const string kOutput = escaped.str();
+  EXPECT_NE(kOutput.find("{\"line\":2,\"command\":\"sp\",\"arguments\":"
+                         "\"1 2\",\"status\":\"error\""),
+            string::npos);
+  EXPECT_NE(kOutput.find("Graph of line 1 was not loaded"), string::npos);
+  EXPECT_NE(kOutput.find("{\"line\":4,\"command\":\"sp\",\"arguments\":"
+                         "\"1 5\",\"status\":\"ok\""),
+            string::npos);
+  EXPECT_NE(kOutput.find("\"arguments\":\"a\\tb\\u0001\\r\""),
+            string::npos);
+  for (char symbol : kOutput) {
+    if (symbol != '\n') EXPECT_GE(static_cast<unsigned char>(symbol), 0x20);
+  }
+}
+
+TEST(QueryRunner, WritesLongToursExactly) {
+  const int kWeight = 411523;
+  Graph triangle(matrix{{0, kWeight, kWeight},
+                        {kWeight, 0, kWeight},
+                        {kWeight, kWeight, 0}});
+  Controller controller(&triangle);
+  QueryRunner runner(&controller);
+  EXPECT_EQ(runner.Run(triangle, "tsp", "exact").rfind(
+                "{\"distance\":" + std::to_string(3 * kWeight) + ",", 0),
+            0);
+}
+
+// Отправляет запросы серверу, закрывает передачу и читает все ответы.
+string AskServer(const string &socket_path, const string &requests) {
+  sockaddr_un address{};
+  address.sun_family = AF_UNIX;
+  std::strcpy(address.sun_path, socket_path.c_str());
+  int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  for (int attempt = 0;
+       connect(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0;
+       ++attempt) {
+    if (attempt == 500) {
+      close(fd);
+      return "";
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  EXPECT_EQ(write(fd, requests.data(), requests.size()),
+            static_cast<ssize_t>(requests.size()));
+  shutdown(fd, SHUT_WR);
+  string replies;
+  char buffer[4096];
+  for (ssize_t size; (size = read(fd, buffer, sizeof(buffer))) > 0;)
+    replies.append(buffer, size);
+  close(fd);
+  return replies;
+}
+
+TEST(ServerView, AnswersOverUnixSocket) {
+  const string kSocket = "/tmp/s21_navigator_test_" + std::to_string(getpid());
+  ServerView server(2);
+  std::thread serving([&] { server.Run(kSocket); });
+
+  Graph expected;
+  expected.loadGraphFromFile("test/graphs/valid_graph.txt");
+  const int kPath = GraphAlgorithms::GetShortestPathBetweenVertices(expected, 1, 5);
+  EXPECT_EQ(AskServer(kSocket,
+                      "sp 1 5\n"
+                      "load test/graphs/valid_graph.txt\n"
+                      "sp 1 5\n"
+                      "use small\n"
+                      "load test/graphs/wug2.txt\n"
+                      "bfs 0\n"
+                      "graphs"),
+            "error Graph default is not loaded\n"
+            "ok {\"vertices\":11}\n"
+            "ok " + std::to_string(kPath) + "\n"
+            "ok\n"
+            "ok {\"vertices\":4}\n"
+            "error Vertex is missing or invalid\n"
+            "ok {\"default\":11,\"small\":4}\n");
+
+  // Загруженные графы остаются в памяти для следующих соединений.
+  vector<std::future<string>> clients;
+  for (int i = 0; i < 4; ++i)
+    clients.push_back(std::async(std::launch::async, AskServer, kSocket,
+                                 "sp 1 5\nquit\nsp 1 5\n"));
+  for (auto &client : clients)
+    EXPECT_EQ(client.get(), "ok " + std::to_string(kPath) + "\n");
+
+  server.Stop();
+  serving.join();
+  EXPECT_NE(access(kSocket.c_str(), F_OK), 0);
+}
+
+// Записывает случайный граф во временный файл и загружает его.
+Graph GeneratedGraph(const GeneratorOptions &options) {
+  const std::string filename = "test/graphs/generated_path_graph.txt";
+  GraphGenerator(options).WriteAdjacencyMatrix(filename);
+  Graph generated;
+  generated.loadGraphFromFile(filename);
+  std::remove(filename.c_str());
+  return generated;
+}
+
+// Случайный граф для сравнения с алгоритмом Флойда-Уоршелла.
+struct SeededGraph {
+  std::uint64_t seed = 0;
+  bool directed = false;
+  bool sparse = false;
+  Graph graph;
+  matrix distances;
+};
+
+// Четыре графа с зёрнами 1-4 и их матрицы расстояний: первые два редкие и
+// распадаются на компоненты, последние два плотные; графы с чётным зерном
+// ориентированы, если directed.
+vector<SeededGraph> SeededGraphs(int vertices, double sparse_density,
+                                 double dense_density, bool directed = true) {
+  GeneratorOptions options;
+  options.vertices = vertices;
+  vector<SeededGraph> graphs(4);
+  for (std::uint64_t seed = 1; seed <= graphs.size(); ++seed) {
+    SeededGraph &sample = graphs[seed - 1];
+    sample.seed = seed;
+    sample.directed = directed && seed % 2 == 0;
+    sample.sparse = seed <= 2;
+    options.seed = seed;
+    options.directed = sample.directed;
+    options.density = sample.sparse ? sparse_density : dense_density;
+    sample.graph = GeneratedGraph(options);
+    sample.distances =
+        GraphAlgorithms::GetShortestPathsBetweenAllVertices(sample.graph);
+  }
+  return graphs;
+}
+
+TEST(PointToPoint, MatchesFloydWarshall) {
+  for (const SeededGraph &sample : SeededGraphs(60, 0.03, 0.2)) {
+    const Graph &generated = sample.graph;
+    const matrix &distances = sample.distances;
+    Landmarks landmarks(generated, 4);
+    for (int from = 1; from <= generated.size(); ++from) {
+      for (int to = 1; to <= generated.size(); ++to) {
+        const int kExpected = distances[from - 1][to - 1];
+        ASSERT_LE(landmarks.LowerBound(from - 1, to - 1), kExpected);
+        ASSERT_EQ(PointToPoint::Bidirectional(generated, from, to), kExpected);
+        ASSERT_EQ(PointToPoint::Alt(generated, landmarks, from, to), kExpected);
+      }
+    }
+  }
+  EXPECT_THROW(PointToPoint::Bidirectional(graph, 0, 1), std::invalid_argument);
+}
+
+TEST(PointToPoint, SettlesFewerVertices) {
+  GeneratorOptions options;
+  options.model = GeneratorModel::kGrid;
+  options.vertices = 900;
+  options.density = 0;
+  Graph grid = GeneratedGraph(options);
+  Landmarks landmarks(grid);
+
+  // Запрос между соседними районами сетки 30x30.
+  const int kFrom = 10 * 30 + 5;
+  const int kTo = 20 * 30 + 25;
+  const int kExpected =
+      GraphAlgorithms::GetShortestPathBetweenVertices(grid, kFrom, kTo);
+  const long long kDijkstra = Statistics::Last().vertices_popped;
+  EXPECT_EQ(PointToPoint::Bidirectional(grid, kFrom, kTo), kExpected);
+  const long long kBidirectional = Statistics::Last().vertices_popped;
+  EXPECT_EQ(PointToPoint::Alt(grid, landmarks, kFrom, kTo), kExpected);
+  const long long kAlt = Statistics::Last().vertices_popped;
+  EXPECT_LT(kBidirectional, kDijkstra);
+  EXPECT_LT(kAlt * 3, kDijkstra);
+
+  Graph controlled;
+  Controller controller(&controlled);
+  controller.LoadGraphFromFile("test/graphs/valid_graph.txt");
+  const int kPath = controller.GetShortestPathBetweenVertices(1, 5, PathSearch::kDijkstra);
+  Controller fresh(&controlled);
+  EXPECT_EQ(fresh.GetShortestPathBetweenVertices(1, 5, PathSearch::kAlt), kPath);
+  EXPECT_EQ(fresh.GetShortestPathBetweenVertices(5, 1, PathSearch::kAlt),
+            controller.GetShortestPathBetweenVertices(5, 1));
+}
+
+TEST(ContractionHierarchy, MatchesFloydWarshall) {
+  for (const SeededGraph &sample : SeededGraphs(80, 0.03, 0.15)) {
+    const Graph &generated = sample.graph;
+    const matrix &distances = sample.distances;
+    // Раунды сжатия идут в нескольких потоках и на одном ядре.
+    const unsigned kThreads = 3;
+    ContractionHierarchy hierarchy(generated, kThreads);
+    for (int from = 1; from <= generated.size(); ++from) {
+      for (int to = 1; to <= generated.size(); ++to) {
+        const int kExpected = distances[from - 1][to - 1];
+        ASSERT_EQ(hierarchy.Distance(from, to), kExpected);
+        vector<int> path = hierarchy.Path(from, to);
+        if (kExpected == std::numeric_limits<int>::max()) {
+          ASSERT_TRUE(path.empty());
+          continue;
+        }
+        ASSERT_EQ(path.front(), from);
+        ASSERT_EQ(path.back(), to);
+        long long length = 0;
+        for (std::size_t i = 0; i + 1 < path.size(); ++i) {
+          ASSERT_NE(generated[path[i] - 1][path[i + 1] - 1], 0);
+          length += generated[path[i] - 1][path[i + 1] - 1];
+        }
+        ASSERT_EQ(length, kExpected);
+      }
+    }
+  }
+}
+
+TEST(ContractionHierarchy, SavesIndex) {
+  GeneratorOptions options;
+  options.model = GeneratorModel::kGrid;
+  options.vertices = 400;
+  options.density = 0.2;
+  Graph grid = GeneratedGraph(options);
+  ContractionHierarchy hierarchy(grid);
+  EXPECT_GT(hierarchy.ShortcutCount(), 0);
+
+  const std::string filename = "test/graphs/grid.ch";
+  hierarchy.Save(filename);
+  ContractionHierarchy loaded = ContractionHierarchy::Load(filename, grid);
+  EXPECT_EQ(loaded.ShortcutCount(), hierarchy.ShortcutCount());
+  for (int from = 1; from <= grid.size(); from += 7) {
+    for (int to = 1; to <= grid.size(); to += 13) {
+      ASSERT_EQ(loaded.Distance(from, to),
+                GraphAlgorithms::GetShortestPathBetweenVertices(grid, from, to));
+      ASSERT_EQ(loaded.Path(from, to), hierarchy.Path(from, to));
+    }
+  }
+  EXPECT_THROW(ContractionHierarchy::Load(filename, graph), std::out_of_range);
+  EXPECT_THROW(ContractionHierarchy::Load("test/graphs/wug.txt", grid),
+               std::runtime_error);
+  std::remove(filename.c_str());
+  EXPECT_THROW(loaded.Distance(0, 1), std::invalid_argument);
+
+  Graph controlled;
+  Controller controller(&controlled);
+  controller.LoadGraphFromFile("test/graphs/valid_graph.txt");
+  EXPECT_EQ(controller.GetShortestPathBetweenVertices(
+                3, 7, PathSearch::kContractionHierarchy),
+            GraphAlgorithms::GetShortestPathBetweenVertices(
+                *controller.GetSnapshot(), 3, 7));
+}
+
+TEST(DistanceOracle, StaysWithinStretch) {
+  for (const SeededGraph &sample : SeededGraphs(120, 0.015, 0.1, false)) {
+    const Graph &generated = sample.graph;
+    const matrix &distances = sample.distances;
+    for (int levels = 1; levels <= 3; ++levels) {
+      DistanceOracle oracle(generated, levels,
+                            static_cast<unsigned>(sample.seed));
+      for (int from = 1; from <= generated.size(); ++from) {
+        for (int to = 1; to <= generated.size(); ++to) {
+          const int kExpected = distances[from - 1][to - 1];
+          if (kExpected == std::numeric_limits<int>::max()) {
+            ASSERT_EQ(oracle.Distance(from, to), kExpected);
+          } else {
+            ASSERT_GE(oracle.Distance(from, to), kExpected);
+          }
+        }
+      }
+      OracleAccuracy accuracy = oracle.Compare(distances);
+      EXPECT_GT(accuracy.pairs, 0);
+      EXPECT_LE(accuracy.max_stretch, oracle.Stretch());
+      EXPECT_LE(accuracy.mean_stretch, accuracy.max_stretch);
+      // Один уровень - это таблица всех расстояний.
+      if (levels == 1) {
+        EXPECT_EQ(accuracy.exact, 1);
+      }
+    }
+  }
+  Graph directed;
+  directed.loadGraphFromFile("test/graphs/asymmetric_30.txt");
+  EXPECT_THROW(DistanceOracle oracle(directed), std::invalid_argument);
+}
+
+TEST(DistanceOracle, IsSmallerThanMatrix) {
+  GeneratorOptions options;
+  options.model = GeneratorModel::kGrid;
+  options.vertices = 900;
+  options.density = 0.2;
+  Graph grid = GeneratedGraph(options);
+  DistanceOracle two_levels(grid, 2, 1);
+  DistanceOracle three_levels(grid, 3, 1);
+  const std::size_t kMatrix = 900 * 900;
+  EXPECT_LT(two_levels.BunchEntries(), kMatrix / 4);
+  EXPECT_LT(three_levels.BunchEntries(), two_levels.BunchEntries());
+  EXPECT_THROW(three_levels.Distance(0, 1), std::invalid_argument);
+
+  Graph controlled;
+  Controller controller(&controlled);
+  controller.LoadGraphFromFile("test/graphs/valid_graph.txt");
+  const int kExact = controller.GetShortestPathBetweenVertices(3, 7);
+  EXPECT_GE(controller.EstimateDistance(3, 7), kExact);
+  EXPECT_LE(controller.EstimateDistanceAsync(3, 7).get(),
+            (2 * DistanceOracle::kDefaultLevels - 1) * kExact);
+}
+
+TEST(ExternalShortestPaths, MatchesFloydWarshall) {
+  const std::string filename = "test/graphs/external.apsp";
+  for (const SeededGraph &sample : SeededGraphs(70, 0.03, 0.2)) {
+    const Graph &generated = sample.graph;
+    const matrix &kExpected = sample.distances;
+    // Размеры плиток, которые делят и не делят число вершин.
+    for (int tile : {3, 9, 35, 70}) {
+      ExternalPathsOptions paths;
+      paths.tile = tile;
+      ExternalShortestPaths::FromGraph(generated, filename, paths);
+      DistanceFile distances(filename);
+      EXPECT_EQ(distances.Tile(), tile);
+      ASSERT_EQ(distances.ToMatrix(), kExpected);
+    }
+  }
+  std::remove(filename.c_str());
+}
+
+TEST(ExternalShortestPaths, StreamsGraphFile) {
+  const std::string filename = "test/graphs/external.apsp";
+  Graph loaded;
+  loaded.loadGraphFromFile("test/graphs/valid_graph.txt");
+  const matrix kExpected =
+      GraphAlgorithms::GetShortestPathsBetweenAllVertices(loaded);
+  ExternalPathsOptions options;
+  // Бюджет на строку из трёх плиток и ещё две плитки.
+  options.memory_budget = 5 * 4 * 4 * sizeof(int);
+  ExternalShortestPaths::FromFile("test/graphs/valid_graph.txt", filename,
+                                  options);
+  {
+    DistanceFile distances(filename);
+    EXPECT_EQ(distances.size(), 11);
+    EXPECT_EQ(distances.Tile(), 4);
+    EXPECT_EQ(distances.ToMatrix(), kExpected);
+    EXPECT_EQ(distances.At(2, 6), kExpected[2][6]);
+    EXPECT_THROW(distances.At(11, 0), std::out_of_range);
+  }
+
+  options.memory_budget = 8;
+  EXPECT_THROW(ExternalShortestPaths::FromFile("test/graphs/valid_graph.txt",
+                                               filename, options),
+               std::invalid_argument);
+  options.memory_budget = ExternalPathsOptions().memory_budget;
+  EXPECT_THROW(ExternalShortestPaths::FromFile(
+                   "test/graphs/graph_with_negative_values.txt", filename,
+                   options),
+               std::out_of_range);
+  EXPECT_THROW(ExternalShortestPaths::FromFile(
+                   "test/graphs/invalid_matrix_size.txt", filename, options),
+               std::out_of_range);
+  EXPECT_NE(access(filename.c_str(), F_OK), 0);
+  EXPECT_THROW(DistanceFile("test/graphs/valid_graph.txt"), std::runtime_error);
+  EXPECT_THROW(DistanceFile("test/graphs/missing.apsp"), std::runtime_error);
+}
+
+// Сравнивает алгоритмы на графе с весами Weight с графом int из того же файла.
+template <typename Weight>
+void ExpectSameAsIntGraph(const std::string &filename) {
+  Graph expected;
+  expected.loadGraphFromFile(filename);
+  BasicGraph<Weight> typed;
+  typed.loadGraphFromFile(filename);
+  using Algorithms = BasicGraphAlgorithms<Weight>;
+  using Distance = typename Algorithms::Distance;
+  const Distance kInfinity = WeightTraits<Weight>::kInfinity;
+
+  EXPECT_EQ(typed.Properties().total_weight, expected.Properties().total_weight);
+  EXPECT_EQ(typed.Properties().max_weight, expected.Properties().max_weight);
+  EXPECT_EQ(Algorithms::DepthFirstSearch(typed, 0),
+            GraphAlgorithms::DepthFirstSearch(expected, 0));
+  EXPECT_EQ(Algorithms::BreadthFirstSearch(typed, 0),
+            GraphAlgorithms::BreadthFirstSearch(expected, 0));
+  const matrix kDistances =
+      GraphAlgorithms::GetShortestPathsBetweenAllVertices(expected);
+  const BasicMatrix<Distance> kTyped =
+      Algorithms::GetShortestPathsBetweenAllVertices(typed);
+  for (int from = 0; from < expected.size(); ++from) {
+    for (int to = 0; to < expected.size(); ++to) {
+      const int kExpected = kDistances[from][to];
+      const Distance kActual = kTyped[from][to];
+      if (kExpected == std::numeric_limits<int>::max()) {
+        ASSERT_EQ(kActual, kInfinity);
+      } else {
+        ASSERT_EQ(kActual, static_cast<Distance>(kExpected));
+      }
+      ASSERT_EQ(Algorithms::GetShortestPathBetweenVertices(typed, from + 1,
+                                                           to + 1),
+                kActual);
+    }
+  }
+  EXPECT_EQ(Algorithms::CalculateGraphWeight(
+                Algorithms::GetLeastSpanningTree(typed)),
+            static_cast<Distance>(GraphAlgorithms::CalculateGraphWeight(
+                GraphAlgorithms::GetLeastSpanningTree(expected))));
+}
+
+TEST(WeightTypes, MatchIntGraph) {
+  for (const std::string filename :
+       {"test/graphs/valid_graph.txt", "test/graphs/dwg.txt"}) {
+    ExpectSameAsIntGraph<std::uint8_t>(filename);
+    ExpectSameAsIntGraph<std::uint16_t>(filename);
+    ExpectSameAsIntGraph<std::int64_t>(filename);
+    ExpectSameAsIntGraph<float>(filename);
+  }
+}
+
+TEST(WeightTypes, SaturatesAndChecksRange) {
+  // Путь 1 -> 2 -> 3 длиннее INT_MAX.
+  const std::string filename = "test/graphs/heavy_path.txt";
+  {
+    std::ofstream file(filename);
+    file << "3\n0 2000000000 0\n0 0 2000000000\n0 0 0\n";
+  }
+  Graph heavy;
+  heavy.loadGraphFromFile(filename);
+  const int kInfinity = std::numeric_limits<int>::max();
+  EXPECT_EQ(GraphAlgorithms::GetShortestPathsBetweenAllVertices(heavy)[0][2],
+            kInfinity);
+  EXPECT_EQ(GraphAlgorithms::GetShortestPathBetweenVertices(heavy, 1, 3),
+            kInfinity);
+
+  BasicGraph<std::int64_t> wide;
+  wide.loadGraphFromFile(filename);
+  EXPECT_EQ(BasicGraphAlgorithms<std::int64_t>::GetShortestPathBetweenVertices(
+                wide, 1, 3),
+            4000000000LL);
+
+  BasicGraph<std::uint16_t> narrow;
+  EXPECT_THROW(narrow.loadGraphFromFile(filename), std::out_of_range);
+  EXPECT_EQ(narrow.size(), 0);
+  std::remove(filename.c_str());
+
+  BasicGraph<float> fractional;
+  EXPECT_THROW(fractional.loadGraphFromFile(
+                   "test/graphs/graph_with_negative_values.txt"),
+               std::out_of_range);
+}
+
+TEST(GraphView, CompressedMatchesDense) {
+  for (const SeededGraph &sample : SeededGraphs(50, 0.04, 0.2)) {
+    const Graph &dense = sample.graph;
+    CompressedGraph<int> sparse(dense);
+    ASSERT_EQ(sparse.size(), dense.size());
+    EXPECT_EQ(sparse.ArcCount(),
+              static_cast<std::size_t>(dense.Properties().edge_count) *
+                  (sample.directed ? 1 : 2));
+    const Graph kCopy = MakeDenseGraph(sparse);
+    for (int row = 0; row < dense.size(); ++row) {
+      ASSERT_EQ(kCopy[row], dense[row]);
+    }
+
+    for (int start = 0; start < dense.size(); start += 7) {
+      EXPECT_EQ(ViewAlgorithms::DepthFirstSearch(sparse, start),
+                GraphAlgorithms::DepthFirstSearch(dense, start));
+      EXPECT_EQ(ViewAlgorithms::BreadthFirstSearch(sparse, start),
+                GraphAlgorithms::BreadthFirstSearch(dense, start));
+    }
+    const matrix &kDistances = sample.distances;
+    EXPECT_EQ(ViewAlgorithms::GetShortestPathsBetweenAllVertices(sparse),
+              kDistances);
+    for (int from = 1; from <= dense.size(); ++from) {
+      for (int to = 1; to <= dense.size(); ++to) {
+        ASSERT_EQ(
+            ViewAlgorithms::GetShortestPathBetweenVertices(sparse, from, to),
+            kDistances[from - 1][to - 1]);
+      }
+    }
+    if (sample.directed) continue;
+    // Редкий граф несвязен, и остов не строится ни в одном представлении.
+    if (sample.sparse) {
+      EXPECT_THROW(GraphAlgorithms::GetLeastSpanningTree(dense),
+                   std::out_of_range);
+      EXPECT_THROW(ViewAlgorithms::GetLeastSpanningTree(sparse),
+                   std::out_of_range);
+    } else {
+      EXPECT_EQ(GraphAlgorithms::CalculateGraphWeight(
+                    ViewAlgorithms::GetLeastSpanningTree(sparse)),
+                GraphAlgorithms::CalculateGraphWeight(
+                    GraphAlgorithms::GetLeastSpanningTree(dense)));
+    }
+  }
+  EXPECT_THROW(ViewAlgorithms::DepthFirstSearch(CompressedGraph<int>(), 0),
+               std::invalid_argument);
+  EXPECT_THROW(ViewAlgorithms::BreadthFirstSearch(CompressedGraph<int>(), 0),
+               std::out_of_range);
+}
+
+TEST(GraphView, SolvesSalesmanOnAnyView) {
+  Graph dense;
+  dense.loadGraphFromFile("test/graphs/valid_graph.txt");
+  CompressedGraph<int> sparse(dense);
+  TsmOptions options;
+  options.solver = TsmSolver::kHeldKarp;
+  EXPECT_EQ(GraphAlgorithms::SolveTravelingSalesmanProblem(sparse, options)
+                .distance,
+            GraphAlgorithms::SolveTravelingSalesmanProblem(dense, options)
+                .distance);
+  EXPECT_THROW(BasicGraph<int>(matrix{{0, 1}, {1}}), std::out_of_range);
+  EXPECT_THROW(BasicGraph<int>(matrix{{0, -1}, {-1, 0}}), std::out_of_range);
+}
+
+TEST(SymmetricGraph, MatchesFullMatrix) {
+  GeneratorOptions options;
+  options.vertices = 50;
+  for (std::uint64_t seed = 1; seed <= 3; ++seed) {
+    options.seed = seed;
+    options.density = seed == 1 ? 0.04 : 0.3;
+    Graph dense = GeneratedGraph(options);
+    SymmetricGraph<int> packed(dense);
+    ASSERT_EQ(packed.Weights().Data().size(),
+              static_cast<std::size_t>(dense.size()) * (dense.size() + 1) / 2);
+    EXPECT_EQ(packed.EdgeCount(), dense.Properties().edge_count);
+    EXPECT_EQ(packed.getGraphWeight(), dense.getGraphWeight());
+    for (int from = 0; from < dense.size(); ++from) {
+      for (int to = 0; to < dense.size(); ++to) {
+        ASSERT_EQ(packed.Cell(from, to), dense[from][to]);
+      }
+    }
+    for (int start = 0; start < dense.size(); start += 7) {
+      EXPECT_EQ(ViewAlgorithms::DepthFirstSearch(packed, start),
+                GraphAlgorithms::DepthFirstSearch(dense, start));
+      EXPECT_EQ(ViewAlgorithms::BreadthFirstSearch(packed, start),
+                GraphAlgorithms::BreadthFirstSearch(dense, start));
+    }
+
+    const matrix kDistances =
+        GraphAlgorithms::GetShortestPathsBetweenAllVertices(dense);
+    const PackedSymmetricMatrix<int> kPacked =
+        ViewAlgorithms::GetShortestPathsBetweenAllVertices(packed);
+    for (int from = 0; from < dense.size(); ++from) {
+      for (int to = 0; to < dense.size(); ++to) {
+        ASSERT_EQ(kPacked(from, to), kDistances[from][to]);
+      }
+    }
+    EXPECT_EQ(ViewAlgorithms::GetShortestPathBetweenVertices(packed, 1, 50),
+              kDistances[0][49]);
+
+    if (seed == 1) {
+      EXPECT_THROW(ViewAlgorithms::GetLeastSpanningTree(packed),
+                   std::out_of_range);
+      continue;
+    }
+    const PackedSymmetricMatrix<int> kTree =
+        ViewAlgorithms::GetLeastSpanningTree(packed);
+    int tree_weight = 0;
+    for (int from = 0; from < dense.size(); ++from) {
+      for (int to = from + 1; to < dense.size(); ++to) {
+        tree_weight += kTree(from, to);
+      }
+    }
+    EXPECT_EQ(tree_weight, GraphAlgorithms::CalculateGraphWeight(
+                               GraphAlgorithms::GetLeastSpanningTree(dense)));
+  }
+  Graph directed;
+  directed.loadGraphFromFile("test/graphs/dwg.txt");
+  EXPECT_THROW(SymmetricGraph<int>{directed}, std::invalid_argument);
+}
+
+TEST(SymmetricGraph, PickedAtLoad) {
+  auto loaded = LoadGraph<int>("test/graphs/valid_graph.txt");
+  ASSERT_TRUE(std::holds_alternative<SymmetricGraph<int>>(loaded));
+  const SymmetricGraph<int> &packed = std::get<SymmetricGraph<int>>(loaded);
+  Graph dense;
+  dense.loadGraphFromFile("test/graphs/valid_graph.txt");
+  EXPECT_EQ(packed.size(), dense.size());
+  EXPECT_EQ(packed.EdgeCount(), dense.Properties().edge_count);
+  EXPECT_FALSE(packed.IsDirected());
+
+  const std::string filename = "test/symmetric.dot";
+  packed.exportGraphToDot(filename);
+  std::ifstream dot(filename);
+  std::string line;
+  int edges = 0;
+  while (std::getline(dot, line)) {
+    edges += line.find(" -- ") != std::string::npos;
+  }
+  EXPECT_EQ(edges, packed.EdgeCount());
+  std::remove(filename.c_str());
+
+  EXPECT_TRUE(std::holds_alternative<Graph>(
+      LoadGraph<int>("test/graphs/asymmetric_30.txt")));
+  SymmetricGraph<int> rejected;
+  EXPECT_THROW(rejected.loadGraphFromFile("test/graphs/dwg.txt"),
+               std::invalid_argument);
+  EXPECT_EQ(rejected.size(), 0);
+  EXPECT_THROW(rejected.loadGraphFromFile("test/graphs/invalid_matrix_size.txt"),
+               std::out_of_range);
+  EXPECT_THROW(
+      rejected.loadGraphFromFile("test/graphs/graph_with_negative_values.txt"),
+      std::out_of_range);
+  EXPECT_THROW(LoadGraph<int>("test/graphs/missing.txt"), std::runtime_error);
+}
+
+TEST(AntColony, PacksPheromoneOfUndirectedGraph) {
+  Graph undirected;
+  undirected.loadGraphFromFile("test/graphs/euclidean_40.txt");
+  AntColonyParams params;
+  params.seed = 5;
+  AntColony colony(undirected, params);
+  EXPECT_TRUE(colony.Pheromone().Symmetric());
+  EXPECT_EQ(colony.Pheromone().Cells().size(), 40u * 41 / 2);
+  TsmOptions options;
+  options.max_iterations = 3;
+  TsmResult tour = colony.SolveSalesmansProblem(options);
+  EXPECT_TRUE(IsClosedTour(undirected, tour.path));
+  EXPECT_DOUBLE_EQ(tour.distance, TourCost(undirected, tour.path));
+  EXPECT_EQ(colony.Pheromone()(3, 7), colony.Pheromone()(7, 3));
+
+  Graph directed;
+  directed.loadGraphFromFile("test/graphs/asymmetric_30.txt");
+  EXPECT_FALSE(AntColony(directed).Pheromone().Symmetric());
+  EXPECT_EQ(AntColony(directed).Pheromone().Cells().size(), 30u * 30);
+}
+
+namespace {
+
+std::vector<std::string> SortedDotLines(const Graph &graph,
+                                        const std::string &filename) {
+  graph.exportGraphToDot(filename);
+  std::ifstream dot(filename);
+  std::vector<std::string> lines;
+  for (std::string line; std::getline(dot, line);) lines.push_back(line);
+  std::remove(filename.c_str());
+  std::sort(lines.begin(), lines.end());
+  return lines;
+}
+
+}  // namespace
+
+TEST(VertexOrder, KeepsOriginalNumbers) {
+  const VertexOrder kOrders[] = {VertexOrder::kReverseCuthillMcKee,
+                                 VertexOrder::kBreadthFirst,
+                                 VertexOrder::kDegree};
+  GeneratorOptions options;
+  options.vertices = 40;
+  options.density = 0.1;
+  for (std::uint64_t seed = 1; seed <= 2; ++seed) {
+    options.seed = seed;
+    options.directed = seed == 2;
+    const Graph kGraph = GeneratedGraph(options);
+    const matrix kDistances =
+        GraphAlgorithms::GetShortestPathsBetweenAllVertices(kGraph);
+    const std::vector<std::string> kDot =
+        SortedDotLines(kGraph, "test/original.dot");
+    for (VertexOrder order : kOrders) {
+      Graph reordered = kGraph;
+      reordered.Reorder(order);
+      const VertexPermutation &kPermutation = reordered.Permutation();
+      EXPECT_NE(reordered.Version(), kGraph.Version());
+      for (int vertex = 0; vertex < kGraph.size(); ++vertex) {
+        ASSERT_EQ(kPermutation.ToOriginal(kPermutation.ToInternal(vertex)),
+                  vertex);
+      }
+      for (int from = 0; from < kGraph.size(); ++from) {
+        for (int to = 0; to < kGraph.size(); ++to) {
+          ASSERT_EQ(reordered[kPermutation.ToInternal(from)]
+                             [kPermutation.ToInternal(to)],
+                    kGraph[from][to]);
+        }
+      }
+      EXPECT_EQ(reordered.Properties().edge_count,
+                kGraph.Properties().edge_count);
+      EXPECT_EQ(reordered.getGraphWeight(), kGraph.getGraphWeight());
+      EXPECT_EQ(SortedDotLines(reordered, "test/reordered.dot"), kDot);
+
+      EXPECT_EQ(GraphAlgorithms::GetShortestPathsBetweenAllVertices(reordered),
+                kDistances);
+      for (int from = 1; from <= kGraph.size(); from += 3) {
+        for (int to = 1; to <= kGraph.size(); ++to) {
+          ASSERT_EQ(GraphAlgorithms::GetShortestPathBetweenVertices(reordered,
+                                                                    from, to),
+                    kDistances[from - 1][to - 1]);
+        }
+      }
+      // Обход идёт по другим номерам, но посещает те же вершины по слоям.
+      for (int start = 0; start < kGraph.size(); start += 13) {
+        std::vector<int> expected =
+            GraphAlgorithms::BreadthFirstSearch(kGraph, start);
+        std::vector<int> visited =
+            GraphAlgorithms::BreadthFirstSearch(reordered, start);
+        ASSERT_EQ(visited.front(), start + 1);
+        std::vector<int> hops(kGraph.size(), -1);
+        hops[start] = 0;
+        for (int vertex : expected) {
+          for (int to = 0; to < kGraph.size(); ++to) {
+            if (kGraph[vertex - 1][to] > 0 && hops[to] == -1) {
+              hops[to] = hops[vertex - 1] + 1;
+            }
+          }
+        }
+        for (std::size_t i = 1; i < visited.size(); ++i) {
+          EXPECT_LE(hops[visited[i - 1] - 1], hops[visited[i] - 1]);
+        }
+        std::vector<int> depth_first =
+            GraphAlgorithms::DepthFirstSearch(reordered, start);
+        std::sort(expected.begin(), expected.end());
+        std::sort(visited.begin(), visited.end());
+        std::sort(depth_first.begin(), depth_first.end());
+        EXPECT_EQ(visited, expected);
+        EXPECT_EQ(depth_first, expected);
+      }
+
+      reordered.SetEdge(0, 1, 77);
+      EXPECT_EQ(reordered[kPermutation.ToInternal(0)]
+                         [kPermutation.ToInternal(1)],
+                77);
+      EXPECT_EQ(reordered.getGraphWeight(),
+                kGraph.getGraphWeight() + 77 - kGraph[0][1]);
+      if (options.directed) continue;
+      const matrix kTree = GraphAlgorithms::GetLeastSpanningTree(reordered);
+      reordered.SetEdge(0, 1, kGraph[0][1]);
+      EXPECT_EQ(GraphAlgorithms::CalculateGraphWeight(
+                    GraphAlgorithms::GetLeastSpanningTree(reordered)),
+                GraphAlgorithms::CalculateGraphWeight(
+                    GraphAlgorithms::GetLeastSpanningTree(kGraph)));
+      for (int from = 0; from < kGraph.size(); ++from) {
+        for (int to = 0; to < kGraph.size(); ++to) {
+          if (kTree[from][to] == 0) continue;
+          EXPECT_EQ(kTree[from][to],
+                    (from == 0 && to == 1) || (from == 1 && to == 0)
+                        ? 77
+                        : kGraph[from][to]);
+        }
+      }
+    }
+  }
+  EXPECT_THROW(VertexPermutation({0, 0, 1}), std::invalid_argument);
+  EXPECT_THROW(Graph(matrix{{0, 1}, {1, 0}}, VertexPermutation({2, 0, 1})),
+               std::invalid_argument);
+}
+
+TEST(VertexOrder, DynamicIndexesMatchRecompute) {
+  GeneratorOptions options;
+  options.vertices = 30;
+  options.density = 0.15;
+  options.max_weight = 20;
+  options.seed = 4;
+  Graph paths_graph = GeneratedGraph(options);
+  paths_graph.Reorder(VertexOrder::kDegree);
+  ASSERT_FALSE(paths_graph.Permutation().IsIdentity());
+  Graph tree_graph = paths_graph;
+  DynamicShortestPaths paths(paths_graph);
+  DynamicSpanningTree tree(tree_graph);
+  const VertexPermutation &kOrder = tree_graph.Permutation();
+
+  // Изменения задаются в исходных номерах, как в Graph::SetEdge.
+  std::mt19937 generator(9);
+  std::uniform_int_distribution<int> vertex(0, options.vertices - 1);
+  std::uniform_int_distribution<int> weight(1, 25);
+  for (int update = 0; update < 200; ++update) {
+    const int kFrom = vertex(generator);
+    const int kTo = vertex(generator);
+    if (kFrom == kTo) continue;
+    const int kWeight = update % 4 == 0 ? 0 : weight(generator);
+    paths.SetEdge(kFrom, kTo, kWeight);
+    tree.SetEdge(kFrom, kTo, kWeight);
+    if (update % 10 != 0) continue;
+
+    ASSERT_EQ(paths.Distances(),
+              GraphAlgorithms::GetShortestPathsBetweenAllVertices(paths_graph));
+    const matrix &kTree = tree.Tree();
+    long long tree_weight = 0;
+    for (int from = 0; from < options.vertices; ++from) {
+      for (int to = from + 1; to < options.vertices; ++to) {
+        if (kTree[from][to] == 0) continue;
+        ASSERT_EQ(kTree[from][to],
+                  tree_graph[kOrder.ToInternal(from)][kOrder.ToInternal(to)]);
+        tree_weight += kTree[from][to];
+      }
+    }
+    ASSERT_EQ(tree_weight, tree.Weight());
+    ASSERT_EQ(tree.Weight(), DynamicSpanningTree(tree_graph).Weight());
+  }
+}
+
+TEST(VertexOrder, ReverseCuthillMcKeeNarrowsBand) {
+  // Путь с перемешанными номерами: соседние по пути вершины далеки друг от
+  // друга, а после перенумерации все рёбра лежат у диагонали.
+  const std::vector<int> kPath = {7, 2, 9, 0, 5, 11, 3, 8, 1, 10, 4, 6};
+  matrix weights(kPath.size(), std::vector<int>(kPath.size(), 0));
+  for (std::size_t i = 1; i < kPath.size(); ++i) {
+    weights[kPath[i - 1]][kPath[i]] = weights[kPath[i]][kPath[i - 1]] = 1;
+  }
+  const auto kBandwidth = [](const auto &graph) {
+    int bandwidth = 0;
+    for (int from = 0; from < graph.size(); ++from) {
+      graph.ForEachNeighbour(from, [&](int to, auto) {
+        bandwidth = std::max(bandwidth, std::abs(from - to));
+      });
+    }
+    return bandwidth;
+  };
+  Graph graph(weights);
+  EXPECT_GT(kBandwidth(graph), 1);
+  graph.Reorder(VertexOrder::kReverseCuthillMcKee);
+  EXPECT_EQ(kBandwidth(graph), 1);
+
+  CompressedGraph<int> sparse{Graph(weights)};
+  sparse.Reorder(VertexOrder::kReverseCuthillMcKee);
+  EXPECT_EQ(kBandwidth(sparse), 1);
+  EXPECT_EQ(
+      ViewAlgorithms::GetShortestPathBetweenVertices(sparse, kPath.front() + 1,
+                                                     kPath.back() + 1),
+      static_cast<int>(kPath.size()) - 1);
+  EXPECT_EQ(ViewAlgorithms::BreadthFirstSearch(sparse, kPath.front()),
+            ViewAlgorithms::BreadthFirstSearch(Graph(weights), kPath.front()));
+  EXPECT_EQ(ViewAlgorithms::GetShortestPathsBetweenAllVertices(sparse),
+            GraphAlgorithms::GetShortestPathsBetweenAllVertices(Graph(weights)));
+  EXPECT_EQ(CompressedGraph<int>(graph).Permutation(), graph.Permutation());
+  EXPECT_EQ(SymmetricGraph<int>(graph).Permutation(), graph.Permutation());
+}
+
+TEST(VertexOrder, ReorderedGraphAnswersInOriginalNumbers) {
+  Graph graph;
+  graph.loadGraphFromFile("test/graphs/valid_graph.txt");
+  Graph reordered = graph;
+  reordered.Reorder(VertexOrder::kReverseCuthillMcKee);
+  ASSERT_FALSE(reordered.Permutation().IsIdentity());
+  TsmOptions options;
+  options.solver = TsmSolver::kHeldKarp;
+  const TsmResult kTour =
+      GraphAlgorithms::SolveTravelingSalesmanProblem(reordered, options);
+  EXPECT_TRUE(IsClosedTour(graph, kTour.path));
+  EXPECT_DOUBLE_EQ(kTour.distance, TourCost(graph, kTour.path));
+  EXPECT_EQ(kTour.distance,
+            GraphAlgorithms::SolveTravelingSalesmanProblem(graph, options)
+                .distance);
+
+  // Промежуточные туры всех решателей тоже приходят в исходных номерах.
+  options.max_iterations = 5;
+  options.islands.count = 2;
+  for (TsmSolver solver :
+       {TsmSolver::kAntColony, TsmSolver::kHeldKarp, TsmSolver::kIslands}) {
+    options.solver = solver;
+    std::vector<TsmResult> reported;
+    options.on_progress = [&reported](const TsmProgress &progress) {
+      reported.push_back(progress.best);
+    };
+    GraphAlgorithms::SolveTravelingSalesmanProblem(reordered, options);
+    ASSERT_FALSE(reported.empty());
+    for (const TsmResult &tour : reported) {
+      EXPECT_TRUE(IsClosedTour(graph, tour.path));
+      EXPECT_DOUBLE_EQ(tour.distance, TourCost(graph, tour.path));
+    }
+  }
+
+  // Контрольная точка переносится между порядками вершин одного графа.
+  const std::string kCheckpoint = "test/reordered.ckpt";
+  AntColonyParams params;
+  params.seed = 7;
+  TsmOptions save;
+  save.max_iterations = 3;
+  save.checkpoint_path = kCheckpoint;
+  AntColony saved(reordered, params);
+  saved.SolveSalesmansProblem(save);
+  AntColony resumed(graph, params);
+  EXPECT_TRUE(resumed.LoadCheckpoint(kCheckpoint));
+  std::remove(kCheckpoint.c_str());
+  const VertexPermutation &kOrder = reordered.Permutation();
+  std::vector<int> expected_path;
+  for (int vertex : saved.Best().path)
+    expected_path.push_back(kOrder.ToOriginal(vertex));
+  EXPECT_EQ(resumed.Best().path, expected_path);
+  EXPECT_EQ(resumed.Best().distance, saved.Best().distance);
+  EXPECT_EQ(resumed.Iteration(), saved.Iteration());
+  for (int from = 0; from < graph.size(); ++from) {
+    for (int to = 0; to < graph.size(); ++to) {
+      ASSERT_EQ(resumed.Pheromone()(from, to),
+                saved.Pheromone()(kOrder.ToInternal(from),
+                                  kOrder.ToInternal(to)));
+    }
+  }
+
+  Graph controlled = graph;
+  Controller controller(&controlled);
+  const matrix kDistances =
+      GraphAlgorithms::GetShortestPathsBetweenAllVertices(graph);
+  controller.ReorderGraph(VertexOrder::kReverseCuthillMcKee);
+  EXPECT_FALSE(controlled.Permutation().IsIdentity());
+  // Пути спрашиваются до матрицы всех путей, иначе ответ берётся из неё.
+  for (PathSearch search :
+       {PathSearch::kBidirectional, PathSearch::kAlt,
+        PathSearch::kContractionHierarchy}) {
+    for (std::size_t to = 1; to <= kDistances.size(); ++to) {
+      EXPECT_EQ(controller.GetShortestPathBetweenVertices(2, to, search),
+                kDistances[1][to - 1]);
+    }
+  }
+  EXPECT_EQ(controller.GetShortestPathsBetweenAllVertices(), kDistances);
+  EXPECT_GE(controller.EstimateDistance(1, 5), kDistances[0][4]);
+  // Один уровень оракула - точная таблица и в другой нумерации.
+  EXPECT_EQ(DistanceOracle(reordered, 1).Compare(kDistances).exact, 1);
+  EXPECT_THROW(controller.GetShortestPathBetweenVertices(0, 1),
+               std::runtime_error);
+}
+
 } // namespace s21
 
 int main(int argc, char **argv) {
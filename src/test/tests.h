@@ -2,10 +2,27 @@
 #define TESTS_H
 
 #include <gtest/gtest.h>
+#include <atomic>
+#include <cstring>
+#include <future>
+#include <set>
+#include <sstream>
+#include <thread>
 #include <vector>
 
 #include "../model/s21_graph.h"
+#include "../controller/controller.h"
+#include "../model/s21_compressed_graph.h"
+#include "../model/s21_contraction_hierarchy.h"
+#include "../model/s21_distance_oracle.h"
+#include "../model/s21_external_shortest_paths.h"
+#include "../model/s21_dynamic_shortest_paths.h"
+#include "../model/s21_dynamic_spanning_tree.h"
 #include "../model/s21_graph_algorithms.h"
+#include "../model/s21_graph_generator.h"
+#include "../model/s21_symmetric_graph.h"
+#include "../view/batch_view.h"
+#include "../view/server_view.h"
 
 using std::vector;
 
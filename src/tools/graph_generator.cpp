@@ -0,0 +1,89 @@
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include "../model/s21_graph_generator.h"
+
+namespace {
+
+void PrintUsage() {
+  std::cout
+      << "Usage: GraphGenerator --model er|grid|powerlaw|euclidean "
+         "--vertices N [options]\n"
+         "  --output FILE      output file, \"-\" for stdout (default)\n"
+         "  --density P        edge probability (er) or diagonal share "
+         "(grid)\n"
+         "  --degree D         average degree (powerlaw)\n"
+         "  --exponent G       degree distribution exponent (powerlaw)\n"
+         "  --min-weight W     smallest edge weight\n"
+         "  --max-weight W     largest edge weight\n"
+         "  --directed         generate both directions independently\n"
+         "  --seed S           random seed\n"
+         "  --threads T        worker threads, 0 - all cores\n";
+}
+
+s21::GeneratorModel ParseModel(const std::string &name) {
+  if (name == "er") return s21::GeneratorModel::kErdosRenyi;
+  if (name == "grid") return s21::GeneratorModel::kGrid;
+  if (name == "powerlaw") return s21::GeneratorModel::kPowerLaw;
+  if (name == "euclidean") return s21::GeneratorModel::kEuclidean;
+  throw std::invalid_argument("[ [Wrong argument] ] :: Unknown model\n");
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  s21::GeneratorOptions options;
+  std::string output = "-";
+  try {
+    for (int i = 1; i < argc; ++i) {
+      std::string flag = argv[i];
+      if (flag == "--directed") {
+        options.directed = true;
+        continue;
+      }
+      if (flag == "--help") {
+        PrintUsage();
+        return 0;
+      }
+      if (i + 1 >= argc) throw std::invalid_argument("Missing value");
+      std::string value = argv[++i];
+      if (flag == "--model") {
+        options.model = ParseModel(value);
+      } else if (flag == "--vertices") {
+        options.vertices = std::stoi(value);
+      } else if (flag == "--density") {
+        options.density = std::stod(value);
+      } else if (flag == "--degree") {
+        options.average_degree = std::stod(value);
+      } else if (flag == "--exponent") {
+        options.exponent = std::stod(value);
+      } else if (flag == "--min-weight") {
+        options.min_weight = std::stoi(value);
+      } else if (flag == "--max-weight") {
+        options.max_weight = std::stoi(value);
+      } else if (flag == "--seed") {
+        options.seed = std::stoull(value);
+      } else if (flag == "--threads") {
+        options.threads = std::stoul(value);
+      } else if (flag == "--output") {
+        output = value;
+      } else {
+        throw std::invalid_argument("Unknown option " + flag);
+      }
+    }
+
+    s21::GraphGenerator generator(options);
+    if (output == "-") {
+      std::ios::sync_with_stdio(false);
+      generator.WriteAdjacencyMatrix(std::cout);
+    } else {
+      generator.WriteAdjacencyMatrix(output);
+    }
+  } catch (const std::exception &error) {
+    std::cerr << error.what() << std::endl;
+    PrintUsage();
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,240 @@
+#ifndef S21_BATCH_VIEW_H_
+#define S21_BATCH_VIEW_H_
+
+#include <chrono>
+#include <fstream>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../controller/controller.h"
+#include "query_runner.h"
+
+namespace s21 {
+
+enum class BatchFormat { kCsv, kJson };
+
+/**
+ * Runs queries from a file without the menu. Every line holds one command:
+ * `load <file>` loads a graph for the following queries, other commands are
+ * the queries of QueryRunner.
+ *
+ * Empty lines and lines starting with # are skipped. Queries between two
+ * loads are independent and run in parallel on the thread pool of the
+ * controller; each of them sees the graph of the last load before it. If
+ * that load failed, the queries up to the next load fail too instead of
+ * running on the previous graph. The results are written in the order of the
+ * file with the time of every query.
+ */
+class BatchView {
+ public:
+  explicit BatchView(Controller *controller)
+      : controller_(controller), queries_(controller) {}
+
+  /**
+   * Runs the queries and writes the results.
+   *
+   * @param queries the query file
+   * @param output the stream for the results
+   * @param format CSV or JSON
+   *
+   * @return the number of failed commands
+   */
+  int Run(std::istream &queries, std::ostream &output,
+          BatchFormat format = BatchFormat::kCsv) {
+    std::vector<std::future<Record>> records;
+    // Строка неудачной загрузки, 0 если последняя загрузка прошла.
+    int failed_load = 0;
+    std::string line;
+    for (int number = 1; std::getline(queries, line); ++number) {
+      std::istringstream words(line);
+      std::string command;
+      if (!(words >> command) || command[0] == '#') continue;
+      std::string arguments;
+      std::getline(words >> std::ws, arguments);
+      if (command == "load") {
+        // Загрузка подменяет снимок графа, уже отправленные запросы
+        // досчитываются на прежнем.
+        Record loaded = Execute(number, command, arguments, [&] {
+          controller_->LoadGraphFromFile(arguments);
+          return std::string("{\"vertices\":") +
+                 std::to_string(controller_->GetSnapshot()->size()) + "}";
+        });
+        failed_load = loaded.ok ? 0 : number;
+        records.push_back(Ready(std::move(loaded)));
+      } else if (failed_load != 0) {
+        records.push_back(Ready(Execute(
+            number, command, arguments, [failed_load]() -> std::string {
+              throw std::runtime_error("Graph of line " +
+                                       std::to_string(failed_load) +
+                                       " was not loaded");
+            })));
+      } else {
+        records.push_back(Submit(number, command, arguments));
+      }
+    }
+
+    int failed = 0;
+    if (format == BatchFormat::kJson) {
+      output << "[";
+    } else {
+      output << "line,command,arguments,status,time_ms,result\n";
+    }
+    for (std::size_t i = 0; i != records.size(); ++i) {
+      Record record = records[i].get();
+      failed += record.ok ? 0 : 1;
+      if (format == BatchFormat::kJson) {
+        WriteJson(output, record, i == 0);
+      } else {
+        WriteCsv(output, record);
+      }
+    }
+    if (format == BatchFormat::kJson) output << "]\n";
+    return failed;
+  }
+
+  /**
+   * Runs the queries from one file and writes the results to another. The
+   * format is JSON if the output name ends with .json, CSV otherwise.
+   *
+   * @throws std::runtime_error if a file cannot be opened
+   */
+  int Run(const std::string &queries_path, const std::string &output_path) {
+    std::ifstream queries(queries_path);
+    if (!queries) {
+      throw std::runtime_error("Can't open query file " + queries_path);
+    }
+    std::ofstream output(output_path);
+    if (!output) {
+      throw std::runtime_error("Can't create result file " + output_path);
+    }
+    const bool kJson = output_path.size() >= 5 &&
+                       output_path.compare(output_path.size() - 5, 5,
+                                           ".json") == 0;
+    return Run(queries, output, kJson ? BatchFormat::kJson : BatchFormat::kCsv);
+  }
+
+ private:
+  /**
+   * The outcome of one command. The result is a JSON value: a number, an
+   * array or an object; for a failed command it is the error message.
+   */
+  struct Record {
+    int line = 0;
+    std::string command;
+    std::string arguments;
+    bool ok = true;
+    double time_ms = 0;
+    std::string result;
+  };
+
+  std::future<Record> Submit(int line, const std::string &command,
+                             const std::string &arguments) {
+    return controller_->Pool().Submit(
+        [this, line, command, arguments, graph = controller_->GetSnapshot()] {
+          return Execute(line, command, arguments,
+                         [&] { return queries_.Run(*graph, command, arguments); });
+        });
+  }
+
+  template <typename Compute>
+  static Record Execute(int line, const std::string &command,
+                        const std::string &arguments, Compute compute) {
+    Record record;
+    record.line = line;
+    record.command = command;
+    record.arguments = arguments;
+    const auto kStart = std::chrono::steady_clock::now();
+    try {
+      record.result = compute();
+    } catch (const std::exception &error) {
+      record.ok = false;
+      record.result = error.what();
+    }
+    record.time_ms = std::chrono::duration<double, std::milli>(
+                         std::chrono::steady_clock::now() - kStart)
+                         .count();
+    return record;
+  }
+
+  static std::future<Record> Ready(Record record) {
+    std::promise<Record> promise;
+    promise.set_value(std::move(record));
+    return promise.get_future();
+  }
+
+  static std::string CsvField(const std::string &text) {
+    std::string field = "\"";
+    for (char symbol : text) {
+      field += symbol == '"' ? std::string("\"\"") : std::string(1, symbol);
+    }
+    return field + "\"";
+  }
+
+  static std::string JsonString(const std::string &text) {
+    std::string json = "\"";
+    for (char symbol : text) {
+      switch (symbol) {
+        case '"':
+          json += "\\\"";
+          break;
+        case '\\':
+          json += "\\\\";
+          break;
+        case '\n':
+          json += "\\n";
+          break;
+        case '\r':
+          json += "\\r";
+          break;
+        case '\t':
+          json += "\\t";
+          break;
+        default:
+          // Остальные управляющие символы JSON допускает только как \u00XX.
+          if (static_cast<unsigned char>(symbol) < 0x20) {
+            const char kHex[] = "0123456789abcdef";
+            json += "\\u00";
+            json += kHex[symbol >> 4];
+            json += kHex[symbol & 0xF];
+          } else {
+            json += symbol;
+          }
+      }
+    }
+    return json + "\"";
+  }
+
+  static void WriteCsv(std::ostream &output, const Record &record) {
+    output << record.line << ',' << record.command << ','
+           << CsvField(record.arguments) << ','
+           << (record.ok ? "ok" : "error") << ',' << std::fixed
+           << std::setprecision(3) << record.time_ms << ','
+           << CsvField(record.result) << '\n';
+  }
+
+  static void WriteJson(std::ostream &output, const Record &record,
+                        bool first) {
+    output << (first ? "\n" : ",\n") << "{\"line\":" << record.line
+           << ",\"command\":" << JsonString(record.command)
+           << ",\"arguments\":" << JsonString(record.arguments)
+           << ",\"status\":\"" << (record.ok ? "ok" : "error")
+           << "\",\"time_ms\":" << std::fixed << std::setprecision(3)
+           << record.time_ms << ",";
+    if (record.ok) {
+      output << "\"result\":" << record.result << "}";
+    } else {
+      output << "\"error\":" << JsonString(record.result) << "}";
+    }
+  }
+
+  Controller *controller_;
+  QueryRunner queries_;
+};
+
+}  // namespace s21
+
+#endif  // S21_BATCH_VIEW_H_
@@ -1,7 +1,12 @@
 #ifndef S21_CONSOLE_VIEW_H_
 #define S21_CONSOLE_VIEW_H_
 
+#include <poll.h>
+#include <unistd.h>
+
 #include <cstdio>
+#include <future>
+#include <mutex>
 
 #include "../controller/controller.h"
 
@@ -9,8 +14,14 @@ namespace s21 {
 
 class ConsoleView {
  public:
-  explicit ConsoleView(Controller *controller) : controller_(controller) {}
-  ~ConsoleView() {}
+  explicit ConsoleView(Controller *controller) : controller_(controller) {
+    // Статистика приходит из того потока, где работал алгоритм.
+    Statistics::SetSink([this](const AlgorithmStats &stats) {
+      std::lock_guard<std::mutex> lock(stats_mutex_);
+      last_stats_ = stats;
+    });
+  }
+  ~ConsoleView() { Statistics::SetSink(nullptr); }
 
   void show() {
     while (run) {
@@ -120,13 +131,16 @@ class ConsoleView {
           break;
         case '7':
           try {
-            result_tsm_ = controller_->SolveTravelingSalesmanProblem();
+            result_tsm_ = SolveSalesmanProblem();
           } catch (...) {
             ErrorHandler();
             break;
           }
           DisplayResultSalesmanProblem(result_tsm_);
           break;
+        case '8':
+          ToggleTrace();
+          break;
         case '0':
           run = false;
           break;
@@ -163,6 +177,59 @@ class ConsoleView {
   }
 
  private:
+  /**
+   * Runs the salesman solver in the background, prints every improvement of
+   * the tour and stops the solver when the user presses Enter.
+   *
+   * @return the best tour found before the solver finished or was stopped
+   */
+  TsmResult SolveSalesmanProblem() {
+    TsmOptions options;
+    options.on_progress = [](const TsmProgress &progress) {
+      std::cout << "Iteration " << progress.iteration << " ("
+                << progress.elapsed.count()
+                << " ms): best distance = " << progress.best.distance
+                << std::endl;
+    };
+    std::cout << "Solving... Press Enter to stop with the current best tour"
+              << std::endl;
+
+    auto solving = controller_->SolveTravelingSalesmanProblemAsync(options);
+    while (solving.wait_for(std::chrono::milliseconds(100)) !=
+           std::future_status::ready) {
+      pollfd input = {STDIN_FILENO, POLLIN, 0};
+      if (poll(&input, 1, 0) > 0) {
+        options.cancellation.Cancel();
+        std::cin.ignore();
+        break;
+      }
+    }
+    return solving.get();
+  }
+
+  /**
+   * Starts recording the timeline of the algorithms, or stops it and writes
+   * the recorded events to trace.json for chrome://tracing or Perfetto.
+   */
+  void ToggleTrace() const {
+    if (!Trace::IsEnabled()) {
+      Trace::Start();
+      std::cout << "Tracing started" << std::endl;
+    } else {
+      Trace::Stop();
+      try {
+        Trace::WriteChromeTrace("trace.json");
+      } catch (...) {
+        ErrorHandler();
+        return;
+      }
+      std::cout << "Trace written to trace.json" << std::endl;
+    }
+    std::cout << "Press any key to continue...";
+    std::cin.ignore();
+    std::getchar();
+  }
+
   void DisplayMenu() const {
     std::system("clear");
     std::cout << "\\=========================================================================/" << std::endl;
@@ -175,6 +242,9 @@ class ConsoleView {
     std::cout << "|         5. Search for the shortest paths between all pairs of vertices  |" << std::endl;
     std::cout << "|         6. Search for the minimal spanning tree in the graph            |" << std::endl;
     std::cout << "|         7. Solve the salesman problem                                   |" << std::endl;
+    std::cout << (Trace::IsEnabled()
+                  ? "|         8. Stop tracing and write trace.json                            |"
+                  : "|         8. Start tracing the algorithms                                 |") << std::endl;
     std::cout << "|         0. Quit                                                         |" << std::endl;
     std::cout << "/=========================================================================\\" << std::endl;
     std::cout << "Enter your choice: ";
@@ -190,6 +260,7 @@ class ConsoleView {
     str += "]";
     std::cout << str << std::endl;
 
+    DisplayStatistics();
     std::cout << "Press any key to continue...";
     std::cin.ignore();
     std::getchar();
@@ -205,6 +276,7 @@ class ConsoleView {
     str += "]";
     std::cout << str << std::endl;
 
+    DisplayStatistics();
     std::cout << "Press any key to continue...";
     std::cin.ignore();
     std::getchar();
@@ -213,6 +285,7 @@ class ConsoleView {
   void DisplayResultShortestPath(int result) const {
     std::cout << "Shortest path result: " << result << std::endl;
 
+    DisplayStatistics();
     std::cout << "Press any key to continue...";
     std::cin.ignore();
     std::getchar();
@@ -234,6 +307,7 @@ class ConsoleView {
     str.resize(str.size() - 1);
     std::cout << str << std::endl;
 
+    DisplayStatistics();
     std::cout << "Press any key to continue...";
     std::cin.ignore();
     std::getchar();
@@ -255,6 +329,7 @@ class ConsoleView {
     str.resize(str.size() - 1);
     std::cout << str << std::endl;
 
+    DisplayStatistics();
     std::cout << "Press any key to continue...";
     std::cin.ignore();
     std::getchar();
@@ -262,6 +337,14 @@ class ConsoleView {
 
   void DisplayResultSalesmanProblem(TsmResult result) const {
     std::cout << "Salesman problem result: " << std::endl;
+    if (result.path.empty()) {
+      std::cout << "The tour was not found" << std::endl;
+      DisplayStatistics();
+      std::cout << "Press any key to continue...";
+      std::cin.ignore();
+      std::getchar();
+      return;
+    }
     std::cout << "Distance: " << result.distance << std::endl;
     std::cout << "Path: [";
     std::string str;
@@ -272,11 +355,22 @@ class ConsoleView {
     str += "]";
     std::cout << str << std::endl;
 
+    DisplayStatistics();
     std::cout << "Press any key to continue...";
     std::cin.ignore();
     std::getchar();
   }
 
+  /**
+   * Prints the counters of the last algorithm when the program is built with
+   * S21_GRAPH_STATS.
+   */
+  void DisplayStatistics() const {
+    if (!Statistics::kEnabled) return;
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    std::cout << last_stats_;
+  }
+
   Controller *controller_;
 
   bool run = true;
@@ -284,6 +378,8 @@ class ConsoleView {
   std::vector<vector<int>> result_matrix_;
   int result_int_;
   TsmResult result_tsm_;
+  mutable std::mutex stats_mutex_;
+  AlgorithmStats last_stats_;
 };
 
 }  // namespace s21
@@ -0,0 +1,142 @@
+#ifndef S21_QUERY_RUNNER_H_
+#define S21_QUERY_RUNNER_H_
+
+#include <chrono>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../controller/controller.h"
+
+namespace s21 {
+
+/**
+ * Answers the text queries of the batch mode and the server:
+ *
+ *   bfs <vertex>, dfs <vertex>     traversal from the vertex
+ *   sp <vertex1> <vertex2> [dijkstra|bidirectional|alt|ch]
+ *                                  shortest path between two vertices
+ *   approx <vertex1> <vertex2>     distance estimate of an undirected graph
+ *   apsp                           shortest paths between all vertices
+ *   mst                            least spanning tree
+ *   tsp [auto|ants|exact|islands] [time_ms]
+ *
+ * Vertices are counted from 1, the results are JSON values.
+ */
+class QueryRunner {
+ public:
+  explicit QueryRunner(Controller *controller) : controller_(controller) {}
+
+  /**
+   * Runs a query on the snapshot of the graph.
+   *
+   * @param graph the snapshot of the controller
+   * @param command the name of the query
+   * @param arguments the rest of the query line
+   *
+   * @return the result as a JSON value
+   *
+   * @throws std::invalid_argument if the query is malformed
+   * @throws std::runtime_error if the algorithm fails
+   */
+  std::string Run(const Graph &graph, const std::string &command,
+                  const std::string &arguments) {
+    std::istringstream words(arguments);
+    if (command == "bfs" || command == "dfs") {
+      std::size_t vertex = ReadVertex(words);
+      // Пользователь задаёт вершины с 1, обходы считают их с 0.
+      return ToJson(command == "bfs"
+                        ? controller_->BreadthFirstSearch(graph, vertex - 1)
+                        : controller_->DepthFirstSearch(graph, vertex - 1));
+    }
+    if (command == "sp") {
+      std::size_t from = ReadVertex(words);
+      std::size_t to = ReadVertex(words);
+      PathSearch search = PathSearch::kBidirectional;
+      std::string name;
+      if (words >> name) search = ParseSearch(name);
+      return std::to_string(
+          controller_->GetShortestPathBetweenVertices(graph, from, to, search));
+    }
+    if (command == "approx") {
+      std::size_t from = ReadVertex(words);
+      std::size_t to = ReadVertex(words);
+      return std::to_string(controller_->EstimateDistance(graph, from, to));
+    }
+    if (command == "apsp") {
+      return ToJson(controller_->GetShortestPathsBetweenAllVertices(graph));
+    }
+    if (command == "mst") {
+      return ToJson(controller_->GetLeastSpanningTree(graph));
+    }
+    if (command == "tsp") {
+      TsmOptions options;
+      std::string solver;
+      if (words >> solver) options.solver = ParseSolver(solver);
+      long long budget = 0;
+      if (words >> budget) options.time_budget = std::chrono::milliseconds(budget);
+      TsmResult result =
+          controller_->SolveTravelingSalesmanProblem(graph, options);
+      std::ostringstream json;
+      // Точность по умолчанию превратила бы длинный тур в 1.23457e+06.
+      json << "{\"distance\":"
+           << std::setprecision(std::numeric_limits<double>::max_digits10)
+           << result.distance
+           << ",\"path\":" << ToJson(result.path) << "}";
+      return json.str();
+    }
+    throw std::invalid_argument("Unknown command " + command);
+  }
+
+  static std::string ToJson(const std::vector<int> &values) {
+    std::string json = "[";
+    for (std::size_t i = 0; i != values.size(); ++i) {
+      if (i) json += ',';
+      json += std::to_string(values[i]);
+    }
+    return json + "]";
+  }
+
+  static std::string ToJson(const matrix &rows) {
+    std::string json = "[";
+    for (std::size_t i = 0; i != rows.size(); ++i) {
+      if (i) json += ',';
+      json += ToJson(rows[i]);
+    }
+    return json + "]";
+  }
+
+ private:
+  static std::size_t ReadVertex(std::istream &words) {
+    long long vertex = 0;
+    if (!(words >> vertex) || vertex < 1) {
+      throw std::invalid_argument("Vertex is missing or invalid");
+    }
+    return static_cast<std::size_t>(vertex);
+  }
+
+  static PathSearch ParseSearch(const std::string &name) {
+    if (name == "dijkstra") return PathSearch::kDijkstra;
+    if (name == "bidirectional") return PathSearch::kBidirectional;
+    if (name == "alt") return PathSearch::kAlt;
+    if (name == "ch") return PathSearch::kContractionHierarchy;
+    throw std::invalid_argument("Unknown search " + name);
+  }
+
+  static TsmSolver ParseSolver(const std::string &name) {
+    if (name == "auto") return TsmSolver::kAuto;
+    if (name == "ants") return TsmSolver::kAntColony;
+    if (name == "exact") return TsmSolver::kHeldKarp;
+    if (name == "islands") return TsmSolver::kIslands;
+    throw std::invalid_argument("Unknown solver " + name);
+  }
+
+  Controller *controller_;
+};
+
+}  // namespace s21
+
+#endif  // S21_QUERY_RUNNER_H_
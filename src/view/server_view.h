@@ -0,0 +1,365 @@
+#ifndef S21_SERVER_VIEW_H_
+#define S21_SERVER_VIEW_H_
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cerrno>
+#include <cstring>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+
+#include "../controller/controller.h"
+#include "query_runner.h"
+
+namespace s21 {
+
+/**
+ * Keeps graphs in memory and answers queries over a UNIX domain socket. The
+ * protocol is line based: every request is one line, every reply is one line
+ * "ok <json>" or "error <message>". Besides the queries of QueryRunner a
+ * connection may send
+ *
+ *   load <file>     loads the file into the current graph of the connection
+ *   use <name>      makes another resident graph current, "default" at start
+ *   graphs          lists the resident graphs and their sizes
+ *   quit            closes the connection
+ *
+ * One thread multiplexes the connections with epoll, the requests run on a
+ * thread pool. Requests of one connection are answered in order, different
+ * connections are served in parallel.
+ */
+class ServerView {
+ public:
+  static constexpr std::size_t kMaxLine = 1 << 20;
+
+  /**
+   * @param threads the number of workers, zero means all cores
+   */
+  explicit ServerView(unsigned threads = 0)
+      : wake_(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)), pool_(threads) {}
+  ServerView(const ServerView &other) = delete;
+  ServerView &operator=(const ServerView &other) = delete;
+  ~ServerView() = default;
+
+  /**
+   * Serves the socket until Stop() is called. An existing file with the
+   * name of the socket is replaced.
+   *
+   * @param socket_path the file name of the socket
+   *
+   * @throws std::runtime_error if the socket cannot be created
+   */
+  void Run(const std::string &socket_path) {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (socket_path.empty() || socket_path.size() >= sizeof(address.sun_path)) {
+      throw std::runtime_error("Invalid socket path " + socket_path);
+    }
+    std::strcpy(address.sun_path, socket_path.c_str());
+
+    epoll_ = epoll_create1(EPOLL_CLOEXEC);
+    listen_ = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    unlink(socket_path.c_str());
+    if (epoll_ < 0 || wake_.fd < 0 || listen_ < 0 ||
+        bind(listen_, reinterpret_cast<sockaddr *>(&address),
+             sizeof(address)) != 0 ||
+        listen(listen_, SOMAXCONN) != 0) {
+      const std::string kError = std::strerror(errno);
+      CloseAll(socket_path);
+      throw std::runtime_error("Can't listen on " + socket_path + ": " +
+                               kError);
+    }
+    Watch(listen_, EPOLLIN, EPOLL_CTL_ADD);
+    Watch(wake_.fd, EPOLLIN, EPOLL_CTL_ADD);
+
+    epoll_event events[64];
+    while (!stop_) {
+      int count = epoll_wait(epoll_, events, 64, -1);
+      if (count < 0 && errno != EINTR) break;
+      for (int i = 0; i < count; ++i) {
+        const int kFd = events[i].data.fd;
+        if (kFd == listen_) {
+          Accept();
+        } else if (kFd == wake_.fd) {
+          // Какой-то запрос досчитан: ответы проверяются у всех соединений.
+          std::uint64_t counter = 0;
+          while (read(wake_.fd, &counter, sizeof(counter)) > 0) {
+          }
+          for (auto it = connections_.begin(); it != connections_.end();) {
+            int fd = (it++)->first;
+            if (connections_[fd].reply.valid()) Advance(fd);
+          }
+        } else if (connections_.count(kFd)) {
+          if (connections_[kFd].eof) {
+            if (events[i].events & (EPOLLHUP | EPOLLERR)) {
+              Close(kFd);
+              continue;
+            }
+          } else if (events[i].events &
+                     (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) {
+            Receive(kFd);
+          }
+          if (connections_.count(kFd)) Advance(kFd);
+        }
+      }
+    }
+    CloseAll(socket_path);
+  }
+
+  /**
+   * Makes Run() return. May be called from any thread and from a signal
+   * handler.
+   */
+  void Stop() {
+    stop_ = true;
+    Wake();
+  }
+
+ private:
+  // Дескриптор закрывается в деструкторе: будильник нужен задачам пула до
+  // их завершения.
+  struct Descriptor {
+    explicit Descriptor(int descriptor) : fd(descriptor) {}
+    ~Descriptor() {
+      if (fd >= 0) close(fd);
+    }
+    int fd;
+  };
+
+  struct Resident {
+    Graph graph;
+    // Запросы выполняются в пуле сервера, собственный пул контроллера
+    // не используется.
+    Controller controller{&graph, ResultCache::kDefaultBudget, 1};
+  };
+
+  struct Connection {
+    std::string input;
+    std::string output;
+    std::string graph = "default";
+    std::future<std::string> reply;
+    // Клиент закончил передачу, но ещё ждёт ответы.
+    bool eof = false;
+    bool closing = false;
+  };
+
+  void Watch(int fd, std::uint32_t events, int operation) {
+    epoll_event event{};
+    event.events = events;
+    event.data.fd = fd;
+    if (epoll_ctl(epoll_, operation, fd, &event) != 0 && errno == ENOENT) {
+      epoll_ctl(epoll_, EPOLL_CTL_ADD, fd, &event);
+    }
+  }
+
+  void Wake() {
+    std::uint64_t one = 1;
+    if (write(wake_.fd, &one, sizeof(one)) < 0) {
+      // Счётчик eventfd уже ненулевой, цикл всё равно проснётся.
+    }
+  }
+
+  void Accept() {
+    while (true) {
+      int fd = accept4(listen_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+      if (fd < 0) return;
+      connections_[fd];
+      Watch(fd, EPOLLIN | EPOLLRDHUP, EPOLL_CTL_ADD);
+    }
+  }
+
+  void Receive(int fd) {
+    Connection &connection = connections_[fd];
+    char buffer[4096];
+    while (true) {
+      ssize_t size = read(fd, buffer, sizeof(buffer));
+      if (size > 0) {
+        connection.input.append(buffer, static_cast<std::size_t>(size));
+      } else if (size < 0 && errno == EINTR) {
+        continue;
+      } else if (size == 0) {
+        // Соединение остаётся открытым, пока не отправлены все ответы.
+        connection.eof = true;
+        epoll_ctl(epoll_, EPOLL_CTL_DEL, fd, nullptr);
+        return;
+      } else {
+        if (errno != EAGAIN && errno != EWOULDBLOCK) Close(fd);
+        return;
+      }
+    }
+  }
+
+  /**
+   * Collects the finished reply, starts the next request and sends what is
+   * ready. Only one request of a connection runs at a time, so a query after
+   * "load" sees the loaded graph.
+   */
+  void Advance(int fd) {
+    Connection &connection = connections_[fd];
+    if (connection.reply.valid() &&
+        connection.reply.wait_for(std::chrono::seconds(0)) ==
+            std::future_status::ready) {
+      connection.output += connection.reply.get();
+    }
+    while (!connection.reply.valid() && !connection.closing) {
+      std::size_t end = connection.input.find('\n');
+      if (end == std::string::npos && connection.eof) {
+        // Последняя строка может быть без перевода строки.
+        if (connection.input.empty()) {
+          connection.closing = true;
+          break;
+        }
+        end = connection.input.size();
+      } else if (end == std::string::npos) {
+        if (connection.input.size() > kMaxLine) {
+          connection.output += "error Request is too long\n";
+          connection.closing = true;
+        }
+        break;
+      }
+      std::string line = connection.input.substr(0, end);
+      connection.input.erase(0, std::min(end + 1, connection.input.size()));
+      if (!line.empty() && line.back() == '\r') line.pop_back();
+      Dispatch(connection, line);
+    }
+    Send(fd);
+  }
+
+  void Dispatch(Connection &connection, const std::string &line) {
+    std::istringstream words(line);
+    std::string command;
+    if (!(words >> command)) return;
+    std::string arguments;
+    std::getline(words >> std::ws, arguments);
+
+    if (command == "quit") {
+      connection.closing = true;
+    } else if (command == "use") {
+      connection.graph = arguments.empty() ? "default" : arguments;
+      connection.output += "ok\n";
+    } else if (command == "graphs") {
+      std::lock_guard<std::mutex> lock(residents_mutex_);
+      std::string json = "{";
+      for (const auto &[name, resident] : residents_) {
+        if (json.size() > 1) json += ',';
+        json += "\"" + name + "\":" +
+                std::to_string(resident->controller.GetSnapshot()->size());
+      }
+      connection.output += "ok " + json + "}\n";
+    } else {
+      auto reply = std::make_shared<std::promise<std::string>>();
+      connection.reply = reply->get_future();
+      // Будильник срабатывает после set_value, иначе цикл может проверить
+      // ответ раньше, чем он будет готов.
+      pool_.Submit([this, reply, command, arguments, graph = connection.graph] {
+        reply->set_value(Answer(graph, command, arguments));
+        Wake();
+      });
+    }
+  }
+
+  std::string Answer(const std::string &name, const std::string &command,
+                     const std::string &arguments) {
+    try {
+      if (command == "load") {
+        std::shared_ptr<Resident> resident = Find(name, true);
+        resident->controller.LoadGraphFromFile(arguments);
+        return "ok {\"vertices\":" +
+               std::to_string(resident->controller.GetSnapshot()->size()) +
+               "}\n";
+      }
+      std::shared_ptr<Resident> resident = Find(name, false);
+      if (!resident) {
+        throw std::runtime_error("Graph " + name + " is not loaded");
+      }
+      QueryRunner queries(&resident->controller);
+      return "ok " +
+             queries.Run(*resident->controller.GetSnapshot(), command,
+                         arguments) +
+             "\n";
+    } catch (const std::exception &error) {
+      std::string message = error.what();
+      for (char &symbol : message) {
+        if (symbol == '\n') symbol = ' ';
+      }
+      return "error " + message + "\n";
+    }
+  }
+
+  std::shared_ptr<Resident> Find(const std::string &name, bool create) {
+    std::lock_guard<std::mutex> lock(residents_mutex_);
+    auto found = residents_.find(name);
+    if (found != residents_.end()) return found->second;
+    if (!create) return nullptr;
+    return residents_[name] = std::make_shared<Resident>();
+  }
+
+  void Send(int fd) {
+    Connection &connection = connections_[fd];
+    while (!connection.output.empty()) {
+      ssize_t size = send(fd, connection.output.data(),
+                          connection.output.size(), MSG_NOSIGNAL);
+      if (size > 0) {
+        connection.output.erase(0, static_cast<std::size_t>(size));
+      } else if (size < 0 && errno == EINTR) {
+        continue;
+      } else if (size < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+        Watch(fd, connection.eof ? EPOLLOUT : EPOLLIN | EPOLLOUT | EPOLLRDHUP,
+              EPOLL_CTL_MOD);
+        return;
+      } else {
+        Close(fd);
+        return;
+      }
+    }
+    if (connection.closing) {
+      Close(fd);
+    } else if (connection.eof) {
+      epoll_ctl(epoll_, EPOLL_CTL_DEL, fd, nullptr);
+    } else {
+      Watch(fd, EPOLLIN | EPOLLRDHUP, EPOLL_CTL_MOD);
+    }
+  }
+
+  void Close(int fd) {
+    epoll_ctl(epoll_, EPOLL_CTL_DEL, fd, nullptr);
+    close(fd);
+    // Незавершённый запрос досчитается в пуле, его ответ будет отброшен.
+    connections_.erase(fd);
+  }
+
+  void CloseAll(const std::string &socket_path) {
+    while (!connections_.empty()) Close(connections_.begin()->first);
+    for (int *fd : {&listen_, &epoll_}) {
+      if (*fd >= 0) close(*fd);
+      *fd = -1;
+    }
+    unlink(socket_path.c_str());
+  }
+
+  std::unordered_map<int, Connection> connections_;
+  std::map<std::string, std::shared_ptr<Resident>> residents_;
+  std::mutex residents_mutex_;
+  std::atomic<bool> stop_{false};
+  int epoll_ = -1;
+  int listen_ = -1;
+  Descriptor wake_;
+  // Объявлен последним: задачи пула обращаются к остальным полям сервера.
+  ThreadPool pool_;
+};
+
+}  // namespace s21
+
+#endif  // S21_SERVER_VIEW_H_